@@ -0,0 +1,152 @@
+/* ======================================================================== /
+/!
+\file AudioBackend.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioBackend interface.
+This file contains the declaration of AudioBackend, the set of FMOD calls
+the audio system makes. It lets the bookkeeping of AudioSystem run on top of
+FMOD or of an in-process stand-in.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_BACKEND_H
+#define AUDIO_BACKEND_H
+
+#include <FMOD/fmod_studio.hpp>
+#include <AudioEffects.h>
+#include <AudioFileIO.h>
+#include <AudioMemoryArena.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the backends the audio system can run on.
+	 */
+	enum class AudioBackendKind
+	{
+		FMOD, //!< FMOD Studio, mixing to the output device.
+		Null  //!< An in-process stand-in that records calls and simulates voices without mixing.
+	};
+
+	/**
+	 * \brief Enumeration representing where a backend sends its mix.
+	 */
+	enum class AudioOutputMode
+	{
+		Device,      //!< The output device, mixed in real time by the mixer thread.
+		NonRealtime, //!< Nowhere, one block is mixed by every update, as fast as updates are made.
+		WavFile      //!< A WAV file, one block is mixed and written by every update.
+	};
+
+	/**
+	 * \brief Interface representing the system the audio system drives.
+	 *
+	 * The FMOD classes are opaque handles, never dereferenced outside of their own member functions,
+	 * so their pointer types are kept as the handle types of every backend. A backend other than
+	 * FMOD hands out values that only it interprets. Every call returns an FMOD_RESULT with the same
+	 * meaning as the FMOD call it stands for.
+	 */
+	class AudioBackend
+	{
+	public:
+		/**
+		 * \brief Destructor for AudioBackend.
+		 */
+		virtual ~AudioBackend() = default;
+
+		// System
+
+		virtual FMOD_RESULT SetOutput(AudioOutputMode mode, const char* wavPath) = 0; //!< Chooses where Initialize sends the mix, the path is only used by WavFile.
+		virtual FMOD_RESULT SetMemoryArena(AudioMemoryArena* arena) = 0; //!< Routes every allocation of the backend to an arena, before Initialize.
+		virtual FMOD_RESULT SetFileIO(AudioFileIO* io) = 0; //!< Routes the file reads of the backend through an I/O layer, before Initialize, nullptr for the default file I/O.
+		virtual FMOD_RESULT Initialize(int maxChannels, FMOD_STUDIO_INITFLAGS studioFlags) = 0; //!< Creates and initializes the studio and core systems.
+		virtual FMOD_RESULT Release() = 0; //!< Releases the systems and everything they own.
+		virtual FMOD_RESULT Update() = 0; //!< Ticks the studio system.
+		virtual FMOD_RESULT GetVersion(unsigned* version) = 0; //!< Gets the version of the backend.
+		virtual FMOD_RESULT GetOutputRate(int* rate) = 0; //!< Gets the sample rate of the mixer.
+		virtual FMOD_RESULT GetCPUUsage(FMOD_STUDIO_CPU_USAGE* studio, FMOD_CPU_USAGE* core) = 0; //!< Gets the CPU used by the studio and core systems.
+		virtual FMOD_RESULT GetStudioMemoryUsage(FMOD_STUDIO_MEMORY_USAGE* usage) = 0; //!< Gets the memory used by the studio system.
+		virtual FMOD_RESULT GetMemoryStats(int* current, int* peak) = 0; //!< Gets the bytes allocated by the backend, without blocking.
+		virtual FMOD_RESULT GetChannelsPlaying(int* channels, int* realChannels) = 0; //!< Gets the channels playing, and how many are mixed.
+		virtual FMOD_RESULT GetStreamBufferSize(unsigned* size, FMOD_TIMEUNIT* unit) = 0; //!< Gets the file buffer size of streams.
+		virtual FMOD_RESULT GetDSPBufferSize(unsigned* length, int* count) = 0; //!< Gets the samples in a mix block and the blocks buffered.
+
+		// Studio objects
+
+		virtual FMOD_RESULT LoadBankFile(const char* path, FMOD_STUDIO_LOAD_BANK_FLAGS flags, FMOD::Studio::Bank** bank) = 0; //!< Loads a bank.
+		virtual FMOD_RESULT GetBankLoadingState(FMOD::Studio::Bank* bank, FMOD_STUDIO_LOADING_STATE* state) = 0; //!< Gets the progress of a bank load.
+		virtual FMOD_RESULT UnloadBank(FMOD::Studio::Bank* bank) = 0; //!< Unloads a bank.
+		virtual FMOD_RESULT GetEvent(const char* path, FMOD::Studio::EventDescription** description) = 0; //!< Gets an event by path.
+		virtual FMOD_RESULT GetBus(const char* path, FMOD::Studio::Bus** bus) = 0; //!< Gets a bus by path.
+		virtual FMOD_RESULT GetGlobalParameterDescription(const char* name, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter) = 0; //!< Gets a global parameter by name.
+		virtual FMOD_RESULT SetGlobalParameters(const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count) = 0; //!< Sets several global parameters.
+
+		// Event descriptions
+
+		virtual FMOD_RESULT CreateInstance(FMOD::Studio::EventDescription* description, FMOD::Studio::EventInstance** instance) = 0; //!< Creates an instance of an event.
+		virtual FMOD_RESULT ReleaseAllInstances(FMOD::Studio::EventDescription* description) = 0; //!< Releases every instance of an event.
+		virtual FMOD_RESULT LoadSampleData(FMOD::Studio::EventDescription* description) = 0; //!< Loads the sample data of an event.
+		virtual FMOD_RESULT UnloadSampleData(FMOD::Studio::EventDescription* description) = 0; //!< Unloads the sample data of an event.
+		virtual FMOD_RESULT GetParameterCount(FMOD::Studio::EventDescription* description, int* count) = 0; //!< Gets the number of parameters of an event.
+		virtual FMOD_RESULT GetParameterDescription(FMOD::Studio::EventDescription* description, int index, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter) = 0; //!< Gets a parameter of an event by index.
+
+		// Event instances
+
+		virtual FMOD_RESULT StartInstance(FMOD::Studio::EventInstance* instance) = 0; //!< Starts an instance.
+		virtual FMOD_RESULT StopInstance(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_STOP_MODE mode) = 0; //!< Stops an instance.
+		virtual FMOD_RESULT ReleaseInstance(FMOD::Studio::EventInstance* instance) = 0; //!< Releases an instance.
+		virtual FMOD_RESULT SetInstanceParameter(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PARAMETER_ID id, float value) = 0; //!< Sets a parameter of an instance.
+		virtual FMOD_RESULT SetInstanceParameterByName(FMOD::Studio::EventInstance* instance, const char* name, float value) = 0; //!< Sets a parameter of an instance by name.
+		virtual FMOD_RESULT SetInstanceParameters(FMOD::Studio::EventInstance* instance, const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count) = 0; //!< Sets several parameters of an instance.
+		virtual FMOD_RESULT GetInstancePlaybackState(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PLAYBACK_STATE* state) = 0; //!< Gets the playback state of an instance.
+		virtual FMOD_RESULT GetInstanceFinalVolume(FMOD::Studio::EventInstance* instance, float* volume) = 0; //!< Gets the volume of an instance after automation and modulation.
+
+		// Buses
+
+		virtual FMOD_RESULT SetBusVolume(FMOD::Studio::Bus* bus, float volume) = 0; //!< Sets the volume of a bus.
+		virtual FMOD_RESULT GetBusVolume(FMOD::Studio::Bus* bus, float* volume) = 0; //!< Gets the volume of a bus.
+		virtual FMOD_RESULT SetBusPaused(FMOD::Studio::Bus* bus, bool paused) = 0; //!< Pauses or resumes a bus.
+		virtual FMOD_RESULT GetBusPaused(FMOD::Studio::Bus* bus, bool* paused) = 0; //!< Checks if a bus is paused.
+		virtual FMOD_RESULT StopBusEvents(FMOD::Studio::Bus* bus, FMOD_STUDIO_STOP_MODE mode) = 0; //!< Stops every event routed into a bus.
+
+		// Channel groups
+
+		virtual FMOD_RESULT GetMasterChannelGroup(FMOD::ChannelGroup** group) = 0; //!< Gets the master channel group.
+		virtual FMOD_RESULT CreateChannelGroup(const char* name, FMOD::ChannelGroup** group) = 0; //!< Creates a channel group under the master group.
+		virtual FMOD_RESULT SetChannelGroupVolume(FMOD::ChannelGroup* group, float volume) = 0; //!< Sets the volume of a channel group.
+		virtual FMOD_RESULT AddChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp) = 0; //!< Adds a DSP at the head of a channel group, after its fader.
+		virtual FMOD_RESULT RemoveChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp) = 0; //!< Removes a DSP from a channel group.
+
+		// Effects
+
+		virtual FMOD_RESULT CreateEffectDSP(AudioEffect* effect, FMOD::DSP** dsp) = 0; //!< Creates a DSP running an effect on the mixer thread, the effect must outlive the DSP.
+		virtual FMOD_RESULT ReleaseDSP(FMOD::DSP* dsp) = 0; //!< Releases a DSP, removed from every channel group first.
+
+		// Sounds
+
+		virtual FMOD_RESULT CreateSound(const char* name, FMOD_MODE mode, FMOD_CREATESOUNDEXINFO* info, FMOD::Sound** sound) = 0; //!< Opens a sound.
+		virtual FMOD_RESULT ReleaseSound(FMOD::Sound* sound) = 0; //!< Releases a sound.
+		virtual FMOD_RESULT GetSoundMode(FMOD::Sound* sound, FMOD_MODE* mode) = 0; //!< Gets the mode a sound was opened with.
+		virtual FMOD_RESULT GetSoundLength(FMOD::Sound* sound, unsigned* length, FMOD_TIMEUNIT unit) = 0; //!< Gets the length of a sound.
+		virtual FMOD_RESULT GetSoundOpenState(FMOD::Sound* sound, FMOD_OPENSTATE* state) = 0; //!< Gets the progress of a non-blocking open.
+
+		// Channels
+
+		virtual FMOD_RESULT PlaySound(FMOD::Sound* sound, FMOD::ChannelGroup* group, bool paused, FMOD::Channel** channel) = 0; //!< Plays a sound on a new channel.
+		virtual FMOD_RESULT StopChannel(FMOD::Channel* channel) = 0; //!< Stops a channel.
+		virtual FMOD_RESULT SetChannelVolume(FMOD::Channel* channel, float volume) = 0; //!< Sets the volume of a channel.
+		virtual FMOD_RESULT SetChannelPaused(FMOD::Channel* channel, bool paused) = 0; //!< Pauses or resumes a channel.
+		virtual FMOD_RESULT SetChannelPitch(FMOD::Channel* channel, float pitch) = 0; //!< Scales the playback rate of a channel.
+		virtual FMOD_RESULT IsChannelPlaying(FMOD::Channel* channel, bool* playing) = 0; //!< Checks if a channel is playing.
+		virtual FMOD_RESULT GetChannelDSPClock(FMOD::Channel* channel, unsigned long long* clock) = 0; //!< Gets the DSP clock of the parent group of a channel.
+		virtual FMOD_RESULT SetChannelFadeRamp(FMOD::Channel* channel, unsigned long long clock, float volume) = 0; //!< Ramps the volume of a channel until a DSP clock.
+		virtual FMOD_RESULT SetChannelDelay(FMOD::Channel* channel, unsigned long long startClock, unsigned long long endClock, bool stopChannel) = 0; //!< Delays the start or end of a channel.
+	};
+}
+
+#endif // AUDIO_BACKEND_H
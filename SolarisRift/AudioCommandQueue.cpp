@@ -0,0 +1,105 @@
+/* ======================================================================== /
+/!
+\file AudioCommandQueue.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioCommandQueue class.
+This file contains the implementation of the bounded lock-free command
+ring, following the per-cell sequence scheme by Dmitry Vyukov.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <stdafx.h>
+#include <AudioCommandQueue.h>
+
+namespace DeckedOut
+{
+	AudioCommandQueue::AudioCommandQueue(size_t capacity) :
+		cells_(),
+		mask_(0),
+		enqueuePosition_(0),
+		dequeuePosition_(0),
+		overflows_(0)
+	{
+		size_t roundedCapacity = 2;
+		while (roundedCapacity < capacity)
+		{
+			roundedCapacity <<= 1;
+		}
+
+		cells_.reset(new Cell[roundedCapacity]);
+		mask_ = roundedCapacity - 1;
+		for (size_t i = 0; i < roundedCapacity; ++i)
+		{
+			cells_[i].sequence_.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	bool AudioCommandQueue::Enqueue(const AudioCommand& command)
+	{
+		size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;)
+		{
+			cell = &cells_[position & mask_];
+			size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+			if (difference == 0)
+			{
+				// The cell is free for this position, claim it
+				if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The consumer has not read this cell since the last lap, the queue is full
+				overflows_.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else
+			{
+				// Another producer claimed the cell first
+				position = enqueuePosition_.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->command_ = command;
+		cell->sequence_.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool AudioCommandQueue::Dequeue(AudioCommand& command)
+	{
+		size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+		Cell* cell = &cells_[position & mask_];
+		size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+		if ((intptr_t)sequence - (intptr_t)(position + 1) < 0)
+		{
+			return false;
+		}
+
+		command = cell->command_;
+		cell->sequence_.store(position + mask_ + 1, std::memory_order_release);
+		dequeuePosition_.store(position + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	AudioCommandQueueStats AudioCommandQueue::GetStats() const
+	{
+		size_t dequeued = dequeuePosition_.load(std::memory_order_relaxed);
+		size_t enqueued = enqueuePosition_.load(std::memory_order_relaxed);
+
+		AudioCommandQueueStats stats;
+		stats.capacity_ = mask_ + 1;
+		stats.depth_ = (enqueued > dequeued) ? enqueued - dequeued : 0;
+		stats.enqueued_ = enqueued;
+		stats.overflows_ = overflows_.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
@@ -0,0 +1,136 @@
+/* ======================================================================== /
+/!
+\file AudioCommandQueue.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioCommandQueue class.
+This file contains the declaration of AudioCommand, a fixed-size request
+for the audio system, and AudioCommandQueue, a bounded lock-free ring that
+any number of threads can push commands into while a single thread (the
+one calling AudioSystem::Update) drains them.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_COMMAND_QUEUE_H
+#define AUDIO_COMMAND_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <AudioId.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the kinds of audio commands.
+	 */
+	enum class AudioCommandType : uint8_t
+	{
+		PlayEvent,          //!< Play target_ with priority_.
+		StopEvent,          //!< Stop every voice of target_.
+		SetEventParameter,  //!< Set parameter_ of target_ to value_.
+		SetBusVolume,       //!< Set the volume of the bus target_ to value_.
+		SetBusPaused,       //!< Pause the bus target_ if value_ is not zero, resume it otherwise.
+		StopAllEvents,      //!< Stop every event.
+		MuteAllBuses,       //!< Mute every bus, remembering their volumes.
+		UnmuteAllBuses,     //!< Restore the volumes saved by MuteAllBuses.
+		CaptureMixSnapshot, //!< Save the state of every bus into the snapshot target_.
+		ApplyMixSnapshot,   //!< Crossfade to the snapshot target_ over value_ seconds.
+		SetMixSnapshotBus,  //!< Set the bus parameter_ of the snapshot target_ to volume value_, paused if priority_ is not zero.
+		BusStopAllEvents,   //!< Stop every event routed to the bus target_.
+		SetEventPoolSize,   //!< Resize the voice pool of target_ to index_ voices, stealing by the EventStealMode priority_.
+		StopInstance,       //!< Stop the voice voice_ of the event index_, if it still has the generation generation_.
+		SetHandleParameter, //!< Set the parameter parameterId_ of every voice of the event index_ to value_.
+		SetInstanceParameter //!< Set the parameter parameterId_ of the voice voice_ of the event index_ to value_, if it still has the generation generation_.
+	};
+
+	/**
+	 * \brief Struct representing a request for the audio system. Plain data, so it can be copied
+	 * through the queue without allocating.
+	 */
+	struct AudioCommand
+	{
+		AudioCommandType type_; //!< What the command does.
+		AudioId target_; //!< The event, bus or snapshot the command applies to, if any.
+		AudioId parameter_; //!< The parameter name, without the "parameter:/" prefix, for SetEventParameter, the bus for SetMixSnapshotBus.
+		float value_; //!< The parameter value, bus volume or crossfade duration.
+		int priority_; //!< The priority of a PlayEvent.
+		unsigned index_; //!< The event index of a handle command, or the voice count of SetEventPoolSize.
+		unsigned short voice_; //!< The voice of an event instance handle.
+		unsigned short generation_; //!< The generation of an event instance handle.
+		uint32_t parameterId_[2]; //!< The two words of the FMOD parameter id of a handle command.
+	};
+
+	/**
+	 * \brief Struct reporting the activity of a command queue.
+	 */
+	struct AudioCommandQueueStats
+	{
+		size_t capacity_; //!< Number of commands the queue can hold.
+		size_t depth_; //!< Number of commands waiting, approximate while producers are pushing.
+		uint64_t enqueued_; //!< Commands accepted since startup.
+		uint64_t overflows_; //!< Commands rejected because the queue was full.
+	};
+
+	/**
+	 * \brief Class representing a bounded multi-producer, single-consumer queue of audio commands.
+	 *
+	 * Every cell carries a sequence number telling producers and the consumer whose turn it is,
+	 * so neither side ever takes a lock. A full queue rejects the command and counts an overflow.
+	 */
+	class AudioCommandQueue
+	{
+	public:
+		/**
+		 * \brief Constructor for AudioCommandQueue.
+		 * \param capacity The number of commands the queue can hold, rounded up to a power of two.
+		 */
+		explicit AudioCommandQueue(size_t capacity);
+
+		AudioCommandQueue(const AudioCommandQueue&) = delete;
+		AudioCommandQueue& operator=(const AudioCommandQueue&) = delete;
+
+		/**
+		 * \brief Pushes a command. Safe to call from any thread.
+		 * \param command The command to push.
+		 * \return True if the command was queued, false if the queue was full.
+		 */
+		bool Enqueue(const AudioCommand& command);
+
+		/**
+		 * \brief Pops the oldest command. Must only be called from the consuming thread.
+		 * \param command Receives the command.
+		 * \return True if a command was popped, false if the queue was empty.
+		 */
+		bool Dequeue(AudioCommand& command);
+
+		/**
+		 * \brief Gets the capacity, depth and counters of the queue.
+		 * \return The queue statistics.
+		 */
+		AudioCommandQueueStats GetStats() const;
+
+	private:
+		/**
+		 * \brief A slot of the ring.
+		 */
+		struct Cell
+		{
+			std::atomic<size_t> sequence_; //!< Position the cell is waiting to be written or read at.
+			AudioCommand command_; //!< The stored command.
+		};
+
+		std::unique_ptr<Cell[]> cells_; //!< The ring.
+		size_t mask_; //!< Capacity minus one.
+		alignas(64) std::atomic<size_t> enqueuePosition_; //!< Next position producers write to.
+		alignas(64) std::atomic<size_t> dequeuePosition_; //!< Next position the consumer reads from.
+		alignas(64) std::atomic<uint64_t> overflows_; //!< Commands rejected because the queue was full.
+	};
+}
+
+#endif // AUDIO_COMMAND_QUEUE_H
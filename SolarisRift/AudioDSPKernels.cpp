@@ -0,0 +1,263 @@
+/* ======================================================================== /
+/!
+\file AudioDSPKernels.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the DSP kernels of the audio effects.
+This file contains the scalar, SSE and AVX versions of every kernel and the
+detection of the instruction sets the CPU supports.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cmath>
+#include <stdafx.h>
+#include <AudioDSPKernels.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AUDIO_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define AUDIO_SIMD_X86 0
+#endif
+
+// MSVC compiles AVX intrinsics anywhere, GCC and Clang only in functions targeting AVX
+#if AUDIO_SIMD_X86 && defined(__GNUC__)
+#define AUDIO_TARGET_AVX __attribute__((target("avx")))
+#else
+#define AUDIO_TARGET_AVX
+#endif
+
+namespace DeckedOut
+{
+	static float PeakScalar(const float* samples, size_t count)
+	{
+		float peak = 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			peak = std::max(peak, std::fabs(samples[i]));
+		}
+		return peak;
+	}
+
+	static float SumSquaresScalar(const float* samples, size_t count)
+	{
+		float sum = 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			sum += samples[i] * samples[i];
+		}
+		return sum;
+	}
+
+	static void GainRampScalar(const float* in, float* out, size_t frames, int channels, float gain, float step)
+	{
+		for (size_t frame = 0; frame < frames; ++frame)
+		{
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				out[frame * channels + channel] = in[frame * channels + channel] * gain;
+			}
+			gain += step;
+		}
+	}
+
+#if AUDIO_SIMD_X86
+	static float PeakSSE(const float* samples, size_t count)
+	{
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		__m128 peak = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(samples + i), absMask));
+		}
+		peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+		peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, 1));
+		return std::max(_mm_cvtss_f32(peak), PeakScalar(samples + i, count - i));
+	}
+
+	static float SumSquaresSSE(const float* samples, size_t count)
+	{
+		__m128 sum = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 value = _mm_loadu_ps(samples + i);
+			sum = _mm_add_ps(sum, _mm_mul_ps(value, value));
+		}
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		return _mm_cvtss_f32(sum) + SumSquaresScalar(samples + i, count - i);
+	}
+
+	static void GainRampSSE(const float* in, float* out, size_t frames, int channels, float gain, float step)
+	{
+		// A vector must hold whole frames, so 5.1 and other odd layouts stay scalar
+		if (channels <= 0 || 4 % channels != 0)
+		{
+			GainRampScalar(in, out, frames, channels, gain, step);
+			return;
+		}
+
+		int framesPerVector = 4 / channels;
+		__m128 gains = _mm_set_ps(gain + step * (3 / channels), gain + step * (2 / channels),
+			gain + step * (1 / channels), gain);
+		__m128 advance = _mm_set1_ps(step * framesPerVector);
+		size_t count = frames * channels;
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), gains));
+			gains = _mm_add_ps(gains, advance);
+		}
+		size_t frame = i / channels;
+		GainRampScalar(in + i, out + i, frames - frame, channels, gain + step * frame, step);
+	}
+
+	AUDIO_TARGET_AVX static float PeakAVX(const float* samples, size_t count)
+	{
+		const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+		__m256 peak = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			peak = _mm256_max_ps(peak, _mm256_and_ps(_mm256_loadu_ps(samples + i), absMask));
+		}
+		__m128 half = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+		half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+		return std::max(_mm_cvtss_f32(half), PeakScalar(samples + i, count - i));
+	}
+
+	AUDIO_TARGET_AVX static float SumSquaresAVX(const float* samples, size_t count)
+	{
+		__m256 sum = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 value = _mm256_loadu_ps(samples + i);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(value, value));
+		}
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+		return _mm_cvtss_f32(half) + SumSquaresScalar(samples + i, count - i);
+	}
+
+	AUDIO_TARGET_AVX static void GainRampAVX(const float* in, float* out, size_t frames, int channels, float gain, float step)
+	{
+		if (channels <= 0 || 8 % channels != 0)
+		{
+			GainRampSSE(in, out, frames, channels, gain, step);
+			return;
+		}
+
+		int framesPerVector = 8 / channels;
+		__m256 gains = _mm256_set_ps(gain + step * (7 / channels), gain + step * (6 / channels),
+			gain + step * (5 / channels), gain + step * (4 / channels), gain + step * (3 / channels),
+			gain + step * (2 / channels), gain + step * (1 / channels), gain);
+		__m256 advance = _mm256_set1_ps(step * framesPerVector);
+		size_t count = frames * channels;
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), gains));
+			gains = _mm256_add_ps(gains, advance);
+		}
+		size_t frame = i / channels;
+		GainRampScalar(in + i, out + i, frames - frame, channels, gain + step * frame, step);
+	}
+
+	/**
+	 * \brief Detects the widest instruction set the CPU supports and the operating system saves.
+	 * \return The instruction set.
+	 */
+	static AudioSIMDLevel DetectSIMDLevel()
+	{
+		unsigned registers[4] = {};
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		for (int i = 0; i < 4; ++i)
+		{
+			registers[i] = (unsigned)info[i];
+		}
+#else
+		__get_cpuid(1, &registers[0], &registers[1], &registers[2], &registers[3]);
+#endif
+		bool sse2 = (registers[3] & (1u << 26)) != 0;
+		bool osxsave = (registers[2] & (1u << 27)) != 0;
+		bool avx = (registers[2] & (1u << 28)) != 0;
+		if (avx && osxsave)
+		{
+			// AVX is only usable if the operating system saves the upper halves of the registers
+#if defined(_MSC_VER)
+			unsigned long long enabled = _xgetbv(0);
+#else
+			unsigned low;
+			unsigned high;
+			__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+			unsigned long long enabled = ((unsigned long long)high << 32) | low;
+#endif
+			if ((enabled & 6) == 6)
+			{
+				return AudioSIMDLevel::AVX;
+			}
+		}
+		return sse2 ? AudioSIMDLevel::SSE : AudioSIMDLevel::Scalar;
+	}
+#else
+	static AudioSIMDLevel DetectSIMDLevel()
+	{
+		return AudioSIMDLevel::Scalar;
+	}
+#endif
+
+	static const AudioDSPKernels SCALAR_KERNELS = { PeakScalar, SumSquaresScalar, GainRampScalar };
+#if AUDIO_SIMD_X86
+	static const AudioDSPKernels SSE_KERNELS = { PeakSSE, SumSquaresSSE, GainRampSSE };
+	static const AudioDSPKernels AVX_KERNELS = { PeakAVX, SumSquaresAVX, GainRampAVX };
+#endif
+
+	AudioSIMDLevel GetSupportedSIMDLevel()
+	{
+		static const AudioSIMDLevel supported = DetectSIMDLevel();
+		return supported;
+	}
+
+	const AudioDSPKernels& GetAudioDSPKernels(AudioSIMDLevel level)
+	{
+		level = std::min(level, GetSupportedSIMDLevel());
+#if AUDIO_SIMD_X86
+		if (level == AudioSIMDLevel::AVX)
+		{
+			return AVX_KERNELS;
+		}
+		if (level == AudioSIMDLevel::SSE)
+		{
+			return SSE_KERNELS;
+		}
+#endif
+		return SCALAR_KERNELS;
+	}
+
+	const char* GetSIMDLevelName(AudioSIMDLevel level)
+	{
+		switch (level)
+		{
+		case AudioSIMDLevel::SSE: return "SSE";
+		case AudioSIMDLevel::AVX: return "AVX";
+		default:                  return "Scalar";
+		}
+	}
+}
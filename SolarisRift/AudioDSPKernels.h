@@ -0,0 +1,66 @@
+/* ======================================================================== /
+/!
+\file AudioDSPKernels.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the DSP kernels of the audio effects.
+This file contains the declaration of the sample loops the audio effects
+spend their time in, each with a scalar, an SSE and an AVX version picked
+from what the CPU supports.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_DSP_KERNELS_H
+#define AUDIO_DSP_KERNELS_H
+
+#include <cstddef>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the instruction sets the kernels are written for, in increasing width.
+	 */
+	enum class AudioSIMDLevel
+	{
+		Scalar, //!< Plain C++, one sample at a time.
+		SSE,    //!< SSE, four samples at a time.
+		AVX     //!< AVX, eight samples at a time.
+	};
+
+	/**
+	 * \brief Struct holding one version of every kernel. Interleaved buffers hold the samples of a
+	 * frame next to each other, frame after frame.
+	 */
+	struct AudioDSPKernels
+	{
+		float (*peak_)(const float* samples, size_t count); //!< Gets the largest absolute value of the samples.
+		float (*sumSquares_)(const float* samples, size_t count); //!< Gets the sum of the squares of the samples.
+		void (*gainRamp_)(const float* in, float* out, size_t frames, int channels, float gain, float step); //!< Scales interleaved frames by a gain rising by step every frame, in may be out.
+	};
+
+	/**
+	 * \brief Gets the widest instruction set the CPU and the operating system support, detected once.
+	 * \return The instruction set.
+	 */
+	AudioSIMDLevel GetSupportedSIMDLevel();
+
+	/**
+	 * \brief Gets a version of the kernels.
+	 * \param level The instruction set, lowered to the supported one.
+	 * \return The kernels.
+	 */
+	const AudioDSPKernels& GetAudioDSPKernels(AudioSIMDLevel level);
+
+	/**
+	 * \brief Gets the name of an instruction set, for logs and benchmarks.
+	 * \param level The instruction set.
+	 * \return The name.
+	 */
+	const char* GetSIMDLevelName(AudioSIMDLevel level);
+}
+
+#endif // AUDIO_DSP_KERNELS_H
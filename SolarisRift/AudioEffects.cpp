@@ -0,0 +1,399 @@
+/* ======================================================================== /
+/!
+\file AudioEffects.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the audio effects.
+This file contains the implementation of the lookahead limiter, the
+sidechain ducker and the multiband meter.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdafx.h>
+#include <AudioEffects.h>
+
+namespace DeckedOut
+{
+	static constexpr unsigned LIMITER_SEGMENT_FRAMES = 32; //! Frames measured together as they enter the limiter delay
+	static constexpr float DENORMAL_LIMIT = 1e-20f; //! Filter states below this are flushed to zero
+	static constexpr float TWO_PI = 6.28318530718f; //! 2 pi
+
+	/**
+	 * \brief Converts a level in dB to a linear level.
+	 * \param db The level in dB.
+	 * \return The linear level.
+	 */
+	static float DbToLinear(float db)
+	{
+		return std::pow(10.0f, db / 20.0f);
+	}
+
+	/**
+	 * \brief Gets the coefficient of a one-pole smoother.
+	 * \param time Time the smoother takes to move most of the way, in seconds.
+	 * \param frames Number of frames the coefficient covers.
+	 * \param sampleRate The sample rate.
+	 * \return The portion of the distance left after the frames.
+	 */
+	static float GetSmoothing(float time, float frames, int sampleRate)
+	{
+		if (time <= 0.0f || sampleRate <= 0)
+		{
+			return 0.0f;
+		}
+		return std::exp(-frames / (time * (float)sampleRate));
+	}
+
+	AudioEffect::AudioEffect(AudioSIMDLevel level) :
+		kernels_(&GetAudioDSPKernels(level)),
+		level_(std::min(level, GetSupportedSIMDLevel()))
+	{
+	}
+
+	AudioSIMDLevel AudioEffect::GetSIMDLevel() const
+	{
+		return level_;
+	}
+
+	void AudioEffect::PassThrough(const float* in, float* out, unsigned frames, int channels)
+	{
+		if (in != out && channels > 0)
+		{
+			memcpy(out, in, (size_t)frames * channels * sizeof(float));
+		}
+	}
+
+	LookaheadLimiter::LookaheadLimiter(const LimiterSettings& settings, AudioSIMDLevel level) :
+		AudioEffect(level),
+		settings_(settings),
+		threshold_(DbToLinear(settings.thresholdDb_)),
+		releaseCoefficient_(0.0f),
+		delayFrames_(0),
+		maxChannels_(0),
+		channels_(0),
+		delay_(),
+		delayPosition_(0),
+		segment_(),
+		runs_(),
+		runStart_(0),
+		runCount_(0),
+		gain_(1.0f),
+		minGain_(1.0f)
+	{
+	}
+
+	void LookaheadLimiter::Prepare(int sampleRate, unsigned maxFrames, int maxChannels)
+	{
+		UNREFERENCED_PARAMETER(maxFrames);
+
+		releaseCoefficient_ = GetSmoothing(settings_.release_, 1.0f, sampleRate);
+		delayFrames_ = std::max(1u, (unsigned)std::lround(settings_.lookahead_ * (float)sampleRate));
+		maxChannels_ = std::max(maxChannels, 0);
+		delay_.assign((size_t)delayFrames_ * maxChannels_, 0.0f);
+		segment_.assign((size_t)LIMITER_SEGMENT_FRAMES * maxChannels_, 0.0f);
+
+		// Every run holds a frame at least, and the delay never holds more than one segment past its length
+		runs_.assign(delayFrames_ + LIMITER_SEGMENT_FRAMES + 1, TargetRun());
+		Reset(0);
+	}
+
+	void LookaheadLimiter::Process(const float* in, float* out, unsigned frames, int channels)
+	{
+		if (channels <= 0 || channels > maxChannels_ || runs_.empty())
+		{
+			PassThrough(in, out, frames, channels);
+			return;
+		}
+		if (channels != channels_)
+		{
+			Reset(channels);
+		}
+
+		float minGain = gain_;
+		unsigned done = 0;
+		while (done < frames)
+		{
+			// Segments never wrap around the ring, so the frames in and out are one contiguous run
+			unsigned length = std::min({ LIMITER_SEGMENT_FRAMES, frames - done, delayFrames_ - delayPosition_ });
+			size_t count = (size_t)length * channels;
+
+			// The input is copied first, out may be in
+			memcpy(segment_.data(), in + (size_t)done * channels, count * sizeof(float));
+			float peak = kernels_->peak_(segment_.data(), count);
+			PushRun((peak > threshold_) ? threshold_ / peak : 1.0f, length);
+
+			float* delayed = delay_.data() + (size_t)delayPosition_ * channels;
+			float* target = out + (size_t)done * channels;
+			unsigned played = 0;
+			while (played < length)
+			{
+				TargetRun& run = runs_[runStart_];
+				unsigned slice = std::min(length - played, run.frames_);
+				gain_ = std::min(gain_, run.target_);
+				float slope = GetSlope(slice);
+				kernels_->gainRamp_(delayed + (size_t)played * channels, target + (size_t)played * channels,
+					slice, channels, gain_, slope);
+				minGain = std::min({ minGain, gain_, gain_ + slope * (float)(slice - 1) });
+				gain_ += slope * (float)slice;
+
+				run.frames_ -= slice;
+				if (run.frames_ == 0)
+				{
+					runStart_ = (runStart_ + 1) % runs_.size();
+					--runCount_;
+				}
+				played += slice;
+			}
+
+			memcpy(delayed, segment_.data(), count * sizeof(float));
+			delayPosition_ = (delayPosition_ + length) % delayFrames_;
+			done += length;
+		}
+		minGain_.store(minGain, std::memory_order_relaxed);
+	}
+
+	const char* LookaheadLimiter::GetName() const
+	{
+		return "Lookahead Limiter";
+	}
+
+	float LookaheadLimiter::GetGainReductionDb() const
+	{
+		return -20.0f * std::log10(std::max(minGain_.load(std::memory_order_relaxed), 1e-6f));
+	}
+
+	void LookaheadLimiter::Reset(int channels)
+	{
+		channels_ = channels;
+		std::fill(delay_.begin(), delay_.end(), 0.0f);
+		delayPosition_ = 0;
+		runStart_ = 0;
+		runCount_ = 0;
+		PushRun(1.0f, delayFrames_);
+		gain_ = 1.0f;
+		minGain_.store(1.0f, std::memory_order_relaxed);
+	}
+
+	void LookaheadLimiter::PushRun(float target, unsigned frames)
+	{
+		if (runCount_ > 0)
+		{
+			TargetRun& last = runs_[(runStart_ + runCount_ - 1) % runs_.size()];
+			if (last.target_ == target)
+			{
+				last.frames_ += frames;
+				return;
+			}
+		}
+		runs_[(runStart_ + runCount_) % runs_.size()] = TargetRun{ target, frames };
+		++runCount_;
+	}
+
+	float LookaheadLimiter::GetSlope(unsigned frames) const
+	{
+		// Release towards unity, then fall to reach the target of every run in the delay by its first frame
+		float released = 1.0f - (1.0f - gain_) * std::pow(releaseCoefficient_, (float)frames);
+		float slope = (released - gain_) / (float)frames;
+
+		const TargetRun& current = runs_[runStart_];
+		if (frames > 1)
+		{
+			slope = std::min(slope, (current.target_ - gain_) / (float)(frames - 1));
+		}
+
+		unsigned distance = current.frames_;
+		for (size_t i = 1; i < runCount_; ++i)
+		{
+			const TargetRun& run = runs_[(runStart_ + i) % runs_.size()];
+			slope = std::min(slope, (run.target_ - gain_) / (float)distance);
+			distance += run.frames_;
+		}
+		return slope;
+	}
+
+	SidechainDucker::SidechainDucker(std::shared_ptr<const std::atomic<float>> key,
+		const DuckerSettings& settings, AudioSIMDLevel level) :
+		AudioEffect(level),
+		key_(std::move(key)),
+		settings_(settings),
+		threshold_(DbToLinear(settings.thresholdDb_)),
+		depth_(DbToLinear(settings.depthDb_)),
+		sampleRate_(0),
+		maxChannels_(0),
+		gain_(1.0f),
+		publishedGain_(1.0f)
+	{
+	}
+
+	void SidechainDucker::Prepare(int sampleRate, unsigned maxFrames, int maxChannels)
+	{
+		UNREFERENCED_PARAMETER(maxFrames);
+
+		sampleRate_ = sampleRate;
+		maxChannels_ = maxChannels;
+		gain_ = 1.0f;
+		publishedGain_.store(1.0f, std::memory_order_relaxed);
+	}
+
+	void SidechainDucker::Process(const float* in, float* out, unsigned frames, int channels)
+	{
+		if (channels <= 0 || channels > maxChannels_ || frames == 0)
+		{
+			PassThrough(in, out, frames, channels);
+			return;
+		}
+
+		// The key is measured by another group's mixer, one block behind at most
+		float level = (key_ != nullptr) ? key_->load(std::memory_order_relaxed) : 0.0f;
+		float target = (level > threshold_) ? depth_ : 1.0f;
+		float time = (target < gain_) ? settings_.attack_ : settings_.release_;
+		float end = target + (gain_ - target) * GetSmoothing(time, (float)frames, sampleRate_);
+
+		kernels_->gainRamp_(in, out, frames, channels, gain_, (end - gain_) / (float)frames);
+		gain_ = end;
+		publishedGain_.store(gain_, std::memory_order_relaxed);
+	}
+
+	const char* SidechainDucker::GetName() const
+	{
+		return "Sidechain Ducker";
+	}
+
+	float SidechainDucker::GetGainDb() const
+	{
+		return 20.0f * std::log10(std::max(publishedGain_.load(std::memory_order_relaxed), 1e-6f));
+	}
+
+	MultibandMeter::MultibandMeter(const MeterSettings& settings, AudioSIMDLevel level) :
+		AudioEffect(level),
+		settings_(settings),
+		sampleRate_(0),
+		maxFrames_(0),
+		maxChannels_(0),
+		lowCoefficient_(0.0f),
+		highCoefficient_(0.0f),
+		lowState_(0.0f),
+		highState_(0.0f),
+		bands_(),
+		rms_(),
+		peak_(),
+		publishedRms_(),
+		publishedPeak_(),
+		key_(std::make_shared<std::atomic<float>>(0.0f))
+	{
+		for (int band = 0; band <= (int)MeterBand::Count; ++band)
+		{
+			if (band < (int)MeterBand::Count)
+			{
+				publishedRms_[band].store(0.0f, std::memory_order_relaxed);
+			}
+			publishedPeak_[band].store(0.0f, std::memory_order_relaxed);
+		}
+	}
+
+	void MultibandMeter::Prepare(int sampleRate, unsigned maxFrames, int maxChannels)
+	{
+		sampleRate_ = sampleRate;
+		maxFrames_ = std::max(maxFrames, 1u);
+		maxChannels_ = maxChannels;
+		lowCoefficient_ = 1.0f - std::exp(-TWO_PI * settings_.lowCrossover_ / (float)std::max(sampleRate, 1));
+		highCoefficient_ = 1.0f - std::exp(-TWO_PI * settings_.highCrossover_ / (float)std::max(sampleRate, 1));
+		lowState_ = 0.0f;
+		highState_ = 0.0f;
+		bands_.assign((size_t)maxFrames_ * (int)MeterBand::Count, 0.0f);
+		std::fill(std::begin(rms_), std::end(rms_), 0.0f);
+		std::fill(std::begin(peak_), std::end(peak_), 0.0f);
+	}
+
+	void MultibandMeter::Process(const float* in, float* out, unsigned frames, int channels)
+	{
+		PassThrough(in, out, frames, channels);
+		if (channels <= 0 || channels > maxChannels_ || bands_.empty())
+		{
+			return;
+		}
+
+		for (unsigned done = 0; done < frames; done += maxFrames_)
+		{
+			Measure(in + (size_t)done * channels, std::min(maxFrames_, frames - done), channels);
+		}
+	}
+
+	const char* MultibandMeter::GetName() const
+	{
+		return "Multiband Meter";
+	}
+
+	MeterReading MultibandMeter::GetReading() const
+	{
+		MeterReading reading;
+		for (int band = 0; band < (int)MeterBand::Count; ++band)
+		{
+			reading.rms_[band] = publishedRms_[band].load(std::memory_order_relaxed);
+			reading.peak_[band] = publishedPeak_[band].load(std::memory_order_relaxed);
+		}
+		reading.broadbandRms_ = key_->load(std::memory_order_relaxed);
+		reading.broadbandPeak_ = publishedPeak_[(int)MeterBand::Count].load(std::memory_order_relaxed);
+		return reading;
+	}
+
+	std::shared_ptr<const std::atomic<float>> MultibandMeter::GetKey() const
+	{
+		return key_;
+	}
+
+	void MultibandMeter::Measure(const float* in, unsigned frames, int channels)
+	{
+		// The crossovers are recursive, so the split runs a frame at a time and the measuring is vectorized
+		float* low = bands_.data();
+		float* mid = low + maxFrames_;
+		float* high = mid + maxFrames_;
+		float scale = 1.0f / (float)channels;
+		for (unsigned frame = 0; frame < frames; ++frame)
+		{
+			float mono = 0.0f;
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				mono += in[(size_t)frame * channels + channel];
+			}
+			mono *= scale;
+			lowState_ += lowCoefficient_ * (mono - lowState_);
+			highState_ += highCoefficient_ * (mono - highState_);
+			low[frame] = lowState_;
+			mid[frame] = highState_ - lowState_;
+			high[frame] = mono - highState_;
+		}
+		if (std::fabs(lowState_) < DENORMAL_LIMIT)
+		{
+			lowState_ = 0.0f;
+		}
+		if (std::fabs(highState_) < DENORMAL_LIMIT)
+		{
+			highState_ = 0.0f;
+		}
+
+		float fall = GetSmoothing(settings_.release_, (float)frames, sampleRate_);
+		for (int band = 0; band < (int)MeterBand::Count; ++band)
+		{
+			const float* samples = bands_.data() + (size_t)band * maxFrames_;
+			rms_[band] = std::max(std::sqrt(kernels_->sumSquares_(samples, frames) / (float)frames), rms_[band] * fall);
+			peak_[band] = std::max(kernels_->peak_(samples, frames), peak_[band] * fall);
+			publishedRms_[band].store(rms_[band], std::memory_order_relaxed);
+			publishedPeak_[band].store(peak_[band], std::memory_order_relaxed);
+		}
+
+		int broadband = (int)MeterBand::Count;
+		size_t count = (size_t)frames * channels;
+		rms_[broadband] = std::max(std::sqrt(kernels_->sumSquares_(in, count) / (float)count), rms_[broadband] * fall);
+		peak_[broadband] = std::max(kernels_->peak_(in, count), peak_[broadband] * fall);
+		key_->store(rms_[broadband], std::memory_order_relaxed);
+		publishedPeak_[broadband].store(peak_[broadband], std::memory_order_relaxed);
+	}
+}
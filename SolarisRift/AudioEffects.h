@@ -0,0 +1,290 @@
+/* ======================================================================== /
+/!
+\file AudioEffects.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the audio effects.
+This file contains the declaration of AudioEffect, the base of the custom
+DSP effects run on the channel groups, and of the lookahead limiter, the
+sidechain ducker and the multiband meter.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_EFFECTS_H
+#define AUDIO_EFFECTS_H
+
+#include <AudioDSPKernels.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Class representing a custom DSP effect. Process runs on the mixer thread, everything
+	 * the game thread reads from an effect goes through atomics.
+	 */
+	class AudioEffect
+	{
+	public:
+		/**
+		 * \brief Constructor for AudioEffect.
+		 * \param level The instruction set of the kernels, lowered to the supported one.
+		 */
+		explicit AudioEffect(AudioSIMDLevel level);
+
+		/**
+		 * \brief Virtual destructor for AudioEffect.
+		 */
+		virtual ~AudioEffect() = default;
+
+		AudioEffect(const AudioEffect&) = delete;
+		AudioEffect& operator=(const AudioEffect&) = delete;
+
+		/**
+		 * \brief Allocates the buffers of the effect and clears its state, before the first Process.
+		 * \param sampleRate The sample rate of the mixer.
+		 * \param maxFrames The largest block the mixer processes.
+		 * \param maxChannels The most channels of a block, larger blocks pass through.
+		 */
+		virtual void Prepare(int sampleRate, unsigned maxFrames, int maxChannels) = 0;
+
+		/**
+		 * \brief Processes a block of interleaved samples.
+		 * \param in The input samples.
+		 * \param out The output samples, may be in.
+		 * \param frames The number of frames.
+		 * \param channels The number of channels of a frame.
+		 */
+		virtual void Process(const float* in, float* out, unsigned frames, int channels) = 0;
+
+		/**
+		 * \brief Gets the name of the effect.
+		 * \return The name.
+		 */
+		virtual const char* GetName() const = 0;
+
+		/**
+		 * \brief Gets the instruction set the effect runs on.
+		 * \return The instruction set.
+		 */
+		AudioSIMDLevel GetSIMDLevel() const;
+
+	protected:
+		const AudioDSPKernels* kernels_; //!< The kernels of the instruction set.
+		AudioSIMDLevel level_; //!< The instruction set.
+
+		/**
+		 * \brief Copies a block through unchanged.
+		 * \param in The input samples.
+		 * \param out The output samples, may be in.
+		 * \param frames The number of frames.
+		 * \param channels The number of channels of a frame.
+		 */
+		static void PassThrough(const float* in, float* out, unsigned frames, int channels);
+	};
+
+	/**
+	 * \brief Struct describing a LookaheadLimiter.
+	 */
+	struct LimiterSettings
+	{
+		float thresholdDb_ = -1.0f; //!< Level no output sample exceeds, in dB.
+		float lookahead_ = 0.005f; //!< Time the audio is delayed so the gain falls before a peak, in seconds.
+		float release_ = 0.1f; //!< Time the gain takes to recover most of the way, in seconds.
+	};
+
+	/**
+	 * \brief Class representing a lookahead limiter.
+	 *
+	 * The input is delayed by the lookahead and measured in segments as it enters. The gain ramps
+	 * down while a loud segment crosses the delay so that it reaches the segment's target when the
+	 * segment leaves, which keeps every output sample under the threshold without clipping.
+	 */
+	class LookaheadLimiter : public AudioEffect
+	{
+	public:
+		/**
+		 * \brief Constructor for LookaheadLimiter.
+		 * \param settings The threshold, lookahead and release.
+		 * \param level The instruction set of the kernels.
+		 */
+		explicit LookaheadLimiter(const LimiterSettings& settings = LimiterSettings(),
+			AudioSIMDLevel level = GetSupportedSIMDLevel());
+
+		void Prepare(int sampleRate, unsigned maxFrames, int maxChannels) override;
+		void Process(const float* in, float* out, unsigned frames, int channels) override;
+		const char* GetName() const override;
+
+		/**
+		 * \brief Gets the gain reduction of the last block.
+		 * \return The largest reduction, in dB, 0 when the limiter is idle.
+		 */
+		float GetGainReductionDb() const;
+
+	private:
+		/**
+		 * \brief A run of frames in the delay sharing a target gain.
+		 */
+		struct TargetRun
+		{
+			float target_; //!< Gain the frames must be played at or below.
+			unsigned frames_; //!< Number of frames.
+		};
+
+		LimiterSettings settings_; //!< The threshold, lookahead and release.
+		float threshold_; //!< The threshold, as a linear level.
+		float releaseCoefficient_; //!< Portion of the gain reduction kept every frame.
+		unsigned delayFrames_; //!< Length of the delay.
+		int maxChannels_; //!< Most channels of a block.
+		int channels_; //!< Channels of the delayed audio.
+		std::vector<float> delay_; //!< Ring of delayed frames.
+		unsigned delayPosition_; //!< Oldest frame of the ring, the next one out.
+		std::vector<float> segment_; //!< Copy of the segment entering the delay.
+		std::vector<TargetRun> runs_; //!< Ring of the targets of the delayed frames, oldest first.
+		size_t runStart_; //!< Oldest run of the ring.
+		size_t runCount_; //!< Number of runs in the ring.
+		float gain_; //!< Gain of the next frame out.
+		std::atomic<float> minGain_; //!< Lowest gain of the last block.
+
+		void Reset(int channels); //!< Fills the delay with silence and releases the gain.
+		void PushRun(float target, unsigned frames); //!< Queues the target of frames entering the delay.
+		float GetSlope(unsigned frames) const; //!< Gets the gain change per frame over the next frames out.
+	};
+
+	/**
+	 * \brief Struct describing a SidechainDucker.
+	 */
+	struct DuckerSettings
+	{
+		float thresholdDb_ = -30.0f; //!< Key level above which the audio is ducked, in dB.
+		float depthDb_ = -12.0f; //!< Gain of the ducked audio, in dB.
+		float attack_ = 0.02f; //!< Time the gain takes to fall most of the way, in seconds.
+		float release_ = 0.4f; //!< Time the gain takes to recover most of the way, in seconds.
+	};
+
+	/**
+	 * \brief Class representing a ducker lowering its audio while a key, usually the level of
+	 * another channel group, is loud.
+	 */
+	class SidechainDucker : public AudioEffect
+	{
+	public:
+		/**
+		 * \brief Constructor for SidechainDucker.
+		 * \param key The linear level of the key, read every block.
+		 * \param settings The threshold, depth, attack and release.
+		 * \param level The instruction set of the kernels.
+		 */
+		SidechainDucker(std::shared_ptr<const std::atomic<float>> key,
+			const DuckerSettings& settings = DuckerSettings(), AudioSIMDLevel level = GetSupportedSIMDLevel());
+
+		void Prepare(int sampleRate, unsigned maxFrames, int maxChannels) override;
+		void Process(const float* in, float* out, unsigned frames, int channels) override;
+		const char* GetName() const override;
+
+		/**
+		 * \brief Gets the gain applied at the end of the last block.
+		 * \return The gain, in dB.
+		 */
+		float GetGainDb() const;
+
+	private:
+		std::shared_ptr<const std::atomic<float>> key_; //!< The linear level of the key.
+		DuckerSettings settings_; //!< The threshold, depth, attack and release.
+		float threshold_; //!< The threshold, as a linear level.
+		float depth_; //!< The depth, as a linear gain.
+		int sampleRate_; //!< The sample rate of the mixer.
+		int maxChannels_; //!< Most channels of a block.
+		float gain_; //!< Gain of the next frame.
+		std::atomic<float> publishedGain_; //!< Gain at the end of the last block.
+	};
+
+	/**
+	 * \brief Enumeration representing the bands of a MultibandMeter.
+	 */
+	enum class MeterBand
+	{
+		Low,   //!< Below the low crossover.
+		Mid,   //!< Between the crossovers.
+		High,  //!< Above the high crossover.
+		Count  //!< Number of bands.
+	};
+
+	/**
+	 * \brief Struct describing a MultibandMeter.
+	 */
+	struct MeterSettings
+	{
+		float lowCrossover_ = 250.0f; //!< Frequency between the low and mid bands, in Hz.
+		float highCrossover_ = 4000.0f; //!< Frequency between the mid and high bands, in Hz.
+		float release_ = 0.3f; //!< Time a reading takes to fall most of the way, in seconds.
+	};
+
+	/**
+	 * \brief Struct holding the levels a MultibandMeter measured, as linear levels.
+	 */
+	struct MeterReading
+	{
+		float rms_[(int)MeterBand::Count]; //!< RMS level, per band.
+		float peak_[(int)MeterBand::Count]; //!< Peak level, per band.
+		float broadbandRms_; //!< RMS level of every channel.
+		float broadbandPeak_; //!< Peak level of every channel.
+	};
+
+	/**
+	 * \brief Class representing a meter splitting its audio into three bands, passing the audio
+	 * through unchanged.
+	 */
+	class MultibandMeter : public AudioEffect
+	{
+	public:
+		/**
+		 * \brief Constructor for MultibandMeter.
+		 * \param settings The crossovers and release.
+		 * \param level The instruction set of the kernels.
+		 */
+		explicit MultibandMeter(const MeterSettings& settings = MeterSettings(),
+			AudioSIMDLevel level = GetSupportedSIMDLevel());
+
+		void Prepare(int sampleRate, unsigned maxFrames, int maxChannels) override;
+		void Process(const float* in, float* out, unsigned frames, int channels) override;
+		const char* GetName() const override;
+
+		/**
+		 * \brief Gets the levels the meter measured.
+		 * \return The levels.
+		 */
+		MeterReading GetReading() const;
+
+		/**
+		 * \brief Gets the broadband RMS level, to key a SidechainDucker with.
+		 * \return The level, updated every block.
+		 */
+		std::shared_ptr<const std::atomic<float>> GetKey() const;
+
+	private:
+		MeterSettings settings_; //!< The crossovers and release.
+		int sampleRate_; //!< The sample rate of the mixer.
+		unsigned maxFrames_; //!< Largest block measured at once.
+		int maxChannels_; //!< Most channels of a block.
+		float lowCoefficient_; //!< Coefficient of the low crossover filter.
+		float highCoefficient_; //!< Coefficient of the high crossover filter.
+		float lowState_; //!< State of the low crossover filter.
+		float highState_; //!< State of the high crossover filter.
+		std::vector<float> bands_; //!< The mono downmix split into the bands, one after the other.
+		float rms_[(int)MeterBand::Count + 1]; //!< Smoothed RMS level, per band then broadband.
+		float peak_[(int)MeterBand::Count + 1]; //!< Smoothed peak level, per band then broadband.
+		std::atomic<float> publishedRms_[(int)MeterBand::Count]; //!< RMS level, per band.
+		std::atomic<float> publishedPeak_[(int)MeterBand::Count + 1]; //!< Peak level, per band then broadband.
+		std::shared_ptr<std::atomic<float>> key_; //!< Broadband RMS level.
+
+		void Measure(const float* in, unsigned frames, int channels); //!< Measures at most maxFrames_ frames.
+	};
+}
+
+#endif // AUDIO_EFFECTS_H
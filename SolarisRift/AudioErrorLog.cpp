@@ -0,0 +1,96 @@
+/* ======================================================================== /
+/!
+\file AudioErrorLog.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioErrorLog class.
+This file contains the implementation of the runtime audio error ring and
+its per-code counters.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <thread>
+#include <stdafx.h>
+#include <AudioErrorLog.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Gets the counter of a result code.
+	 * \param result The result code.
+	 * \return The index of its counter.
+	 */
+	static int GetCounterIndex(FMOD_RESULT result)
+	{
+		int code = (int)result;
+		return (code >= 0 && code < AudioErrorLog::RESULT_CODES) ? code : AudioErrorLog::RESULT_CODES - 1;
+	}
+
+	AudioErrorLog::AudioErrorLog() :
+		records_(),
+		recordCount_(0)
+	{
+		for (int i = 0; i < RESULT_CODES; ++i)
+		{
+			counts_[i].store(0, std::memory_order_relaxed);
+		}
+		lock_.clear();
+	}
+
+	void AudioErrorLog::Record(FMOD_RESULT result, const char* site, AudioId id, uint64_t frame) noexcept
+	{
+		counts_[GetCounterIndex(result)].fetch_add(1, std::memory_order_relaxed);
+
+		Lock();
+		AudioErrorRecord& record = records_[recordCount_ % CAPACITY];
+		record.result_ = result;
+		record.site_ = site;
+		record.id_ = id;
+		record.frame_ = frame;
+		++recordCount_;
+		Unlock();
+	}
+
+	uint64_t AudioErrorLog::GetRecordCount() const noexcept
+	{
+		Lock();
+		uint64_t recordCount = recordCount_;
+		Unlock();
+		return recordCount;
+	}
+
+	bool AudioErrorLog::GetRecord(uint64_t number, AudioErrorRecord& record) const noexcept
+	{
+		Lock();
+		bool available = number < recordCount_ && recordCount_ - number <= CAPACITY;
+		if (available)
+		{
+			record = records_[number % CAPACITY];
+		}
+		Unlock();
+		return available;
+	}
+
+	uint32_t AudioErrorLog::GetCount(FMOD_RESULT result) const noexcept
+	{
+		return counts_[GetCounterIndex(result)].load(std::memory_order_relaxed);
+	}
+
+	void AudioErrorLog::Lock() const noexcept
+	{
+		// Held for a copy of a few words, so spinning is cheaper than a mutex
+		while (lock_.test_and_set(std::memory_order_acquire))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	void AudioErrorLog::Unlock() const noexcept
+	{
+		lock_.clear(std::memory_order_release);
+	}
+}
@@ -0,0 +1,107 @@
+/* ======================================================================== /
+/!
+\file AudioErrorLog.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioErrorLog class.
+This file contains the declaration of the AudioErrorLog class, a fixed-size
+record of the FMOD failures met at runtime, with a counter per result code.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_ERROR_LOG_H
+#define AUDIO_ERROR_LOG_H
+
+#include <FMOD/fmod_common.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <AudioId.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Struct representing one recorded failure.
+	 */
+	struct AudioErrorRecord
+	{
+		FMOD_RESULT result_; //!< The failing result.
+		const char* site_; //!< Name of the function that met the failure, a string with static storage.
+		AudioId id_; //!< The event, bus or sound involved, default if none.
+		uint64_t frame_; //!< Audio frame at which the failure was met.
+	};
+
+	/**
+	 * \brief Class representing the most recent runtime audio failures.
+	 *
+	 * Recording never allocates or throws and can happen on any thread. The ring keeps the last
+	 * CAPACITY records, older ones are overwritten while the per-code counters keep growing.
+	 */
+	class AudioErrorLog
+	{
+	public:
+		static constexpr size_t CAPACITY = 256; //!< Number of records kept.
+		static constexpr int RESULT_CODES = 128; //!< Number of result codes counted separately, larger codes share the last counter.
+
+		/**
+		 * \brief Default constructor for AudioErrorLog.
+		 */
+		AudioErrorLog();
+
+		AudioErrorLog(const AudioErrorLog&) = delete;
+		AudioErrorLog& operator=(const AudioErrorLog&) = delete;
+
+		/**
+		 * \brief Records a failure.
+		 * \param result The failing result.
+		 * \param site Name of the function that met the failure, a string with static storage.
+		 * \param id The event, bus or sound involved.
+		 * \param frame Audio frame at which the failure was met.
+		 */
+		void Record(FMOD_RESULT result, const char* site, AudioId id, uint64_t frame) noexcept;
+
+		/**
+		 * \brief Gets the number of failures recorded since startup. Records are numbered from zero
+		 * in the order they were made.
+		 * \return The number of failures.
+		 */
+		uint64_t GetRecordCount() const noexcept;
+
+		/**
+		 * \brief Gets a record by number.
+		 * \param number The number of the record.
+		 * \param record Receives the record.
+		 * \return True if the record exists, false if it was not made yet or was overwritten.
+		 */
+		bool GetRecord(uint64_t number, AudioErrorRecord& record) const noexcept;
+
+		/**
+		 * \brief Gets how many times a result code was recorded since startup.
+		 * \param result The result code.
+		 * \return The number of failures with that code.
+		 */
+		uint32_t GetCount(FMOD_RESULT result) const noexcept;
+
+	private:
+		/**
+		 * \brief Locks the ring, spinning while another thread records or reads.
+		 */
+		void Lock() const noexcept;
+
+		/**
+		 * \brief Unlocks the ring.
+		 */
+		void Unlock() const noexcept;
+
+		AudioErrorRecord records_[CAPACITY]; //!< The ring of records.
+		uint64_t recordCount_; //!< Number of records made, the next one goes at recordCount_ % CAPACITY.
+		std::atomic<uint32_t> counts_[RESULT_CODES]; //!< Number of failures of each result code.
+		mutable std::atomic_flag lock_; //!< Guards records_ and recordCount_.
+	};
+}
+
+#endif // AUDIO_ERROR_LOG_H
@@ -0,0 +1,401 @@
+/* ======================================================================== /
+/!
+\file AudioFileIO.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioFileIO class.
+This file contains the implementation of the I/O threads, of the read-ahead
+windows and of the FMOD file callbacks they serve.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdafx.h>
+#include <AudioFileIO.h>
+
+namespace DeckedOut
+{
+	static constexpr uint64_t SEQUENCE_MASK = (1ull << 54) - 1; //! Bits of the sort key holding the sequence number
+	static constexpr int MAX_FMOD_PRIORITY = 100; //! Highest priority FMOD gives a read
+
+	/**
+	 * \brief Checks if a window holds a read. A read running past the end of the file only needs the
+	 * window to reach the end.
+	 * \param offset Offset of the first byte of the window.
+	 * \param size Number of bytes in the window.
+	 * \param fileSize Size of the file.
+	 * \param readOffset Offset of the read.
+	 * \param readBytes Size of the read.
+	 * \return True if the window holds every byte of the read that exists.
+	 */
+	static bool WindowHolds(uint64_t offset, size_t size, uint64_t fileSize, uint64_t readOffset, size_t readBytes)
+	{
+		uint64_t end = offset + size;
+		return size > 0 && readOffset >= offset && readOffset < end && (readOffset + readBytes <= end || end == fileSize);
+	}
+
+	/**
+	 * \brief Finds the latency bucket of a read.
+	 * \param seconds The latency of the read.
+	 * \return The bucket.
+	 */
+	static unsigned GetLatencyBucket(float seconds)
+	{
+		unsigned bucket = 0;
+		float limit = AudioFileIOStats::LATENCY_BUCKET_BASE;
+		while (bucket < AudioFileIOStats::LATENCY_BUCKETS - 1 && seconds >= limit)
+		{
+			limit *= 2.0f;
+			++bucket;
+		}
+		return bucket;
+	}
+
+	float AudioFileIOStats::GetBucketLimit(unsigned bucket)
+	{
+		if (bucket >= LATENCY_BUCKETS - 1)
+		{
+			return std::numeric_limits<float>::infinity();
+		}
+		return LATENCY_BUCKET_BASE * (float)(1u << bucket);
+	}
+
+	AudioFileIO::AudioFileIO() :
+		settings_(),
+		threads_(),
+		queue_(),
+		serving_(),
+		sequence_(0),
+		stopping_(false),
+		stats_(),
+		mutex_(),
+		wake_(),
+		served_()
+	{
+	}
+
+	AudioFileIO::~AudioFileIO()
+	{
+		Stop();
+	}
+
+	void AudioFileIO::Start(const AudioFileIOSettings& settings)
+	{
+		Stop();
+		settings_ = settings;
+		stats_ = AudioFileIOStats();
+		stopping_ = false;
+		for (unsigned i = 0; i < settings_.threads_; ++i)
+		{
+			threads_.emplace_back(&AudioFileIO::RunThread, this);
+		}
+	}
+
+	void AudioFileIO::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		for (std::thread& thread : threads_)
+		{
+			thread.join();
+		}
+		threads_.clear();
+	}
+
+	bool AudioFileIO::IsRunning() const
+	{
+		return !threads_.empty();
+	}
+
+	AudioFileIOStats AudioFileIO::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		AudioFileIOStats stats = stats_;
+		stats.queueDepth_ = queue_.size();
+		return stats;
+	}
+
+	void* AudioFileIO::GetUserData(AudioFilePriority priority)
+	{
+		// Offset by one so a file opened without user data gets the default class
+		return reinterpret_cast<void*>((uintptr_t)priority + 1);
+	}
+
+	FMOD_RESULT AudioFileIO::Open(const char* name, unsigned* size, void** handle, void* userdata)
+	{
+		std::unique_ptr<OpenFile> file = std::make_unique<OpenFile>();
+		file->stream_.open(name, std::ios::binary);
+		if (!file->stream_.is_open())
+		{
+			return FMOD_ERR_FILE_NOTFOUND;
+		}
+		file->stream_.seekg(0, std::ios::end);
+		file->size_ = (uint64_t)file->stream_.tellg();
+		if (!file->stream_ || file->size_ > UINT32_MAX)
+		{
+			return FMOD_ERR_FILE_BAD;
+		}
+
+		uintptr_t priority = reinterpret_cast<uintptr_t>(userdata);
+		file->priority_ = (priority > 0 && priority <= (uintptr_t)AudioFilePriority::Count) ?
+			(AudioFilePriority)(priority - 1) : AudioFilePriority::Bank;
+		*size = (unsigned)file->size_;
+		*handle = file.release();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT AudioFileIO::Close(void* handle)
+	{
+		OpenFile* file = static_cast<OpenFile*>(handle);
+		std::vector<FMOD_ASYNCREADINFO*> dropped;
+		{
+			// Wait out the jobs being served, then drop the queued ones, which only read-aheads should be
+			std::unique_lock<std::mutex> lock(mutex_);
+			served_.wait(lock, [file]() { return file->busy_ == 0; });
+			auto kept = std::partition(queue_.begin(), queue_.end(),
+				[file](const ReadJob& job) { return job.file_ != file; });
+			for (auto it = kept; it != queue_.end(); ++it)
+			{
+				if (it->info_ != nullptr)
+				{
+					dropped.push_back(it->info_);
+				}
+			}
+			queue_.erase(kept, queue_.end());
+			std::make_heap(queue_.begin(), queue_.end());
+			stats_.cancelled_ += dropped.size();
+		}
+
+		for (FMOD_ASYNCREADINFO* info : dropped)
+		{
+			info->done(info, FMOD_ERR_FILE_DISKEJECTED);
+		}
+		delete file;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT AudioFileIO::Read(FMOD_ASYNCREADINFO* info)
+	{
+		OpenFile* file = static_cast<OpenFile*>(info->handle);
+		std::lock_guard<std::mutex> lock(mutex_);
+		ReadJob job;
+		job.info_ = info;
+		job.file_ = file;
+		job.offset_ = info->offset;
+		job.order_ = GetOrder(file->priority_, false, info->priority);
+		job.issued_ = std::chrono::steady_clock::now();
+		Push(job);
+		wake_.notify_one();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT AudioFileIO::Cancel(FMOD_ASYNCREADINFO* info)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto queued = std::find_if(queue_.begin(), queue_.end(),
+			[info](const ReadJob& job) { return job.info_ == info; });
+		if (queued != queue_.end())
+		{
+			queue_.erase(queued);
+			std::make_heap(queue_.begin(), queue_.end());
+			++stats_.cancelled_;
+			lock.unlock();
+			info->done(info, FMOD_ERR_FILE_DISKEJECTED);
+			return FMOD_OK;
+		}
+
+		// A read being served completes normally, FMOD only needs it finished before it returns
+		served_.wait(lock, [this, info]() { return std::find(serving_.begin(), serving_.end(), info) == serving_.end(); });
+		return FMOD_OK;
+	}
+
+	void AudioFileIO::RunThread()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		for (;;)
+		{
+			wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+			if (queue_.empty())
+			{
+				return;
+			}
+
+			std::pop_heap(queue_.begin(), queue_.end());
+			ReadJob job = queue_.back();
+			queue_.pop_back();
+			++job.file_->busy_;
+			if (job.info_ != nullptr)
+			{
+				serving_.push_back(job.info_);
+			}
+
+			lock.unlock();
+			if (job.info_ != nullptr)
+			{
+				Serve(job);
+			}
+			else
+			{
+				Prefetch(job);
+			}
+			lock.lock();
+
+			if (job.info_ == nullptr)
+			{
+				job.file_->aheadQueued_ = false;
+			}
+			--job.file_->busy_;
+			served_.notify_all();
+		}
+	}
+
+	void AudioFileIO::Push(const ReadJob& job)
+	{
+		queue_.push_back(job);
+		std::push_heap(queue_.begin(), queue_.end());
+		stats_.maxQueueDepth_ = std::max(stats_.maxQueueDepth_, queue_.size());
+	}
+
+	void AudioFileIO::Serve(const ReadJob& job)
+	{
+		FMOD_ASYNCREADINFO* info = job.info_;
+		OpenFile& file = *job.file_;
+		uint64_t offset = info->offset;
+		size_t bytes = info->sizebytes;
+		unsigned served = 0;
+		uint64_t diskBytes = 0;
+		bool hit = false;
+		bool failed = false;
+		bool queueAhead = false;
+		uint64_t aheadOffset = 0;
+		{
+			std::lock_guard<std::mutex> lock(file.mutex_);
+			ReadWindow* window = nullptr;
+			if (WindowHolds(file.current_.offset_, file.current_.size_, file.size_, offset, bytes))
+			{
+				window = &file.current_;
+				hit = true;
+			}
+			else if (WindowHolds(file.ahead_.offset_, file.ahead_.size_, file.size_, offset, bytes))
+			{
+				// The stream caught up with its read-ahead, which becomes the current window
+				std::swap(file.current_, file.ahead_);
+				file.ahead_.size_ = 0;
+				window = &file.current_;
+				hit = true;
+			}
+			else if (offset < file.size_)
+			{
+				failed = !Fill(file, file.current_, offset, std::max(bytes, settings_.readAheadBytes_));
+				diskBytes = file.current_.size_;
+				window = failed ? nullptr : &file.current_;
+				if (file.ahead_.offset_ != file.current_.offset_ + file.current_.size_)
+				{
+					file.ahead_.size_ = 0;
+				}
+			}
+
+			if (window != nullptr)
+			{
+				served = (unsigned)std::min<uint64_t>(bytes, window->offset_ + window->size_ - offset);
+				memcpy(info->buffer, window->bytes_.data() + (offset - window->offset_), served);
+			}
+
+			uint64_t windowEnd = file.current_.offset_ + file.current_.size_;
+			if (settings_.readAheadBytes_ > 0 && window != nullptr && windowEnd < file.size_ &&
+				(file.ahead_.size_ == 0 || file.ahead_.offset_ != windowEnd))
+			{
+				queueAhead = true;
+				aheadOffset = windowEnd;
+			}
+		}
+
+		// FMOD may reuse the read as soon as it is done, so nothing reads it past this point
+		info->bytesread = served;
+		info->done(info, failed ? FMOD_ERR_FILE_BAD : (served < bytes) ? FMOD_ERR_FILE_EOF : FMOD_OK);
+		float latency = std::chrono::duration<float>(std::chrono::steady_clock::now() - job.issued_).count();
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		serving_.erase(std::find(serving_.begin(), serving_.end(), info));
+		int priority = (int)file.priority_;
+		++stats_.reads_[priority];
+		++stats_.latency_[priority][GetLatencyBucket(latency)];
+		stats_.maxLatency_[priority] = std::max(stats_.maxLatency_[priority], latency);
+		stats_.readAheadHits_ += hit ? 1 : 0;
+		stats_.bytesRead_ += diskBytes;
+		stats_.bytesServed_ += served;
+		stats_.failed_ += failed ? 1 : 0;
+
+		if (queueAhead && !file.aheadQueued_)
+		{
+			ReadJob ahead;
+			ahead.info_ = nullptr;
+			ahead.file_ = &file;
+			ahead.offset_ = aheadOffset;
+			ahead.order_ = GetOrder(file.priority_, true, 0);
+			ahead.issued_ = std::chrono::steady_clock::now();
+			file.aheadQueued_ = true;
+			Push(ahead);
+			wake_.notify_one();
+		}
+	}
+
+	void AudioFileIO::Prefetch(const ReadJob& job)
+	{
+		OpenFile& file = *job.file_;
+		uint64_t diskBytes = 0;
+		{
+			// A seek since the read-ahead was queued leaves it pointless
+			std::lock_guard<std::mutex> lock(file.mutex_);
+			bool follows = (job.offset_ == file.current_.offset_ + file.current_.size_);
+			bool filled = (file.ahead_.size_ > 0 && file.ahead_.offset_ == job.offset_);
+			if (follows && !filled)
+			{
+				if (!Fill(file, file.ahead_, job.offset_, settings_.readAheadBytes_))
+				{
+					file.ahead_.size_ = 0;
+				}
+				diskBytes = file.ahead_.size_;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.bytesRead_ += diskBytes;
+	}
+
+	bool AudioFileIO::Fill(OpenFile& file, ReadWindow& window, uint64_t offset, size_t bytes)
+	{
+		size_t toRead = (size_t)std::min<uint64_t>(bytes, file.size_ - offset);
+		if (window.bytes_.size() < toRead)
+		{
+			window.bytes_.resize(toRead);
+		}
+
+		file.stream_.clear();
+		file.stream_.seekg((std::streamoff)offset);
+		file.stream_.read(window.bytes_.data(), (std::streamsize)toRead);
+		window.offset_ = offset;
+		window.size_ = (size_t)file.stream_.gcount();
+		return window.size_ == toRead;
+	}
+
+	uint64_t AudioFileIO::GetOrder(AudioFilePriority priority, bool prefetch, int fmodPriority)
+	{
+		// Class first, then reads before read-aheads, then the priority FMOD gave, then first issued
+		uint64_t order = (uint64_t)priority << 62;
+		order |= (uint64_t)(prefetch ? 0 : 1) << 61;
+		order |= (uint64_t)std::clamp(fmodPriority, 0, MAX_FMOD_PRIORITY) << 54;
+		order |= SEQUENCE_MASK - (sequence_++ & SEQUENCE_MASK);
+		return order;
+	}
+}
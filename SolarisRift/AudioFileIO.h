@@ -0,0 +1,202 @@
+/* ======================================================================== /
+/!
+\file AudioFileIO.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioFileIO class.
+This file contains the declaration of AudioFileIO, the file system FMOD
+reads through: a pool of I/O threads serving its asynchronous reads by
+priority, with a read-ahead window per file and latency histograms.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_FILE_IO_H
+#define AUDIO_FILE_IO_H
+
+#include <FMOD/fmod.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the priority class of an audio file, read in decreasing order.
+	 */
+	enum class AudioFilePriority
+	{
+		Sample, //!< A sound loaded into memory, usually a sound effect.
+		Bank,   //!< A studio bank, or any file opened without a priority.
+		Stream, //!< A streamed sound, usually music, which starves if its reads wait.
+		Count   //!< Number of priority classes.
+	};
+
+	/**
+	 * \brief Struct describing the I/O threads and the read-ahead of an AudioFileIO.
+	 */
+	struct AudioFileIOSettings
+	{
+		unsigned threads_ = 2; //!< Number of I/O threads, 0 to leave FMOD on its own blocking file I/O.
+		size_t readAheadBytes_ = 256 * 1024; //!< Bytes read past every read of a file, 0 to read only what is asked.
+	};
+
+	/**
+	 * \brief Struct reporting the reads served by an AudioFileIO since it started.
+	 *
+	 * Latency is the time from FMOD issuing a read to its completion. Bucket 0 counts reads under
+	 * LATENCY_BUCKET_BASE seconds, every following bucket doubles the limit, and the last bucket
+	 * counts every slower read.
+	 */
+	struct AudioFileIOStats
+	{
+		static constexpr unsigned LATENCY_BUCKETS = 16; //!< Number of buckets of the latency histograms.
+		static constexpr float LATENCY_BUCKET_BASE = 0.000064f; //!< Upper limit of the first bucket, in seconds.
+
+		uint64_t reads_[(int)AudioFilePriority::Count]; //!< Reads completed, per priority class.
+		uint64_t latency_[(int)AudioFilePriority::Count][LATENCY_BUCKETS]; //!< Latency histogram, per priority class.
+		float maxLatency_[(int)AudioFilePriority::Count]; //!< Slowest read, per priority class, in seconds.
+		uint64_t readAheadHits_; //!< Reads served entirely from a read-ahead window.
+		uint64_t bytesRead_; //!< Bytes read from disk, read-ahead included.
+		uint64_t bytesServed_; //!< Bytes handed to FMOD.
+		uint64_t cancelled_; //!< Reads FMOD cancelled before they were served.
+		uint64_t failed_; //!< Reads that hit an I/O error.
+		size_t queueDepth_; //!< Reads and read-aheads waiting for a thread.
+		size_t maxQueueDepth_; //!< Most reads and read-aheads ever waiting at once.
+
+		/**
+		 * \brief Gets the upper limit of a latency bucket.
+		 * \param bucket The bucket.
+		 * \return The limit in seconds, infinite for the last bucket.
+		 */
+		static float GetBucketLimit(unsigned bucket);
+	};
+
+	/**
+	 * \brief Class representing the file system FMOD reads through.
+	 *
+	 * Every read FMOD issues is queued and served by the I/O threads, streams first, then banks,
+	 * then samples, then by the priority FMOD gave the read. A read pulls the read-ahead size from
+	 * disk into a window of its file, and a read-ahead of the next window is queued behind the
+	 * reads of the same class, so a stream reading sequentially is served from memory while the
+	 * disk is busy elsewhere.
+	 */
+	class AudioFileIO
+	{
+	public:
+		/**
+		 * \brief Default constructor for AudioFileIO. No thread runs until Start.
+		 */
+		AudioFileIO();
+
+		/**
+		 * \brief Destructor for AudioFileIO, stops the threads.
+		 */
+		~AudioFileIO();
+
+		AudioFileIO(const AudioFileIO&) = delete;
+		AudioFileIO& operator=(const AudioFileIO&) = delete;
+
+		/**
+		 * \brief Starts the I/O threads and restarts the stats.
+		 * \param settings The threads and read-ahead.
+		 */
+		void Start(const AudioFileIOSettings& settings);
+
+		/**
+		 * \brief Stops the I/O threads. Every file must be closed first.
+		 */
+		void Stop();
+
+		/**
+		 * \brief Checks if the I/O threads are running.
+		 * \return True if the threads are running, false otherwise.
+		 */
+		bool IsRunning() const;
+
+		/**
+		 * \brief Gets the reads served since Start.
+		 * \return The stats of the reads.
+		 */
+		AudioFileIOStats GetStats() const;
+
+		/**
+		 * \brief Gets the user data to open a file with so it is read at a priority.
+		 * \param priority The priority class.
+		 * \return The value for FMOD_CREATESOUNDEXINFO::fileuserdata.
+		 */
+		static void* GetUserData(AudioFilePriority priority);
+
+		FMOD_RESULT Open(const char* name, unsigned* size, void** handle, void* userdata); //!< FMOD open callback.
+		FMOD_RESULT Close(void* handle); //!< FMOD close callback.
+		FMOD_RESULT Read(FMOD_ASYNCREADINFO* info); //!< FMOD asynchronous read callback, queues the read.
+		FMOD_RESULT Cancel(FMOD_ASYNCREADINFO* info); //!< FMOD cancel callback, returns once the read is dropped or done.
+
+	private:
+		/**
+		 * \brief A run of a file held in memory.
+		 */
+		struct ReadWindow
+		{
+			std::vector<char> bytes_; //!< The bytes, sized to the read-ahead.
+			uint64_t offset_ = 0; //!< Offset of the first byte in the file.
+			size_t size_ = 0; //!< Number of valid bytes.
+		};
+
+		/**
+		 * \brief A file opened by FMOD.
+		 */
+		struct OpenFile
+		{
+			std::ifstream stream_; //!< The file.
+			std::mutex mutex_; //!< Serializes the threads reading the file.
+			uint64_t size_ = 0; //!< Size of the file.
+			AudioFilePriority priority_ = AudioFilePriority::Bank; //!< Priority class of the reads.
+			ReadWindow current_; //!< Window of the last read.
+			ReadWindow ahead_; //!< Window following current_, filled by read-ahead.
+			unsigned busy_ = 0; //!< Jobs of the file being served, guarded by the mutex of the AudioFileIO.
+			bool aheadQueued_ = false; //!< Whether a read-ahead of the file is queued or running, guarded by the mutex of the AudioFileIO.
+		};
+
+		/**
+		 * \brief A read or a read-ahead waiting for a thread.
+		 */
+		struct ReadJob
+		{
+			FMOD_ASYNCREADINFO* info_; //!< The read, nullptr for a read-ahead.
+			OpenFile* file_; //!< The file.
+			uint64_t offset_; //!< Offset of a read-ahead.
+			uint64_t order_; //!< Sort key, larger first.
+			std::chrono::steady_clock::time_point issued_; //!< Time FMOD issued the read.
+
+			bool operator<(const ReadJob& other) const { return order_ < other.order_; } //!< Orders the heap of the queue.
+		};
+
+		AudioFileIOSettings settings_; //!< The threads and read-ahead.
+		std::vector<std::thread> threads_; //!< The I/O threads.
+		std::vector<ReadJob> queue_; //!< Jobs waiting for a thread, a heap on order_.
+		std::vector<FMOD_ASYNCREADINFO*> serving_; //!< Reads being served.
+		uint64_t sequence_; //!< Number of jobs queued, keeps jobs of equal priority in order.
+		bool stopping_; //!< Whether the threads were asked to exit.
+		AudioFileIOStats stats_; //!< Reads served since Start.
+		mutable std::mutex mutex_; //!< Guards the queue, the served reads and the stats.
+		std::condition_variable wake_; //!< Signaled when a job is queued or the threads must exit.
+		std::condition_variable served_; //!< Signaled when a job is done.
+
+		void RunThread(); //!< Loop of an I/O thread.
+		void Push(const ReadJob& job); //!< Queues a job, the mutex already locked.
+		void Serve(const ReadJob& job); //!< Serves a read, queuing the next read-ahead.
+		void Prefetch(const ReadJob& job); //!< Fills the read-ahead window of a file.
+		bool Fill(OpenFile& file, ReadWindow& window, uint64_t offset, size_t bytes); //!< Reads a window from disk, the file already locked.
+		uint64_t GetOrder(AudioFilePriority priority, bool prefetch, int fmodPriority); //!< Builds the sort key of a job, the mutex already locked.
+	};
+}
+
+#endif // AUDIO_FILE_IO_H
@@ -0,0 +1,207 @@
+/* ======================================================================== /
+/!
+\file AudioId.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioId type and the AudioIdTable container.
+This file contains the declaration of AudioId, a hashed identifier for FMOD
+studio paths such as "event:/..." and "bus:/...", and AudioIdTable, a sorted
+flat table keyed by AudioId. Identifiers built from string literals are hashed
+at compile time so that runtime lookups never touch a std::string.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_ID_H
+#define AUDIO_ID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DeckedOut
+{
+	static constexpr uint32_t AUDIO_ID_FNV_OFFSET = 2166136261u; //!< 32-bit FNV-1a offset basis.
+	static constexpr uint32_t AUDIO_ID_FNV_PRIME = 16777619u;   //!< 32-bit FNV-1a prime.
+
+	/**
+	 * \brief Hashes an audio path with 32-bit FNV-1a.
+	 * \param name The characters of the path.
+	 * \param length The number of characters to hash.
+	 * \return The hash of the path.
+	 */
+	constexpr uint32_t HashAudioName(const char* name, size_t length)
+	{
+		uint32_t hash = AUDIO_ID_FNV_OFFSET;
+		for (size_t i = 0; i < length; ++i)
+		{
+			hash ^= static_cast<uint8_t>(name[i]);
+			hash *= AUDIO_ID_FNV_PRIME;
+		}
+		return hash;
+	}
+
+	/**
+	 * \brief Hashed identifier of an FMOD studio path.
+	 *
+	 * Construct from a string literal to hash at compile time, e.g.
+	 * \code static constexpr AudioId BOSS_MUSIC("event:/MUSIC/BossMap/Boss Music"); \endcode
+	 * The std::string constructor hashes at runtime and is intended for tools and data-driven callers.
+	 */
+	class AudioId
+	{
+	public:
+		/**
+		 * \brief Constructs an invalid identifier.
+		 */
+		constexpr AudioId() : value_(0)
+		{
+		}
+
+		/**
+		 * \brief Constructs an identifier from a string literal at compile time.
+		 * \param name The FMOD studio path.
+		 */
+		template <size_t N>
+		constexpr explicit AudioId(const char (&name)[N]) : value_(HashAudioName(name, N - 1))
+		{
+		}
+
+		/**
+		 * \brief Constructs an identifier from a runtime string.
+		 * \param name The FMOD studio path.
+		 */
+		explicit AudioId(const std::string& name) : value_(HashAudioName(name.c_str(), name.size()))
+		{
+		}
+
+		/**
+		 * \brief Constructs an identifier from a range of characters.
+		 * \param name The characters of the FMOD studio path.
+		 * \param length The number of characters in the path.
+		 */
+		constexpr AudioId(const char* name, size_t length) : value_(HashAudioName(name, length))
+		{
+		}
+
+		/**
+		 * \brief Constructs an identifier from a hash computed earlier, e.g. by an offline cooker.
+		 * \param value The hash value.
+		 * \return The identifier.
+		 */
+		static constexpr AudioId FromValue(uint32_t value)
+		{
+			AudioId id;
+			id.value_ = value;
+			return id;
+		}
+
+		/**
+		 * \brief Gets the raw hash value.
+		 * \return The hash value.
+		 */
+		constexpr uint32_t Value() const
+		{
+			return value_;
+		}
+
+		constexpr bool operator==(AudioId other) const { return value_ == other.value_; }
+		constexpr bool operator!=(AudioId other) const { return value_ != other.value_; }
+		constexpr bool operator<(AudioId other) const { return value_ < other.value_; }
+
+	private:
+		uint32_t value_; //!< FNV-1a hash of the path.
+	};
+
+	/**
+	 * \brief Flat table of values sorted by AudioId.
+	 *
+	 * Entries are appended while loading and sorted once by Build(). Lookups are a binary
+	 * search over contiguous memory, so they neither allocate nor hash strings.
+	 */
+	template <typename T>
+	class AudioIdTable
+	{
+	public:
+		typedef std::pair<AudioId, T> Entry; //!< A single id/value pair.
+		typedef typename std::vector<Entry>::iterator iterator; //!< Iterator over entries.
+		typedef typename std::vector<Entry>::const_iterator const_iterator; //!< Const iterator over entries.
+
+		/**
+		 * \brief Appends an entry. The table must be rebuilt before the entry can be found.
+		 * \param id The identifier of the entry.
+		 * \param value The value of the entry.
+		 */
+		void Insert(AudioId id, const T& value)
+		{
+			entries_.emplace_back(id, value);
+		}
+
+		/**
+		 * \brief Sorts the table so that it can be searched.
+		 * \return False if two entries share an identifier, true otherwise.
+		 */
+		bool Build()
+		{
+			std::sort(entries_.begin(), entries_.end(),
+				[](const Entry& lhs, const Entry& rhs) { return lhs.first < rhs.first; });
+			auto duplicate = std::adjacent_find(entries_.begin(), entries_.end(),
+				[](const Entry& lhs, const Entry& rhs) { return lhs.first == rhs.first; });
+			return duplicate == entries_.end();
+		}
+
+		/**
+		 * \brief Finds the value associated with an identifier.
+		 * \param id The identifier to search for.
+		 * \return A pointer to the value, or nullptr if the identifier is unknown.
+		 */
+		T* Find(AudioId id)
+		{
+			auto it = std::lower_bound(entries_.begin(), entries_.end(), id,
+				[](const Entry& entry, AudioId key) { return entry.first < key; });
+			return (it != entries_.end() && it->first == id) ? &it->second : nullptr;
+		}
+
+		/**
+		 * \brief Finds the value associated with an identifier.
+		 * \param id The identifier to search for.
+		 * \return A pointer to the value, or nullptr if the identifier is unknown.
+		 */
+		const T* Find(AudioId id) const
+		{
+			auto it = std::lower_bound(entries_.begin(), entries_.end(), id,
+				[](const Entry& entry, AudioId key) { return entry.first < key; });
+			return (it != entries_.end() && it->first == id) ? &it->second : nullptr;
+		}
+
+		/**
+		 * \brief Finds the position of an identifier in the sorted table.
+		 * \param id The identifier to search for.
+		 * \return The position of the entry, or the size of the table if the identifier is unknown.
+		 */
+		size_t IndexOf(AudioId id) const
+		{
+			auto it = std::lower_bound(entries_.begin(), entries_.end(), id,
+				[](const Entry& entry, AudioId key) { return entry.first < key; });
+			return (it != entries_.end() && it->first == id) ? (size_t)(it - entries_.begin()) : entries_.size();
+		}
+
+		void Reserve(size_t count) { entries_.reserve(count); } //!< Reserves space for count entries.
+		void Clear() { entries_.clear(); } //!< Removes every entry.
+		size_t Size() const { return entries_.size(); } //!< Gets the number of entries.
+		iterator begin() { return entries_.begin(); } //!< Gets an iterator to the first entry.
+		iterator end() { return entries_.end(); } //!< Gets an iterator past the last entry.
+		const_iterator begin() const { return entries_.begin(); } //!< Gets an iterator to the first entry.
+		const_iterator end() const { return entries_.end(); } //!< Gets an iterator past the last entry.
+
+	private:
+		std::vector<Entry> entries_; //!< Entries sorted by identifier after Build().
+	};
+}
+
+#endif // AUDIO_ID_H
@@ -0,0 +1,298 @@
+/* ======================================================================== /
+/!
+\file AudioManifest.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioManifest class.
+This file contains the implementation of the AudioManifest class, including
+the GUIDs.txt parser used by the offline cooker and the text fallback, and
+the validation of cooked manifests.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <stdafx.h>
+#include <AudioManifest.h>
+
+namespace DeckedOut
+{
+	static const char MANIFEST_MAGIC[4] = { 'S', 'R', 'A', 'M' };
+	static constexpr uint32_t MANIFEST_VERSION = 1;
+	static const char* const KIND_PREFIXES[(int)AudioManifestKind::Count] = { "bank:/", "event:/", "bus:/" };
+	static constexpr size_t GUID_TEXT_LENGTH = 38; //! Length of "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}"
+
+	/**
+	 * \brief Gets the size and last write time of a file.
+	 * \param path The path of the file.
+	 * \param size Receives the size of the file.
+	 * \param time Receives the last write time of the file.
+	 * \return True if the file exists, false otherwise.
+	 */
+	static bool GetSourceStamp(const char* path, uint64_t& size, int64_t& time)
+	{
+		std::error_code error;
+		size = (uint64_t)std::filesystem::file_size(path, error);
+		if (error)
+		{
+			return false;
+		}
+		time = (int64_t)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+		return !error;
+	}
+
+	/**
+	 * \brief Converts a hexadecimal digit to its value.
+	 * \param digit The character to convert.
+	 * \return The value of the digit, or -1 if it is not hexadecimal.
+	 */
+	static int HexValue(char digit)
+	{
+		if (digit >= '0' && digit <= '9') return digit - '0';
+		if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+		if (digit >= 'A' && digit <= 'F') return digit - 'A' + 10;
+		return -1;
+	}
+
+	/**
+	 * \brief Parses a "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}" GUID in text order.
+	 * \param text The first character of the GUID.
+	 * \param guid Receives the 16 bytes of the GUID.
+	 * \return True if the GUID was well formed, false otherwise.
+	 */
+	static bool ParseGuid(const char* text, uint8_t* guid)
+	{
+		int byte = 0;
+		for (size_t i = 1; i + 1 < GUID_TEXT_LENGTH && byte < 16; ++i)
+		{
+			if (text[i] == '-')
+			{
+				continue;
+			}
+			int high = HexValue(text[i]);
+			int low = HexValue(text[i + 1]);
+			if (high < 0 || low < 0)
+			{
+				return false;
+			}
+			guid[byte++] = (uint8_t)((high << 4) | low);
+			++i;
+		}
+		return byte == 16;
+	}
+
+	AudioManifest::AudioManifest() :
+		entries_(nullptr),
+		strings_(nullptr),
+		counts_(),
+		entryCount_(0),
+		stringPoolSize_(0)
+	{
+	}
+
+	bool AudioManifest::LoadCooked(const char* cookedPath, const char* sourcePath)
+	{
+		Unload();
+		if (!file_.Open(cookedPath) || file_.Size() < sizeof(AudioManifestHeader))
+		{
+			Unload();
+			return false;
+		}
+
+		const AudioManifestHeader* header = reinterpret_cast<const AudioManifestHeader*>(file_.Data());
+		if (memcmp(header->magic_, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)) != 0 || header->version_ != MANIFEST_VERSION)
+		{
+			Unload();
+			return false;
+		}
+
+		// A shipped build may not carry GUIDs.txt at all, so only a source that changed makes the manifest stale
+		uint64_t sourceSize;
+		int64_t sourceTime;
+		if (GetSourceStamp(sourcePath, sourceSize, sourceTime) &&
+			(sourceSize != header->sourceSize_ || sourceTime != header->sourceTime_))
+		{
+			Unload();
+			return false;
+		}
+
+		size_t entryCount = 0;
+		for (int kind = 0; kind < (int)AudioManifestKind::Count; ++kind)
+		{
+			entryCount += header->counts_[kind];
+		}
+		size_t expectedSize = sizeof(AudioManifestHeader) + entryCount * sizeof(AudioManifestEntry) + header->stringPoolSize_;
+		if (file_.Size() != expectedSize)
+		{
+			Unload();
+			return false;
+		}
+
+		entries_ = reinterpret_cast<const AudioManifestEntry*>(file_.Data() + sizeof(AudioManifestHeader));
+		strings_ = reinterpret_cast<const char*>(entries_ + entryCount);
+		entryCount_ = entryCount;
+		stringPoolSize_ = header->stringPoolSize_;
+		for (int kind = 0; kind < (int)AudioManifestKind::Count; ++kind)
+		{
+			counts_[kind] = header->counts_[kind];
+		}
+
+		// Every path must be a terminated string inside the pool, and every entry in its kind's range
+		for (int kind = 0; kind < (int)AudioManifestKind::Count; ++kind)
+		{
+			const AudioManifestEntry* entry = Begin((AudioManifestKind)kind);
+			for (size_t i = 0; i < counts_[kind]; ++i, ++entry)
+			{
+				size_t nameEnd = (size_t)entry->nameOffset_ + entry->nameLength_;
+				if (entry->kind_ != (uint32_t)kind || nameEnd >= stringPoolSize_ || strings_[nameEnd] != '\0')
+				{
+					Unload();
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool AudioManifest::LoadText(const char* sourcePath)
+	{
+		Unload();
+		std::ifstream sourceFile(sourcePath, std::ios::binary);
+		if (!sourceFile.is_open())
+		{
+			return false;
+		}
+		std::string text((std::istreambuf_iterator<char>(sourceFile)), std::istreambuf_iterator<char>());
+		sourceFile.close();
+
+		// One entry per line at most, so a single reservation covers every entry and path
+		ownedEntries_.reserve((size_t)std::count(text.begin(), text.end(), '\n') + 1);
+		ownedStrings_.reserve(text.size());
+
+		const char* cursor = text.data();
+		const char* end = text.data() + text.size();
+		while (cursor < end)
+		{
+			const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', (size_t)(end - cursor)));
+			if (lineEnd == nullptr)
+			{
+				lineEnd = end;
+			}
+			const char* nameEnd = (lineEnd > cursor && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+
+			// Skip the unique identifier, advance to the named portion
+			const char* name = cursor + GUID_TEXT_LENGTH + 1;
+			AudioManifestEntry entry = {};
+			if (name < nameEnd && cursor[0] == '{' && cursor[GUID_TEXT_LENGTH - 1] == '}' && ParseGuid(cursor, entry.guid_))
+			{
+				size_t nameLength = (size_t)(nameEnd - name);
+				for (int kind = 0; kind < (int)AudioManifestKind::Count; ++kind)
+				{
+					size_t prefixLength = strlen(KIND_PREFIXES[kind]);
+					if (nameLength >= prefixLength && strncmp(name, KIND_PREFIXES[kind], prefixLength) == 0)
+					{
+						entry.hash_ = AudioId(name, nameLength).Value();
+						entry.kind_ = (uint32_t)kind;
+						entry.nameOffset_ = (uint32_t)ownedStrings_.size();
+						entry.nameLength_ = (uint32_t)nameLength;
+						ownedStrings_.insert(ownedStrings_.end(), name, nameEnd);
+						ownedStrings_.push_back('\0');
+						ownedEntries_.push_back(entry);
+						++counts_[kind];
+						break;
+					}
+				}
+			}
+			cursor = lineEnd + 1;
+		}
+
+		std::sort(ownedEntries_.begin(), ownedEntries_.end(),
+			[](const AudioManifestEntry& lhs, const AudioManifestEntry& rhs)
+			{
+				return (lhs.kind_ != rhs.kind_) ? lhs.kind_ < rhs.kind_ : lhs.hash_ < rhs.hash_;
+			});
+
+		entries_ = ownedEntries_.data();
+		strings_ = ownedStrings_.data();
+		entryCount_ = ownedEntries_.size();
+		stringPoolSize_ = ownedStrings_.size();
+		return true;
+	}
+
+	bool AudioManifest::Write(const char* cookedPath, const char* sourcePath) const
+	{
+		AudioManifestHeader header = {};
+		memcpy(header.magic_, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC));
+		header.version_ = MANIFEST_VERSION;
+		if (!GetSourceStamp(sourcePath, header.sourceSize_, header.sourceTime_))
+		{
+			return false;
+		}
+		for (int kind = 0; kind < (int)AudioManifestKind::Count; ++kind)
+		{
+			header.counts_[kind] = (uint32_t)counts_[kind];
+		}
+		header.stringPoolSize_ = (uint32_t)stringPoolSize_;
+
+		std::ofstream cookedFile(cookedPath, std::ios::binary | std::ios::trunc);
+		if (!cookedFile.is_open())
+		{
+			return false;
+		}
+		cookedFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		cookedFile.write(reinterpret_cast<const char*>(entries_), (std::streamsize)(entryCount_ * sizeof(AudioManifestEntry)));
+		cookedFile.write(strings_, (std::streamsize)stringPoolSize_);
+		return cookedFile.good();
+	}
+
+	bool AudioManifest::Cook(const char* sourcePath, const char* cookedPath)
+	{
+		AudioManifest manifest;
+		return manifest.LoadText(sourcePath) && manifest.Write(cookedPath, sourcePath);
+	}
+
+	void AudioManifest::Unload()
+	{
+		file_.Close();
+		std::vector<AudioManifestEntry>().swap(ownedEntries_);
+		std::vector<char>().swap(ownedStrings_);
+		entries_ = nullptr;
+		strings_ = nullptr;
+		entryCount_ = 0;
+		stringPoolSize_ = 0;
+		for (int kind = 0; kind < (int)AudioManifestKind::Count; ++kind)
+		{
+			counts_[kind] = 0;
+		}
+	}
+
+	const AudioManifestEntry* AudioManifest::Begin(AudioManifestKind kind) const
+	{
+		size_t first = 0;
+		for (int i = 0; i < (int)kind; ++i)
+		{
+			first += counts_[i];
+		}
+		return entries_ + first;
+	}
+
+	size_t AudioManifest::Count(AudioManifestKind kind) const
+	{
+		return counts_[(int)kind];
+	}
+
+	const char* AudioManifest::GetName(const AudioManifestEntry& entry) const
+	{
+		return strings_ + entry.nameOffset_;
+	}
+
+	AudioId AudioManifest::GetId(const AudioManifestEntry& entry)
+	{
+		return AudioId::FromValue(entry.hash_);
+	}
+}
@@ -0,0 +1,154 @@
+/* ======================================================================== /
+/!
+\file AudioManifest.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioManifest class.
+This file contains the declaration of the AudioManifest class, which lists
+the banks, events and buses of the FMOD studio project. The manifest is either
+parsed from the GUIDs.txt file exported by FMOD Studio or memory mapped from
+a binary file cooked offline from it.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_MANIFEST_H
+#define AUDIO_MANIFEST_H
+
+#include <cstdint>
+#include <vector>
+#include <AudioId.h>
+#include <MappedFile.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the kinds of studio objects listed in a manifest.
+	 */
+	enum class AudioManifestKind : uint32_t
+	{
+		Bank,  //!< A bank, named by its "bank:/" path.
+		Event, //!< An event, named by its "event:/" path.
+		Bus,   //!< A bus, named by its "bus:/" path.
+		Count  //!< Number of kinds.
+	};
+
+	/**
+	 * \brief Struct representing one studio object in a manifest.
+	 */
+	struct AudioManifestEntry
+	{
+		uint32_t hash_; //!< AudioId of the path.
+		uint32_t kind_; //!< AudioManifestKind of the object.
+		uint32_t nameOffset_; //!< Offset of the null-terminated path in the string pool.
+		uint32_t nameLength_; //!< Length of the path, excluding the terminator.
+		uint8_t guid_[16]; //!< GUID of the object.
+	};
+
+	/**
+	 * \brief Struct representing the header of a cooked manifest file.
+	 *
+	 * The header is followed by the entries, sorted by kind and then by hash, and by the string pool.
+	 */
+	struct AudioManifestHeader
+	{
+		char magic_[4]; //!< Always "SRAM".
+		uint32_t version_; //!< Version of the format.
+		uint64_t sourceSize_; //!< Size of the GUIDs.txt the manifest was cooked from.
+		int64_t sourceTime_; //!< Last write time of the GUIDs.txt the manifest was cooked from.
+		uint32_t counts_[(int)AudioManifestKind::Count]; //!< Number of entries of each kind.
+		uint32_t stringPoolSize_; //!< Size of the string pool in bytes.
+	};
+
+	/**
+	 * \brief Class representing the list of studio objects to load.
+	 */
+	class AudioManifest
+	{
+	public:
+		/**
+		 * \brief Default constructor for AudioManifest.
+		 */
+		AudioManifest();
+
+		/**
+		 * \brief Maps a cooked manifest.
+		 * \param cookedPath The path of the cooked manifest.
+		 * \param sourcePath The path of the GUIDs.txt it was cooked from. If that file exists and
+		 * differs from the one the manifest was cooked from, the manifest is treated as stale.
+		 * \return True if the manifest was mapped, false if it is missing, invalid or stale.
+		 */
+		bool LoadCooked(const char* cookedPath, const char* sourcePath);
+
+		/**
+		 * \brief Parses a GUIDs.txt file exported by FMOD Studio.
+		 * \param sourcePath The path of the GUIDs.txt file.
+		 * \return True if the file was parsed, false if it could not be opened.
+		 */
+		bool LoadText(const char* sourcePath);
+
+		/**
+		 * \brief Writes the manifest as a cooked file.
+		 * \param cookedPath The path of the cooked manifest to write.
+		 * \param sourcePath The path of the GUIDs.txt the manifest was loaded from.
+		 * \return True if the file was written, false otherwise.
+		 */
+		bool Write(const char* cookedPath, const char* sourcePath) const;
+
+		/**
+		 * \brief Cooks a GUIDs.txt file into a binary manifest.
+		 * \param sourcePath The path of the GUIDs.txt file.
+		 * \param cookedPath The path of the cooked manifest to write.
+		 * \return True if the manifest was cooked, false otherwise.
+		 */
+		static bool Cook(const char* sourcePath, const char* cookedPath);
+
+		/**
+		 * \brief Releases the entries and strings of the manifest.
+		 */
+		void Unload();
+
+		/**
+		 * \brief Gets the entries of one kind, sorted by hash.
+		 * \param kind The kind of entries.
+		 * \return A pointer to the first entry of that kind.
+		 */
+		const AudioManifestEntry* Begin(AudioManifestKind kind) const;
+
+		/**
+		 * \brief Gets the number of entries of one kind.
+		 * \param kind The kind of entries.
+		 * \return The number of entries.
+		 */
+		size_t Count(AudioManifestKind kind) const;
+
+		/**
+		 * \brief Gets the path of an entry.
+		 * \param entry The entry.
+		 * \return The null-terminated path, owned by the manifest.
+		 */
+		const char* GetName(const AudioManifestEntry& entry) const;
+
+		/**
+		 * \brief Gets the identifier of an entry.
+		 * \param entry The entry.
+		 * \return The identifier of the entry's path.
+		 */
+		static AudioId GetId(const AudioManifestEntry& entry);
+
+	private:
+		const AudioManifestEntry* entries_; //!< Entries sorted by kind and hash.
+		const char* strings_; //!< String pool holding every path.
+		size_t counts_[(int)AudioManifestKind::Count]; //!< Number of entries of each kind.
+		size_t entryCount_; //!< Total number of entries.
+		size_t stringPoolSize_; //!< Size of the string pool in bytes.
+		MappedFile file_; //!< Mapping of a cooked manifest.
+		std::vector<AudioManifestEntry> ownedEntries_; //!< Entries parsed from text.
+		std::vector<char> ownedStrings_; //!< String pool parsed from text.
+	};
+}
+
+#endif // AUDIO_MANIFEST_H
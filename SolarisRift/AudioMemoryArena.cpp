@@ -0,0 +1,326 @@
+/* ======================================================================== /
+/!
+\file AudioMemoryArena.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioMemoryArena class.
+This file contains the implementation of the pools and of the free run list
+of the arena FMOD allocates from.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cstring>
+#include <stdafx.h>
+#include <AudioMemoryArena.h>
+
+namespace DeckedOut
+{
+	static constexpr size_t POOL_BLOCK_SIZES[] = { 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048 }; //! Block sizes of the pools, header included
+	static constexpr uint16_t LARGE_CLASS = 0xFFFF; //! Class of the blocks taken from the free runs
+	static constexpr uint16_t BLOCK_LIVE = 0xA0D1; //! Guard of an allocated block
+	static constexpr uint16_t BLOCK_FREE = 0xF4EE; //! Guard of a block back in its pool
+	static constexpr size_t MIN_RUN_SIZE = 64; //! Smallest run split off a free run, smaller remainders stay with the block
+
+	/**
+	 * \brief Rounds a size up to the alignment of the arena.
+	 * \param bytes The size.
+	 * \return The rounded size.
+	 */
+	static size_t AlignSize(size_t bytes)
+	{
+		return (bytes + AudioMemoryArena::ALIGNMENT - 1) & ~(AudioMemoryArena::ALIGNMENT - 1);
+	}
+
+	AudioMemoryArena::AudioMemoryArena(size_t bytes) :
+		memory_(new uint8_t[bytes + ALIGNMENT]),
+		begin_(nullptr),
+		end_(nullptr),
+		freeRuns_(nullptr),
+		poolFree_(),
+		stats_(),
+		mutex_()
+	{
+		static_assert(sizeof(POOL_BLOCK_SIZES) / sizeof(POOL_BLOCK_SIZES[0]) == POOL_CLASS_COUNT, "A pool is needed for every size class");
+		static_assert(sizeof(BlockHeader) == ALIGNMENT, "Blocks must stay aligned after their header");
+
+		begin_ = memory_.get() + (ALIGNMENT - reinterpret_cast<uintptr_t>(memory_.get()) % ALIGNMENT) % ALIGNMENT;
+		end_ = begin_ + (bytes & ~(ALIGNMENT - 1));
+		stats_.arenaBytes_ = end_ - begin_;
+		if (stats_.arenaBytes_ >= MIN_RUN_SIZE)
+		{
+			ReleaseRun(begin_, stats_.arenaBytes_);
+		}
+	}
+
+	void* AudioMemoryArena::Allocate(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return AllocateLocked(bytes);
+	}
+
+	void* AudioMemoryArena::Reallocate(void* pointer, size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (pointer == nullptr)
+		{
+			return AllocateLocked(bytes);
+		}
+		BlockHeader* header = GetHeader(pointer);
+		if (header == nullptr)
+		{
+			++stats_.invalidFrees_;
+			return nullptr;
+		}
+		if (bytes == 0)
+		{
+			FreeLocked(header);
+			return nullptr;
+		}
+
+		++stats_.frameReallocations_;
+		if (bytes <= header->size_ - sizeof(BlockHeader))
+		{
+			stats_.usedBytes_ = stats_.usedBytes_ - header->requested_ + bytes;
+			stats_.peakUsedBytes_ = std::max(stats_.peakUsedBytes_, stats_.usedBytes_);
+			header->requested_ = (uint32_t)bytes;
+			return pointer;
+		}
+
+		void* moved = AllocateLocked(bytes);
+		if (moved != nullptr)
+		{
+			memcpy(moved, pointer, header->requested_);
+			FreeLocked(header);
+		}
+		return moved;
+	}
+
+	void AudioMemoryArena::Free(void* pointer)
+	{
+		if (pointer == nullptr)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		BlockHeader* header = GetHeader(pointer);
+		if (header == nullptr)
+		{
+			++stats_.invalidFrees_;
+			return;
+		}
+		FreeLocked(header);
+	}
+
+	AudioMemoryStats AudioMemoryArena::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return CollectStats();
+	}
+
+	AudioMemoryStats AudioMemoryArena::EndFrame()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		AudioMemoryStats stats = CollectStats();
+		stats_.frameAllocations_ = 0;
+		stats_.frameReallocations_ = 0;
+		stats_.frameFrees_ = 0;
+		return stats;
+	}
+
+	void AudioMemoryArena::ResetPeaks()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.peakUsedBytes_ = stats_.usedBytes_;
+		stats_.peakCommittedBytes_ = stats_.committedBytes_;
+	}
+
+	void* AudioMemoryArena::AllocateLocked(size_t bytes)
+	{
+		// FMOD sizes fit in 32 bits, a larger request can only be a wrapped size
+		if (bytes > UINT32_MAX)
+		{
+			++stats_.failedAllocations_;
+			return nullptr;
+		}
+
+		size_t blockSize = AlignSize(sizeof(BlockHeader) + std::max<size_t>(bytes, 1));
+		unsigned sizeClass = 0;
+		while (sizeClass < POOL_CLASS_COUNT && POOL_BLOCK_SIZES[sizeClass] < blockSize)
+		{
+			++sizeClass;
+		}
+
+		BlockHeader* header = nullptr;
+		if (sizeClass < POOL_CLASS_COUNT && (poolFree_[sizeClass] != nullptr || RefillPool(sizeClass)))
+		{
+			header = static_cast<BlockHeader*>(poolFree_[sizeClass]);
+			memcpy(&poolFree_[sizeClass], header + 1, sizeof(void*));
+			stats_.pooledFreeBytes_ -= header->size_;
+		}
+		else
+		{
+			// A pool that cannot get a page falls back on the free runs, which may still fit one block
+			size_t taken = 0;
+			header = reinterpret_cast<BlockHeader*>(TakeRun(blockSize, &taken));
+			if (header == nullptr)
+			{
+				++stats_.failedAllocations_;
+				return nullptr;
+			}
+			header->size_ = taken;
+			header->class_ = LARGE_CLASS;
+		}
+
+		header->requested_ = (uint32_t)bytes;
+		header->guard_ = BLOCK_LIVE;
+		stats_.usedBytes_ += bytes;
+		stats_.peakUsedBytes_ = std::max(stats_.peakUsedBytes_, stats_.usedBytes_);
+		++stats_.liveAllocations_;
+		++stats_.frameAllocations_;
+		return header + 1;
+	}
+
+	void AudioMemoryArena::FreeLocked(BlockHeader* header)
+	{
+		stats_.usedBytes_ -= header->requested_;
+		--stats_.liveAllocations_;
+		++stats_.frameFrees_;
+		header->guard_ = BLOCK_FREE;
+
+		if (header->class_ == LARGE_CLASS)
+		{
+			ReleaseRun(reinterpret_cast<uint8_t*>(header), (size_t)header->size_);
+			return;
+		}
+
+		// Pool pages are kept once carved, the blocks go back to the free list of their class
+		memcpy(header + 1, &poolFree_[header->class_], sizeof(void*));
+		poolFree_[header->class_] = header;
+		stats_.pooledFreeBytes_ += header->size_;
+	}
+
+	uint8_t* AudioMemoryArena::TakeRun(size_t bytes, size_t* taken)
+	{
+		FreeRun** link = &freeRuns_;
+		while (*link != nullptr && (*link)->size_ < bytes)
+		{
+			link = &(*link)->next_;
+		}
+		FreeRun* run = *link;
+		if (run == nullptr)
+		{
+			return nullptr;
+		}
+
+		if (run->size_ - bytes >= MIN_RUN_SIZE)
+		{
+			FreeRun* rest = reinterpret_cast<FreeRun*>(reinterpret_cast<uint8_t*>(run) + bytes);
+			rest->size_ = run->size_ - bytes;
+			rest->next_ = run->next_;
+			*link = rest;
+		}
+		else
+		{
+			bytes = run->size_;
+			*link = run->next_;
+		}
+
+		*taken = bytes;
+		stats_.committedBytes_ += bytes;
+		stats_.peakCommittedBytes_ = std::max(stats_.peakCommittedBytes_, stats_.committedBytes_);
+		return reinterpret_cast<uint8_t*>(run);
+	}
+
+	void AudioMemoryArena::ReleaseRun(uint8_t* start, size_t bytes)
+	{
+		FreeRun* previous = nullptr;
+		FreeRun* next = freeRuns_;
+		while (next != nullptr && reinterpret_cast<uint8_t*>(next) < start)
+		{
+			previous = next;
+			next = next->next_;
+		}
+
+		FreeRun* run = reinterpret_cast<FreeRun*>(start);
+		run->size_ = bytes;
+		run->next_ = next;
+		if (next != nullptr && start + bytes == reinterpret_cast<uint8_t*>(next))
+		{
+			run->size_ += next->size_;
+			run->next_ = next->next_;
+		}
+		if (previous != nullptr && reinterpret_cast<uint8_t*>(previous) + previous->size_ == start)
+		{
+			previous->size_ += run->size_;
+			previous->next_ = run->next_;
+		}
+		else if (previous != nullptr)
+		{
+			previous->next_ = run;
+		}
+		else
+		{
+			freeRuns_ = run;
+		}
+
+		// The first run is made by the constructor, before anything was committed
+		stats_.committedBytes_ -= std::min(stats_.committedBytes_, bytes);
+	}
+
+	bool AudioMemoryArena::RefillPool(unsigned sizeClass)
+	{
+		size_t taken = 0;
+		uint8_t* page = TakeRun(POOL_PAGE_SIZE, &taken);
+		if (page == nullptr)
+		{
+			return false;
+		}
+
+		// Link the blocks in address order so a fresh pool hands them out front to back
+		size_t blockSize = POOL_BLOCK_SIZES[sizeClass];
+		size_t count = taken / blockSize;
+		for (size_t i = count; i > 0; --i)
+		{
+			BlockHeader* header = reinterpret_cast<BlockHeader*>(page + (i - 1) * blockSize);
+			header->size_ = blockSize;
+			header->requested_ = 0;
+			header->class_ = (uint16_t)sizeClass;
+			header->guard_ = BLOCK_FREE;
+			memcpy(header + 1, &poolFree_[sizeClass], sizeof(void*));
+			poolFree_[sizeClass] = header;
+		}
+		stats_.pooledFreeBytes_ += count * blockSize;
+		return true;
+	}
+
+	AudioMemoryArena::BlockHeader* AudioMemoryArena::GetHeader(void* pointer) const
+	{
+		uint8_t* bytes = static_cast<uint8_t*>(pointer);
+		if (bytes < begin_ + sizeof(BlockHeader) || bytes >= end_ || (bytes - begin_) % ALIGNMENT != 0)
+		{
+			return nullptr;
+		}
+		BlockHeader* header = reinterpret_cast<BlockHeader*>(bytes) - 1;
+		return (header->guard_ == BLOCK_LIVE) ? header : nullptr;
+	}
+
+	AudioMemoryStats AudioMemoryArena::CollectStats() const
+	{
+		AudioMemoryStats stats = stats_;
+		stats.freeBytes_ = 0;
+		stats.largestFreeBytes_ = 0;
+		for (const FreeRun* run = freeRuns_; run != nullptr; run = run->next_)
+		{
+			stats.freeBytes_ += run->size_;
+			stats.largestFreeBytes_ = std::max(stats.largestFreeBytes_, run->size_);
+		}
+		stats.fragmentation_ = (stats.freeBytes_ > 0) ?
+			1.0f - (float)stats.largestFreeBytes_ / (float)stats.freeBytes_ : 0.0f;
+		return stats;
+	}
+}
@@ -0,0 +1,153 @@
+/* ======================================================================== /
+/!
+\file AudioMemoryArena.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioMemoryArena class.
+This file contains the declaration of AudioMemoryArena, a fixed block of
+memory FMOD allocates from instead of the game heap, with pools for small
+sizes and the bookkeeping to budget it and find leaks.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_MEMORY_ARENA_H
+#define AUDIO_MEMORY_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Struct reporting the use of an AudioMemoryArena.
+	 */
+	struct AudioMemoryStats
+	{
+		size_t arenaBytes_; //!< Size of the arena.
+		size_t usedBytes_; //!< Bytes requested by the live allocations.
+		size_t peakUsedBytes_; //!< Most bytes requested at once, the high-water mark of the budget.
+		size_t committedBytes_; //!< Bytes of the arena given to blocks and to pool pages, including headers and rounding.
+		size_t peakCommittedBytes_; //!< Most bytes committed at once, the size the arena actually needs.
+		size_t pooledFreeBytes_; //!< Bytes of free blocks held by the pools, committed but unused.
+		size_t freeBytes_; //!< Bytes of the arena not committed.
+		size_t largestFreeBytes_; //!< Largest contiguous run of uncommitted bytes.
+		float fragmentation_; //!< Share of the free bytes outside the largest run, 0 when they are all contiguous.
+		size_t liveAllocations_; //!< Allocations not freed yet.
+		unsigned frameAllocations_; //!< Allocations made since the last EndFrame.
+		unsigned frameReallocations_; //!< Reallocations made since the last EndFrame.
+		unsigned frameFrees_; //!< Frees made since the last EndFrame.
+		unsigned failedAllocations_; //!< Allocations refused because the arena was full.
+		unsigned invalidFrees_; //!< Frees of pointers the arena did not hand out or already took back.
+	};
+
+	/**
+	 * \brief Class representing a fixed arena of memory with size-class pools.
+	 *
+	 * Requests up to the largest size class are served from pools, each carving pages of the arena
+	 * into blocks of one size, so the many small and short lived allocations of the mixer neither
+	 * search nor split the arena. Larger requests are served first-fit from a list of free runs
+	 * sorted by address, merged with their neighbours when freed. Every block starts with a header
+	 * recording its size and class, so FMOD never has to pass sizes back. The arena locks a mutex
+	 * on every call, since FMOD allocates from its mixer, stream and loading threads.
+	 */
+	class AudioMemoryArena
+	{
+	public:
+		static constexpr size_t ALIGNMENT = 16; //!< Alignment of every allocation, the alignment FMOD expects.
+		static constexpr size_t POOL_PAGE_SIZE = 64 * 1024; //!< Bytes taken from the arena when a pool runs dry.
+
+		/**
+		 * \brief Constructor for AudioMemoryArena. The memory is allocated once, here.
+		 * \param bytes The size of the arena.
+		 */
+		explicit AudioMemoryArena(size_t bytes);
+
+		AudioMemoryArena(const AudioMemoryArena&) = delete;
+		AudioMemoryArena& operator=(const AudioMemoryArena&) = delete;
+
+		/**
+		 * \brief Allocates a block.
+		 * \param bytes The size of the block.
+		 * \return The block, aligned to ALIGNMENT, or nullptr if the arena is full.
+		 */
+		void* Allocate(size_t bytes);
+
+		/**
+		 * \brief Resizes a block, in place when it is already large enough.
+		 * \param pointer The block, nullptr to allocate a new one.
+		 * \param bytes The new size of the block, 0 to free it.
+		 * \return The resized block, or nullptr if the arena is full, in which case the block is left untouched.
+		 */
+		void* Reallocate(void* pointer, size_t bytes);
+
+		/**
+		 * \brief Frees a block.
+		 * \param pointer The block, nullptr is ignored.
+		 */
+		void Free(void* pointer);
+
+		/**
+		 * \brief Gets the use of the arena.
+		 * \return The use of the arena, with the counts of the current frame.
+		 */
+		AudioMemoryStats GetStats() const;
+
+		/**
+		 * \brief Ends a frame, restarting the per-frame counts.
+		 * \return The use of the arena, with the counts of the frame that ended.
+		 */
+		AudioMemoryStats EndFrame();
+
+		/**
+		 * \brief Restarts the high-water marks from the current use, to measure a level on its own.
+		 */
+		void ResetPeaks();
+
+	private:
+		static constexpr unsigned POOL_CLASS_COUNT = 13; //!< Number of size classes served by pools.
+
+		/**
+		 * \brief The header in front of every block.
+		 */
+		struct BlockHeader
+		{
+			uint64_t size_; //!< Size of the block, header included.
+			uint32_t requested_; //!< Bytes requested for the block.
+			uint16_t class_; //!< Size class of the block, LARGE_CLASS for a block of the free runs.
+			uint16_t guard_; //!< BLOCK_LIVE while the block is allocated.
+		};
+
+		/**
+		 * \brief A run of free bytes, stored in the run itself.
+		 */
+		struct FreeRun
+		{
+			size_t size_; //!< Size of the run.
+			FreeRun* next_; //!< Next run, at a higher address.
+		};
+
+		std::unique_ptr<uint8_t[]> memory_; //!< The allocation holding the arena.
+		uint8_t* begin_; //!< First byte of the arena, aligned.
+		uint8_t* end_; //!< Byte past the arena.
+		FreeRun* freeRuns_; //!< Free runs, sorted by address.
+		void* poolFree_[POOL_CLASS_COUNT]; //!< Free blocks of every size class, linked through their first bytes.
+		AudioMemoryStats stats_; //!< Use of the arena, without the fields computed by GetStats.
+		mutable std::mutex mutex_; //!< Serializes the threads of FMOD.
+
+		void* AllocateLocked(size_t bytes); //!< Allocate, the mutex already locked.
+		void FreeLocked(BlockHeader* header); //!< Free, the mutex already locked.
+		uint8_t* TakeRun(size_t bytes, size_t* taken); //!< Commits the first free run large enough, splitting it.
+		void ReleaseRun(uint8_t* start, size_t bytes); //!< Returns a run to the free list, merging its neighbours.
+		bool RefillPool(unsigned sizeClass); //!< Carves a new page into blocks of a size class.
+		BlockHeader* GetHeader(void* pointer) const; //!< Gets the header of a live block, nullptr for any other pointer.
+		AudioMemoryStats CollectStats() const; //!< Completes stats_ with the free run fields, the mutex already locked.
+	};
+}
+
+#endif // AUDIO_MEMORY_ARENA_H
@@ -0,0 +1,148 @@
+/* ======================================================================== /
+/!
+\file AudioMixSnapshots.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the MixSnapshotTable class.
+This file contains the implementation of the snapshot storage and of the
+crossfade between the current mix and a snapshot.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <stdafx.h>
+#include <AudioMixSnapshots.h>
+
+namespace DeckedOut
+{
+	MixSnapshotTable::MixSnapshotTable() :
+		names_(),
+		count_(0),
+		busCount_(0),
+		volumes_(),
+		paused_(),
+		fadeSource_(),
+		fadeVolumes_(),
+		fadeTarget_(INVALID_SNAPSHOT),
+		fadeLength_(0.0f),
+		fadeElapsed_(0.0f),
+		fadeDone_(false)
+	{
+	}
+
+	void MixSnapshotTable::Reset(size_t busCount)
+	{
+		count_ = 0;
+		busCount_ = busCount;
+		volumes_.assign(CAPACITY * busCount, 1.0f);
+		paused_.assign(CAPACITY * busCount, 0);
+		fadeSource_.assign(busCount, 1.0f);
+		fadeVolumes_.assign(busCount, 1.0f);
+		fadeTarget_ = INVALID_SNAPSHOT;
+		fadeDone_ = false;
+	}
+
+	unsigned MixSnapshotTable::Find(AudioId name) const
+	{
+		for (unsigned i = 0; i < count_; ++i)
+		{
+			if (names_[i] == name)
+			{
+				return i;
+			}
+		}
+		return INVALID_SNAPSHOT;
+	}
+
+	unsigned MixSnapshotTable::Acquire(AudioId name)
+	{
+		unsigned snapshot = Find(name);
+		if (snapshot != INVALID_SNAPSHOT || count_ == CAPACITY)
+		{
+			return snapshot;
+		}
+
+		snapshot = count_++;
+		names_[snapshot] = name;
+		std::fill_n(GetVolumes(snapshot), busCount_, 1.0f);
+		std::fill_n(GetPaused(snapshot), busCount_, (uint8_t)0);
+		return snapshot;
+	}
+
+	size_t MixSnapshotTable::GetBusCount() const
+	{
+		return busCount_;
+	}
+
+	float* MixSnapshotTable::GetVolumes(unsigned snapshot)
+	{
+		return volumes_.data() + snapshot * busCount_;
+	}
+
+	const float* MixSnapshotTable::GetVolumes(unsigned snapshot) const
+	{
+		return volumes_.data() + snapshot * busCount_;
+	}
+
+	uint8_t* MixSnapshotTable::GetPaused(unsigned snapshot)
+	{
+		return paused_.data() + snapshot * busCount_;
+	}
+
+	const uint8_t* MixSnapshotTable::GetPaused(unsigned snapshot) const
+	{
+		return paused_.data() + snapshot * busCount_;
+	}
+
+	float* MixSnapshotTable::GetFadeSource()
+	{
+		return fadeSource_.data();
+	}
+
+	void MixSnapshotTable::StartFade(unsigned snapshot, float seconds)
+	{
+		fadeTarget_ = snapshot;
+		fadeLength_ = seconds;
+		fadeElapsed_ = 0.0f;
+		fadeDone_ = false;
+	}
+
+	void MixSnapshotTable::StopFade()
+	{
+		fadeTarget_ = INVALID_SNAPSHOT;
+		fadeDone_ = false;
+	}
+
+	bool MixSnapshotTable::IsFading() const
+	{
+		return fadeTarget_ != INVALID_SNAPSHOT && !fadeDone_;
+	}
+
+	unsigned MixSnapshotTable::GetFadeTarget() const
+	{
+		return fadeTarget_;
+	}
+
+	const float* MixSnapshotTable::Advance(float dt)
+	{
+		if (!IsFading())
+		{
+			fadeTarget_ = INVALID_SNAPSHOT;
+			return nullptr;
+		}
+
+		fadeElapsed_ += dt;
+		float t = std::min(fadeElapsed_ / fadeLength_, 1.0f);
+		const float* target = GetVolumes(fadeTarget_);
+		for (size_t i = 0; i < busCount_; ++i)
+		{
+			fadeVolumes_[i] = fadeSource_[i] + (target[i] - fadeSource_[i]) * t;
+		}
+		fadeDone_ = (t >= 1.0f);
+		return fadeVolumes_.data();
+	}
+}
@@ -0,0 +1,132 @@
+/* ======================================================================== /
+/!
+\file AudioMixSnapshots.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the MixSnapshotTable class.
+This file contains the declaration of MixSnapshotTable, the named volume
+and pause states of every studio bus, and the crossfade between the
+current mix and one of them.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_MIX_SNAPSHOTS_H
+#define AUDIO_MIX_SNAPSHOTS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <AudioId.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Class representing the mix snapshots of the studio buses.
+	 *
+	 * Buses are addressed by their position in the sorted bus table. Every snapshot is a row of a
+	 * flat array holding one volume and one pause state per bus. The storage of every snapshot and
+	 * of the crossfade is allocated by Reset, so capturing, restoring and fading never allocate.
+	 */
+	class MixSnapshotTable
+	{
+	public:
+		static constexpr unsigned CAPACITY = 16; //!< Number of snapshots that can be named.
+		static constexpr unsigned INVALID_SNAPSHOT = ~0u; //!< Index of an unknown snapshot.
+
+		/**
+		 * \brief Default constructor for MixSnapshotTable. The table holds no bus until Reset.
+		 */
+		MixSnapshotTable();
+
+		/**
+		 * \brief Sizes the table for a number of buses, dropping every snapshot.
+		 * \param busCount The number of buses.
+		 */
+		void Reset(size_t busCount);
+
+		/**
+		 * \brief Finds a snapshot by name.
+		 * \param name The name of the snapshot.
+		 * \return The index of the snapshot, INVALID_SNAPSHOT if no snapshot has that name.
+		 */
+		unsigned Find(AudioId name) const;
+
+		/**
+		 * \brief Finds a snapshot by name, naming a new one if needed. A new snapshot starts with
+		 * every bus at full volume and playing.
+		 * \param name The name of the snapshot.
+		 * \return The index of the snapshot, INVALID_SNAPSHOT if every snapshot is in use.
+		 */
+		unsigned Acquire(AudioId name);
+
+		/**
+		 * \brief Gets the number of buses of every snapshot.
+		 * \return The number of buses.
+		 */
+		size_t GetBusCount() const;
+
+		float* GetVolumes(unsigned snapshot); //!< Gets the bus volumes of a snapshot.
+		const float* GetVolumes(unsigned snapshot) const; //!< Gets the bus volumes of a snapshot.
+		uint8_t* GetPaused(unsigned snapshot); //!< Gets the bus pause states of a snapshot, not zero for paused.
+		const uint8_t* GetPaused(unsigned snapshot) const; //!< Gets the bus pause states of a snapshot, not zero for paused.
+
+		/**
+		 * \brief Gets the volumes a crossfade starts from, to be filled before StartFade.
+		 * \return The bus volumes.
+		 */
+		float* GetFadeSource();
+
+		/**
+		 * \brief Starts a crossfade from the fade source to a snapshot, replacing any crossfade in progress.
+		 * \param snapshot The index of the snapshot reached at the end.
+		 * \param seconds The duration of the crossfade, more than zero.
+		 */
+		void StartFade(unsigned snapshot, float seconds);
+
+		/**
+		 * \brief Stops the crossfade in progress where it is.
+		 */
+		void StopFade();
+
+		/**
+		 * \brief Checks if a crossfade is in progress.
+		 * \return True while a crossfade is in progress, false otherwise.
+		 */
+		bool IsFading() const;
+
+		/**
+		 * \brief Gets the snapshot the crossfade in progress is reaching.
+		 * \return The index of the snapshot, INVALID_SNAPSHOT if no crossfade is in progress.
+		 */
+		unsigned GetFadeTarget() const;
+
+		/**
+		 * \brief Advances the crossfade and computes the volumes of every bus at the new time. The
+		 * crossfade is over once it has reached its snapshot, GetFadeTarget still names the snapshot
+		 * until the next Advance.
+		 * \param dt The time elapsed since the last advance.
+		 * \return The bus volumes, nullptr if no crossfade is in progress.
+		 */
+		const float* Advance(float dt);
+
+	private:
+		std::array<AudioId, CAPACITY> names_; //!< Name of every snapshot in use.
+		unsigned count_; //!< Number of snapshots in use.
+		size_t busCount_; //!< Number of buses of every snapshot.
+		std::vector<float> volumes_; //!< Bus volumes, one row of busCount_ per snapshot.
+		std::vector<uint8_t> paused_; //!< Bus pause states, one row of busCount_ per snapshot.
+		std::vector<float> fadeSource_; //!< Bus volumes when the crossfade started.
+		std::vector<float> fadeVolumes_; //!< Bus volumes computed by the last Advance.
+		unsigned fadeTarget_; //!< Snapshot reached by the crossfade, INVALID_SNAPSHOT if none.
+		float fadeLength_; //!< Duration of the crossfade.
+		float fadeElapsed_; //!< Time advanced since the crossfade started.
+		bool fadeDone_; //!< Whether the last Advance reached the snapshot.
+	};
+}
+
+#endif // AUDIO_MIX_SNAPSHOTS_H
@@ -0,0 +1,279 @@
+/* ======================================================================== /
+/!
+\file AudioPack.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioPack class.
+This file contains the implementation of the pack builder, of the checks
+made when a pack is mapped and of the lookup of its files.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <stdafx.h>
+#include <AudioPack.h>
+
+namespace DeckedOut
+{
+	static const char PACK_MAGIC[4] = { 'S', 'R', 'A', 'P' };
+	static constexpr uint32_t PACK_VERSION = 1;
+
+	/**
+	 * \brief Extension of a sound file and its codec.
+	 */
+	struct PackExtension
+	{
+		const char* extension_; //!< The lowercase extension, with its dot.
+		AudioPackCodec codec_; //!< The codec of files with that extension.
+	};
+
+	static const PackExtension PACK_EXTENSIONS[] =
+	{
+		{ ".wav",  AudioPackCodec::Wav },
+		{ ".ogg",  AudioPackCodec::Vorbis },
+		{ ".mp3",  AudioPackCodec::Mpeg },
+		{ ".flac", AudioPackCodec::Flac },
+		{ ".fsb",  AudioPackCodec::FSB }
+	};
+
+	/**
+	 * \brief A file found by Build, before it is written.
+	 */
+	struct PackSource
+	{
+		AudioPackEntry entry_; //!< The entry written to the pack.
+		std::filesystem::path path_; //!< The path to read the file from.
+	};
+
+	AudioPack::AudioPack() :
+		file_(),
+		entries_(nullptr),
+		strings_(nullptr),
+		entryCount_(0)
+	{
+	}
+
+	bool AudioPack::Open(const char* path)
+	{
+		Close();
+		if (!file_.Open(path) || file_.Size() < sizeof(AudioPackHeader))
+		{
+			Close();
+			return false;
+		}
+
+		const AudioPackHeader* header = reinterpret_cast<const AudioPackHeader*>(file_.Data());
+		if (memcmp(header->magic_, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header->version_ != PACK_VERSION)
+		{
+			Close();
+			return false;
+		}
+
+		size_t tableSize = sizeof(AudioPackHeader) + (size_t)header->entryCount_ * sizeof(AudioPackEntry) + header->stringPoolSize_;
+		if (file_.Size() < tableSize)
+		{
+			Close();
+			return false;
+		}
+		entries_ = reinterpret_cast<const AudioPackEntry*>(file_.Data() + sizeof(AudioPackHeader));
+		strings_ = reinterpret_cast<const char*>(entries_ + header->entryCount_);
+		entryCount_ = header->entryCount_;
+
+		// Every name must be a terminated string inside the pool, and every file inside the pack
+		for (size_t i = 0; i < entryCount_; ++i)
+		{
+			const AudioPackEntry& entry = entries_[i];
+			size_t nameEnd = (size_t)entry.nameOffset_ + entry.nameLength_;
+			if (nameEnd >= header->stringPoolSize_ || strings_[nameEnd] != '\0' ||
+				entry.offset_ < tableSize || entry.offset_ > file_.Size() || entry.size_ > file_.Size() - entry.offset_)
+			{
+				Close();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AudioPack::Close()
+	{
+		file_.Close();
+		entries_ = nullptr;
+		strings_ = nullptr;
+		entryCount_ = 0;
+	}
+
+	bool AudioPack::IsOpen() const
+	{
+		return file_.IsOpen();
+	}
+
+	const AudioPackEntry* AudioPack::Find(const std::string& name) const
+	{
+		uint32_t hash = AudioId(name).Value();
+		const AudioPackEntry* end = entries_ + entryCount_;
+		const AudioPackEntry* entry = std::lower_bound(entries_, end, hash,
+			[](const AudioPackEntry& lhs, uint32_t key) { return lhs.hash_ < key; });
+
+		// A name that only shares the hash of a packed file is loaded from its loose file
+		if (entry == end || entry->hash_ != hash || entry->nameLength_ != name.size() ||
+			memcmp(strings_ + entry->nameOffset_, name.data(), name.size()) != 0)
+		{
+			return nullptr;
+		}
+		return entry;
+	}
+
+	const uint8_t* AudioPack::GetData(const AudioPackEntry& entry) const
+	{
+		return file_.Data() + entry.offset_;
+	}
+
+	size_t AudioPack::Count() const
+	{
+		return entryCount_;
+	}
+
+	bool AudioPack::Build(const char* directory, const char* packPath, uint32_t alignment)
+	{
+		if (alignment > MAX_ALIGNMENT)
+		{
+			return false;
+		}
+		uint32_t powerOfTwo = 1;
+		while (powerOfTwo < alignment)
+		{
+			powerOfTwo <<= 1;
+		}
+		alignment = powerOfTwo;
+
+		std::error_code error;
+		std::filesystem::path root(directory);
+		std::string prefix = root.generic_string();
+		if (!prefix.empty() && prefix.back() != '/')
+		{
+			prefix += '/';
+		}
+
+		std::vector<PackSource> sources;
+		std::vector<char> strings;
+		for (std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+		{
+			if (!it->is_regular_file())
+			{
+				continue;
+			}
+			std::string name = prefix + std::filesystem::relative(it->path(), root).generic_string();
+			AudioPackCodec codec = GetCodec(name);
+			if (codec == AudioPackCodec::Unknown)
+			{
+				continue;
+			}
+
+			PackSource source = {};
+			source.path_ = it->path();
+			source.entry_.hash_ = AudioId(name).Value();
+			source.entry_.codec_ = (uint32_t)codec;
+			source.entry_.nameOffset_ = (uint32_t)strings.size();
+			source.entry_.nameLength_ = (uint32_t)name.size();
+			source.entry_.size_ = (uint64_t)it->file_size();
+			strings.insert(strings.end(), name.begin(), name.end());
+			strings.push_back('\0');
+			sources.push_back(source);
+		}
+		if (error)
+		{
+			return false;
+		}
+
+		std::sort(sources.begin(), sources.end(),
+			[](const PackSource& lhs, const PackSource& rhs) { return lhs.entry_.hash_ < rhs.entry_.hash_; });
+		auto duplicate = std::adjacent_find(sources.begin(), sources.end(),
+			[](const PackSource& lhs, const PackSource& rhs) { return lhs.entry_.hash_ == rhs.entry_.hash_; });
+		if (duplicate != sources.end())
+		{
+			return false;
+		}
+
+		// Lay the files out after the tables, each on its own aligned offset
+		uint64_t offset = sizeof(AudioPackHeader) + sources.size() * sizeof(AudioPackEntry) + strings.size();
+		for (PackSource& source : sources)
+		{
+			offset = (offset + alignment - 1) & ~(uint64_t)(alignment - 1);
+			source.entry_.offset_ = offset;
+			offset += source.entry_.size_;
+		}
+
+		AudioPackHeader header = {};
+		memcpy(header.magic_, PACK_MAGIC, sizeof(PACK_MAGIC));
+		header.version_ = PACK_VERSION;
+		header.alignment_ = alignment;
+		header.entryCount_ = (uint32_t)sources.size();
+		header.stringPoolSize_ = (uint32_t)strings.size();
+
+		std::ofstream packFile(packPath, std::ios::binary | std::ios::trunc);
+		if (!packFile.is_open())
+		{
+			return false;
+		}
+		packFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const PackSource& source : sources)
+		{
+			packFile.write(reinterpret_cast<const char*>(&source.entry_), sizeof(AudioPackEntry));
+		}
+		packFile.write(strings.data(), (std::streamsize)strings.size());
+
+		std::vector<char> buffer(MAX_ALIGNMENT);
+		for (const PackSource& source : sources)
+		{
+			// Pad up to the offset laid out above, the padding is always shorter than the buffer
+			std::fill(buffer.begin(), buffer.end(), '\0');
+			uint64_t padding = source.entry_.offset_ - (uint64_t)packFile.tellp();
+			packFile.write(buffer.data(), (std::streamsize)padding);
+
+			std::ifstream sourceFile(source.path_, std::ios::binary);
+			uint64_t remaining = source.entry_.size_;
+			while (sourceFile && remaining > 0)
+			{
+				std::streamsize chunk = (std::streamsize)std::min<uint64_t>(remaining, buffer.size());
+				sourceFile.read(buffer.data(), chunk);
+				packFile.write(buffer.data(), sourceFile.gcount());
+				remaining -= (uint64_t)sourceFile.gcount();
+			}
+			if (remaining > 0)
+			{
+				return false;
+			}
+		}
+		return packFile.good();
+	}
+
+	AudioPackCodec AudioPack::GetCodec(const std::string& name)
+	{
+		size_t dot = name.find_last_of('.');
+		if (dot == std::string::npos)
+		{
+			return AudioPackCodec::Unknown;
+		}
+		std::string extension = name.substr(dot);
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+			[](char c) { return (char)std::tolower((unsigned char)c); });
+
+		for (const PackExtension& known : PACK_EXTENSIONS)
+		{
+			if (extension == known.extension_)
+			{
+				return known.codec_;
+			}
+		}
+		return AudioPackCodec::Unknown;
+	}
+}
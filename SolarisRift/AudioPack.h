@@ -0,0 +1,148 @@
+/* ======================================================================== /
+/!
+\file AudioPack.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioPack class.
+This file contains the declaration of AudioPack, an archive of loose sound
+files that is memory mapped once, so sounds are opened from the mapping
+instead of through one open and several reads per file.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_PACK_H
+#define AUDIO_PACK_H
+
+#include <cstdint>
+#include <string>
+#include <AudioId.h>
+#include <MappedFile.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the encodings of the files of a pack.
+	 */
+	enum class AudioPackCodec : uint32_t
+	{
+		Unknown, //!< Left for FMOD to detect.
+		Wav,     //!< A RIFF WAVE file.
+		Vorbis,  //!< An Ogg Vorbis file.
+		Mpeg,    //!< An MP3 file.
+		Flac,    //!< A FLAC file.
+		FSB      //!< An FMOD sound bank.
+	};
+
+	/**
+	 * \brief Struct representing one file in a pack.
+	 */
+	struct AudioPackEntry
+	{
+		uint32_t hash_; //!< AudioId of the name the file is loaded by.
+		uint32_t codec_; //!< AudioPackCodec of the file.
+		uint32_t nameOffset_; //!< Offset of the null-terminated name in the string pool.
+		uint32_t nameLength_; //!< Length of the name, excluding the terminator.
+		uint64_t offset_; //!< Offset of the file in the pack, a multiple of the alignment.
+		uint64_t size_; //!< Size of the file in bytes.
+	};
+
+	/**
+	 * \brief Struct representing the header of a pack.
+	 *
+	 * The header is followed by the entries, sorted by hash, by the string pool, and by the files,
+	 * each starting on a multiple of the alignment so the page holding it is never shared.
+	 */
+	struct AudioPackHeader
+	{
+		char magic_[4]; //!< Always "SRAP".
+		uint32_t version_; //!< Version of the format.
+		uint32_t alignment_; //!< Alignment of the files, a power of two.
+		uint32_t entryCount_; //!< Number of files.
+		uint32_t stringPoolSize_; //!< Size of the string pool in bytes.
+		uint32_t reserved_; //!< Always 0, pads the header to 8 bytes.
+	};
+
+	/**
+	 * \brief Class representing a mapped pack of sound files.
+	 */
+	class AudioPack
+	{
+	public:
+		static constexpr uint32_t DEFAULT_ALIGNMENT = 4096; //!< Alignment of the files, the page size of the desktop platforms.
+		static constexpr uint32_t MAX_ALIGNMENT = 1u << 16; //!< Largest alignment Build accepts.
+
+		/**
+		 * \brief Default constructor for AudioPack.
+		 */
+		AudioPack();
+
+		/**
+		 * \brief Maps a pack, closing any pack mapped before.
+		 * \param path The path of the pack.
+		 * \return True if the pack was mapped, false if it is missing or invalid.
+		 */
+		bool Open(const char* path);
+
+		/**
+		 * \brief Unmaps the pack. Sounds opened from it must be released first.
+		 */
+		void Close();
+
+		/**
+		 * \brief Checks if a pack is mapped.
+		 * \return True if a pack is mapped, false otherwise.
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * \brief Finds a file by the name it is loaded by.
+		 * \param name The name of the file, as given to AudioSystem::LoadSound.
+		 * \return The entry of the file, or nullptr if the pack does not hold it.
+		 */
+		const AudioPackEntry* Find(const std::string& name) const;
+
+		/**
+		 * \brief Gets the bytes of a file, valid until the pack is closed.
+		 * \param entry The entry of the file.
+		 * \return A pointer to the first byte of the file.
+		 */
+		const uint8_t* GetData(const AudioPackEntry& entry) const;
+
+		/**
+		 * \brief Gets the number of files in the pack.
+		 * \return The number of files.
+		 */
+		size_t Count() const;
+
+		/**
+		 * \brief Builds a pack from every sound file of a directory and its subdirectories. Each file
+		 * is named by the directory path followed by its relative path, with forward slashes, which
+		 * is the name the game loads it by.
+		 * \param directory The directory to pack.
+		 * \param packPath The path of the pack to write.
+		 * \param alignment The alignment of the files, rounded up to a power of two, at most MAX_ALIGNMENT.
+		 * \return True if the pack was written, false if the alignment is too large, a file could not
+		 * be read, two names share a hash or the pack could not be written.
+		 */
+		static bool Build(const char* directory, const char* packPath, uint32_t alignment = DEFAULT_ALIGNMENT);
+
+		/**
+		 * \brief Gets the encoding of a file from its extension.
+		 * \param name The name of the file.
+		 * \return The codec, Unknown for an extension that is not a sound.
+		 */
+		static AudioPackCodec GetCodec(const std::string& name);
+
+	private:
+		MappedFile file_; //!< The mapping of the pack.
+		const AudioPackEntry* entries_; //!< The entries, sorted by hash.
+		const char* strings_; //!< The string pool.
+		size_t entryCount_; //!< Number of entries.
+	};
+}
+
+#endif // AUDIO_PACK_H
@@ -0,0 +1,121 @@
+/* ======================================================================== /
+/!
+\file AudioPitch.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the pitch ratio tables.
+This file contains the constexpr tables converting a pitch offset in cents
+into the playback rate ratio FMOD expects, so playing a sound at a pitch
+neither calls pow nor reads the frequency of its channel.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_PITCH_H
+#define AUDIO_PITCH_H
+
+#include <array>
+
+namespace DeckedOut
+{
+	static constexpr int CENTS_PER_SEMITONE = 100; //! Cents in a 12-tone semitone
+	static constexpr int CENTS_PER_OCTAVE = 1200; //! Cents in an octave
+	static constexpr int MAX_PITCH_OCTAVES = 4; //! Octaves a pitch can be shifted by in either direction
+	static constexpr int MAX_PITCH_CENTS = MAX_PITCH_OCTAVES * CENTS_PER_OCTAVE; //! Largest pitch offset, larger offsets are clamped
+	static constexpr double PITCH_LN2 = 0.69314718055994530942; //! Natural logarithm of 2
+
+	/**
+	 * \brief Computes 2 raised to a fraction of an octave, at compile time.
+	 * \param octaves The exponent, between 0 and 1.
+	 * \return The ratio, accurate to a double for exponents in that range.
+	 */
+	constexpr double PitchExp2(double octaves)
+	{
+		// The Taylor series of e^x converges well below the precision of a double for x < ln 2
+		double x = octaves * PITCH_LN2;
+		double term = 1.0;
+		double sum = 1.0;
+		for (int n = 1; n < 24; ++n)
+		{
+			term *= x / n;
+			sum += term;
+		}
+		return sum;
+	}
+
+	/**
+	 * \brief Builds the ratio of every step of a subdivision of an octave.
+	 * \tparam Steps The number of steps in the table.
+	 * \param stepsPerOctave The number of steps in an octave.
+	 * \return The ratios of steps 0 to Steps - 1.
+	 */
+	template <int Steps>
+	constexpr std::array<double, Steps> MakePitchRatios(int stepsPerOctave)
+	{
+		std::array<double, Steps> ratios = {};
+		for (int i = 0; i < Steps; ++i)
+		{
+			ratios[i] = PitchExp2((double)i / stepsPerOctave);
+		}
+		return ratios;
+	}
+
+	/**
+	 * \brief Builds the ratio of every whole octave from -MAX_PITCH_OCTAVES to MAX_PITCH_OCTAVES.
+	 * \return The ratios, indexed by the octave plus MAX_PITCH_OCTAVES.
+	 */
+	constexpr std::array<double, 2 * MAX_PITCH_OCTAVES + 1> MakeOctaveRatios()
+	{
+		std::array<double, 2 * MAX_PITCH_OCTAVES + 1> ratios = {};
+		double ratio = 1.0;
+		for (int i = 0; i < MAX_PITCH_OCTAVES; ++i)
+		{
+			ratio *= 2.0;
+		}
+		for (int i = 0; i < 2 * MAX_PITCH_OCTAVES + 1; ++i)
+		{
+			ratios[i] = 1.0 / ratio;
+			ratio *= 0.5;
+		}
+		return ratios;
+	}
+
+	static constexpr std::array<double, CENTS_PER_SEMITONE> CENT_RATIOS = MakePitchRatios<CENTS_PER_SEMITONE>(CENTS_PER_OCTAVE); //! Ratio of 0 to 99 cents
+	static constexpr std::array<double, 12> SEMITONE_RATIOS = MakePitchRatios<12>(12); //! Ratio of 0 to 11 semitones
+	static constexpr std::array<double, 2 * MAX_PITCH_OCTAVES + 1> OCTAVE_RATIOS = MakeOctaveRatios(); //! Ratio of -4 to 4 octaves
+
+	/**
+	 * \brief Converts a pitch offset into a playback rate ratio.
+	 * \param cents The pitch offset in cents, clamped to MAX_PITCH_CENTS in either direction.
+	 * \return The ratio, 1 for no offset.
+	 */
+	constexpr float CentsToPitchRatio(int cents)
+	{
+		cents = (cents < -MAX_PITCH_CENTS) ? -MAX_PITCH_CENTS : (cents > MAX_PITCH_CENTS) ? MAX_PITCH_CENTS : cents;
+		int shifted = cents + MAX_PITCH_CENTS;
+		int octave = shifted / CENTS_PER_OCTAVE;
+		int inOctave = shifted % CENTS_PER_OCTAVE;
+		return (float)(OCTAVE_RATIOS[octave] * SEMITONE_RATIOS[inOctave / CENTS_PER_SEMITONE] *
+			CENT_RATIOS[inOctave % CENTS_PER_SEMITONE]);
+	}
+
+	/**
+	 * \brief Rounds a pitch offset in semitones to the nearest cent.
+	 * \param semitones The pitch offset in semitones.
+	 * \return The pitch offset in cents.
+	 */
+	constexpr int SemitonesToCents(float semitones)
+	{
+		float cents = semitones * CENTS_PER_SEMITONE;
+		return (int)(cents + ((cents < 0.0f) ? -0.5f : 0.5f));
+	}
+
+	static_assert(CentsToPitchRatio(0) == 1.0f, "No offset must keep the pitch");
+	static_assert(CentsToPitchRatio(CENTS_PER_OCTAVE) == 2.0f, "An octave must double the pitch");
+	static_assert(CentsToPitchRatio(-CENTS_PER_OCTAVE) == 0.5f, "An octave down must halve the pitch");
+}
+
+#endif // AUDIO_PITCH_H
@@ -0,0 +1,215 @@
+/* ======================================================================== /
+/!
+\file AudioRender.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the offline audio render.
+This file contains the implementation of the script parser of
+AudioRenderScript and the block loop of RenderAudioOffline.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdafx.h>
+#include <Logger.h>
+#include <AudioRender.h>
+#include <AudioSystem.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief The spelling of a command in a script file and the arguments it takes.
+	 */
+	struct ScriptCommand
+	{
+		const char* name_; //!< The word starting the command.
+		AudioCommandType type_; //!< The command issued.
+		bool target_; //!< Whether an event or bus path follows.
+		bool parameter_; //!< Whether a parameter name follows the target.
+		bool value_; //!< Whether a value ends the line, the priority of a play.
+	};
+
+	static const ScriptCommand SCRIPT_COMMANDS[] =
+	{
+		{ "play",      AudioCommandType::PlayEvent,           true,  false, true  },
+		{ "stop",      AudioCommandType::StopEvent,           true,  false, false },
+		{ "parameter", AudioCommandType::SetEventParameter,   true,  true,  true  },
+		{ "busvolume", AudioCommandType::SetBusVolume,        true,  false, true  },
+		{ "buspaused", AudioCommandType::SetBusPaused,        true,  false, true  },
+		{ "stopall",   AudioCommandType::StopAllEvents,       false, false, false },
+		{ "mute",      AudioCommandType::MuteAllBuses,        false, false, false },
+		{ "unmute",    AudioCommandType::UnmuteAllBuses,      false, false, false },
+		{ "capture",   AudioCommandType::CaptureMixSnapshot,  true,  false, false },
+		{ "snapshot",  AudioCommandType::ApplyMixSnapshot,    true,  false, true  }
+	};
+
+	/**
+	 * \brief Parses a cue from a line of a script file.
+	 * \param line The line, without comments.
+	 * \param cue Receives the cue.
+	 * \return True if the line holds a cue, false if it is malformed.
+	 */
+	static bool ParseCue(const std::string& line, AudioRenderCue& cue)
+	{
+		std::istringstream stream(line);
+		std::string name;
+		if (!(stream >> cue.time_ >> name))
+		{
+			return false;
+		}
+
+		auto found = std::find_if(std::begin(SCRIPT_COMMANDS), std::end(SCRIPT_COMMANDS),
+			[&name](const ScriptCommand& command) { return name == command.name_; });
+		if (found == std::end(SCRIPT_COMMANDS))
+		{
+			return false;
+		}
+
+		cue.command_ = AudioCommand();
+		cue.command_.type_ = found->type_;
+		std::string argument;
+		if (found->target_)
+		{
+			if (!(stream >> std::quoted(argument)))
+			{
+				return false;
+			}
+			cue.command_.target_ = AudioId(argument);
+		}
+		if (found->parameter_)
+		{
+			if (!(stream >> std::quoted(argument)))
+			{
+				return false;
+			}
+			cue.command_.parameter_ = AudioId(argument);
+		}
+		if (found->value_)
+		{
+			float value;
+			if (!(stream >> value))
+			{
+				return false;
+			}
+			if (found->type_ == AudioCommandType::PlayEvent)
+			{
+				cue.command_.priority_ = (int)value;
+			}
+			else
+			{
+				cue.command_.value_ = value;
+			}
+		}
+
+		// Anything left on the line is a typo rather than something to ignore
+		return !(stream >> argument);
+	}
+
+	void AudioRenderScript::Add(float time, const AudioCommand& command)
+	{
+		// Insert after every cue at the same time, so equal times keep the order they were added in
+		auto position = std::upper_bound(cues_.begin(), cues_.end(), time,
+			[](float cueTime, const AudioRenderCue& cue) { return cueTime < cue.time_; });
+		cues_.insert(position, AudioRenderCue{ time, command });
+	}
+
+	bool AudioRenderScript::Load(const std::string& path)
+	{
+		std::ifstream file(path);
+		if (!file.is_open())
+		{
+			LogWarning("Could not open the audio render script '", path, "'.");
+			return false;
+		}
+
+		std::string line;
+		unsigned lineNumber = 0;
+		while (std::getline(file, line))
+		{
+			++lineNumber;
+			size_t first = line.find_first_not_of(" \t\r");
+			if (first == std::string::npos || line[first] == '#')
+			{
+				continue;
+			}
+
+			AudioRenderCue cue;
+			if (!ParseCue(line, cue))
+			{
+				LogWarning("Malformed cue on line ", lineNumber, " of the audio render script '", path, "'.");
+				return false;
+			}
+			Add(cue.time_, cue.command_);
+		}
+		return true;
+	}
+
+	const std::vector<AudioRenderCue>& AudioRenderScript::GetCues() const
+	{
+		return cues_;
+	}
+
+	float AudioRenderScript::GetLength() const
+	{
+		return cues_.empty() ? 0.0f : cues_.back().time_;
+	}
+
+	AudioRenderReport RenderAudioOffline(AudioSystem& audio, const AudioRenderScript& script, float seconds,
+		const std::string& timingsPath, AudioStatsFormat format)
+	{
+		AudioRenderReport report = {};
+		float blockLength = audio.GetMixBlockLength();
+		if (blockLength <= 0.0f || seconds <= 0.0f)
+		{
+			return report;
+		}
+		if (!audio.IsStudioReady())
+		{
+			LogWarning("The audio render started before the studio banks were resolved, its cues may be skipped.");
+		}
+
+		report.blocks_ = (uint64_t)std::ceil(seconds / blockLength);
+		audio.SetAudioStatsHistory((size_t)report.blocks_);
+
+		const std::vector<AudioRenderCue>& cues = script.GetCues();
+		size_t nextCue = 0;
+		auto renderStart = std::chrono::steady_clock::now();
+		for (uint64_t block = 0; block < report.blocks_; ++block)
+		{
+			// Times are derived from the block index, so rounding never drifts over long renders
+			double blockStart = (double)block * blockLength;
+			for (; nextCue < cues.size() && cues[nextCue].time_ <= blockStart; ++nextCue)
+			{
+				if (!audio.EnqueueCommand(cues[nextCue].command_))
+				{
+					++report.droppedCues_;
+				}
+			}
+
+			audio.Update(blockLength);
+			report.maxUpdateTime_ = std::max(report.maxUpdateTime_, audio.GetAudioStats().updateTime_);
+		}
+		report.renderSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - renderStart).count();
+		report.audioSeconds_ = (double)report.blocks_ * blockLength;
+		report.speedup_ = (report.renderSeconds_ > 0.0) ? report.audioSeconds_ / report.renderSeconds_ : 0.0;
+
+		if (report.droppedCues_ > 0)
+		{
+			LogWarning(report.droppedCues_, " cues of the audio render were dropped by a full command queue.");
+		}
+		if (!timingsPath.empty())
+		{
+			audio.WriteAudioStatsHistory(timingsPath, format);
+		}
+		return report;
+	}
+}
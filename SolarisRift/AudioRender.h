@@ -0,0 +1,122 @@
+/* ======================================================================== /
+/!
+\file AudioRender.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the offline audio render.
+This file contains the declaration of AudioRenderScript, a timeline of audio
+commands, and RenderAudioOffline, which plays a script through an audio
+system with a non-realtime output as fast as the machine allows. The WAV
+output and the per-block timings can then be compared against golden runs.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_RENDER_H
+#define AUDIO_RENDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <AudioCommandQueue.h>
+#include <AudioStats.h>
+
+namespace DeckedOut
+{
+	class AudioSystem;
+
+	/**
+	 * \brief Struct representing a command of a render script and when it is issued.
+	 */
+	struct AudioRenderCue
+	{
+		float time_; //!< Seconds into the render at which the command is issued.
+		AudioCommand command_; //!< The command.
+	};
+
+	/**
+	 * \brief Struct reporting how fast a script was rendered.
+	 */
+	struct AudioRenderReport
+	{
+		uint64_t blocks_; //!< Number of mixer blocks rendered, one per Update.
+		double audioSeconds_; //!< Duration of the audio rendered.
+		double renderSeconds_; //!< Wall time the render took.
+		double speedup_; //!< Audio seconds rendered per wall second.
+		float maxUpdateTime_; //!< Longest Update of the render, in seconds.
+		unsigned droppedCues_; //!< Cues rejected by a full command queue.
+	};
+
+	/**
+	 * \brief Class representing a timeline of audio commands, kept in the order they are issued.
+	 *
+	 * A script file has one cue per line, blank lines and lines starting with '#' are skipped.
+	 * Paths containing spaces are written in double quotes.
+	 * \code
+	 * 0.0 play event:/MUSIC/Level1 0
+	 * 1.5 parameter event:/MUSIC/Level1 Intensity 0.8
+	 * 2.0 busvolume bus:/SFX 0.5
+	 * 2.0 buspaused bus:/SFX 1
+	 * 4.0 stop "event:/MUSIC/BossMap/Boss Music"
+	 * 5.0 stopall
+	 * \endcode
+	 * mute and unmute take no argument, like stopall. "capture name" saves the mix into a snapshot and
+	 * "snapshot name seconds" crossfades to it.
+	 */
+	class AudioRenderScript
+	{
+	public:
+		/**
+		 * \brief Adds a cue. Cues at the same time are issued in the order they were added.
+		 * \param time Seconds into the render at which the command is issued.
+		 * \param command The command.
+		 */
+		void Add(float time, const AudioCommand& command);
+
+		/**
+		 * \brief Adds the cues of a script file.
+		 * \param path The path of the script file.
+		 * \return True if every line was read, false if the file could not be opened or a line is
+		 * malformed. The cues before the malformed line are kept.
+		 */
+		bool Load(const std::string& path);
+
+		/**
+		 * \brief Gets the cues, ordered by time.
+		 * \return The cues.
+		 */
+		const std::vector<AudioRenderCue>& GetCues() const;
+
+		/**
+		 * \brief Gets the time of the last cue.
+		 * \return The time in seconds, 0 for an empty script.
+		 */
+		float GetLength() const;
+
+	private:
+		std::vector<AudioRenderCue> cues_; //!< The cues, ordered by time.
+	};
+
+	/**
+	 * \brief Renders a script through an audio system initialized with a non-realtime output. Each
+	 * Update renders one mixer block, and a cue is issued before the first block starting at or after
+	 * its time, so a script renders the same output on every run.
+	 *
+	 * The stats of every block are kept in the stats history of the audio system, which is resized to
+	 * hold the whole render, and written to timingsPath.
+	 * \param audio The audio system, with its studio banks loaded.
+	 * \param script The cues to issue.
+	 * \param seconds The duration of audio to render.
+	 * \param timingsPath The path of the file receiving the stats of every block, empty to keep them
+	 * in the history only.
+	 * \param format The format of the timings file.
+	 * \return How fast the script was rendered.
+	 */
+	AudioRenderReport RenderAudioOffline(AudioSystem& audio, const AudioRenderScript& script, float seconds,
+		const std::string& timingsPath, AudioStatsFormat format = AudioStatsFormat::CSV);
+}
+
+#endif // AUDIO_RENDER_H
@@ -0,0 +1,134 @@
+/* ======================================================================== /
+/!
+\file AudioSoundContainer.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the SoundContainer class.
+This file contains the implementation of the variant selection and of the
+volume and pitch draws of sound containers.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <utility>
+#include <stdafx.h>
+#include <AudioSoundContainer.h>
+
+namespace DeckedOut
+{
+	static constexpr size_t MAX_SOUND_VARIANTS = 0xFFFF; //! Variants a container can hold, indices are stored in 16 bits
+
+	SoundContainer::SoundContainer() :
+		variants_(),
+		order_(),
+		next_(0),
+		last_(0),
+		mode_(SoundSelectMode::Shuffle),
+		minVolume_(1.0f),
+		maxVolume_(1.0f),
+		minPitch_(0),
+		maxPitch_(0),
+		random_(1)
+	{
+	}
+
+	void SoundContainer::Set(const SoundContainerDesc& desc, uint32_t seed)
+	{
+		size_t count = std::min(desc.variants_.size(), MAX_SOUND_VARIANTS);
+		variants_.assign(desc.variants_.begin(), desc.variants_.begin() + count);
+		order_.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			order_[i] = (uint16_t)i;
+		}
+		mode_ = desc.mode_;
+		minVolume_ = std::min(desc.minVolume_, desc.maxVolume_);
+		maxVolume_ = std::max(desc.minVolume_, desc.maxVolume_);
+		minPitch_ = std::min(desc.minPitch_, desc.maxPitch_);
+		maxPitch_ = std::max(desc.minPitch_, desc.maxPitch_);
+		random_ = (seed != 0) ? seed : 1;
+		last_ = (unsigned)count;
+		next_ = count;
+	}
+
+	const std::string* SoundContainer::Select()
+	{
+		unsigned count = (unsigned)variants_.size();
+		if (count == 0)
+		{
+			return nullptr;
+		}
+
+		unsigned variant = 0;
+		if (count > 1 && mode_ == SoundSelectMode::Random)
+		{
+			// Draw among the other variants, skipping over the last one
+			variant = RandomBelow((last_ < count) ? count - 1 : count);
+			if (last_ < count && variant >= last_)
+			{
+				++variant;
+			}
+		}
+		else if (count > 1)
+		{
+			if (next_ >= order_.size())
+			{
+				Shuffle();
+			}
+			variant = order_[next_++];
+		}
+
+		last_ = variant;
+		return &variants_[variant];
+	}
+
+	float SoundContainer::RollVolume()
+	{
+		// 24 bits fill the mantissa of a float
+		float t = (float)(NextRandom() >> 8) / (float)(1u << 24);
+		return minVolume_ + (maxVolume_ - minVolume_) * t;
+	}
+
+	int SoundContainer::RollPitch()
+	{
+		return minPitch_ + (int)RandomBelow((unsigned)(maxPitch_ - minPitch_) + 1);
+	}
+
+	size_t SoundContainer::GetVariantCount() const
+	{
+		return variants_.size();
+	}
+
+	uint32_t SoundContainer::NextRandom()
+	{
+		random_ ^= random_ << 13;
+		random_ ^= random_ >> 17;
+		random_ ^= random_ << 5;
+		return random_;
+	}
+
+	unsigned SoundContainer::RandomBelow(unsigned bound)
+	{
+		// Scale instead of taking a modulo, which would favor the low values of the range
+		return (unsigned)(((uint64_t)NextRandom() * bound) >> 32);
+	}
+
+	void SoundContainer::Shuffle()
+	{
+		for (size_t i = order_.size() - 1; i > 0; --i)
+		{
+			std::swap(order_[i], order_[RandomBelow((unsigned)i + 1)]);
+		}
+
+		// A new cycle starting with the variant that ended the last one would play it twice in a row
+		if (order_[0] == last_)
+		{
+			std::swap(order_[0], order_[1 + RandomBelow((unsigned)order_.size() - 1)]);
+		}
+		next_ = 0;
+	}
+}
@@ -0,0 +1,111 @@
+/* ======================================================================== /
+/!
+\file AudioSoundContainer.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the SoundContainer class.
+This file contains the declaration of SoundContainer, a set of variants of
+a one-shot sound picked at random or shuffled, played with a random volume
+and pitch within a range so repeated plays do not sound identical.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_SOUND_CONTAINER_H
+#define AUDIO_SOUND_CONTAINER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing how a sound container picks its next variant.
+	 */
+	enum class SoundSelectMode
+	{
+		Random, //!< Any variant but the last one played.
+		Shuffle //!< Every variant once, in a random order, before any repeats.
+	};
+
+	/**
+	 * \brief Struct describing the variants of a sound container and the ranges of its plays.
+	 */
+	struct SoundContainerDesc
+	{
+		std::vector<std::string> variants_; //!< The names of the sound files of the variants.
+		SoundSelectMode mode_ = SoundSelectMode::Shuffle; //!< How the next variant is picked.
+		float minVolume_ = 1.0f; //!< Smallest factor applied to the volume of a play.
+		float maxVolume_ = 1.0f; //!< Largest factor applied to the volume of a play.
+		int minPitch_ = 0; //!< Smallest offset added to the pitch of a play, in cents.
+		int maxPitch_ = 0; //!< Largest offset added to the pitch of a play, in cents.
+	};
+
+	/**
+	 * \brief Class representing the variants of a sound and the state of their selection.
+	 *
+	 * The container draws from its own xorshift generator, seeded when it is set, so a sequence
+	 * of plays picks the same variants on every run. Picking never allocates.
+	 */
+	class SoundContainer
+	{
+	public:
+		/**
+		 * \brief Default constructor for SoundContainer. The container has no variant until Set.
+		 */
+		SoundContainer();
+
+		/**
+		 * \brief Sets the variants and ranges of the container, restarting its selection.
+		 * \param desc The variants and ranges.
+		 * \param seed The seed of the generator, not zero.
+		 */
+		void Set(const SoundContainerDesc& desc, uint32_t seed);
+
+		/**
+		 * \brief Picks the next variant.
+		 * \return The name of the sound file of the variant, nullptr if the container is empty.
+		 */
+		const std::string* Select();
+
+		/**
+		 * \brief Draws the volume factor of a play.
+		 * \return A factor between the minimum and maximum volume.
+		 */
+		float RollVolume();
+
+		/**
+		 * \brief Draws the pitch offset of a play.
+		 * \return An offset between the minimum and maximum pitch, in cents.
+		 */
+		int RollPitch();
+
+		/**
+		 * \brief Gets the number of variants.
+		 * \return The number of variants.
+		 */
+		size_t GetVariantCount() const;
+
+	private:
+		std::vector<std::string> variants_; //!< The names of the sound files of the variants.
+		std::vector<uint16_t> order_; //!< Shuffled indices of the variants in shuffle mode.
+		size_t next_; //!< Position of the next variant in order_.
+		unsigned last_; //!< Index of the last variant played, the variant count before the first play.
+		SoundSelectMode mode_; //!< How the next variant is picked.
+		float minVolume_; //!< Smallest volume factor.
+		float maxVolume_; //!< Largest volume factor.
+		int minPitch_; //!< Smallest pitch offset, in cents.
+		int maxPitch_; //!< Largest pitch offset, in cents.
+		uint32_t random_; //!< State of the xorshift generator.
+
+		uint32_t NextRandom(); //!< Advances the generator.
+		unsigned RandomBelow(unsigned bound); //!< Draws an integer in [0, bound).
+		void Shuffle(); //!< Reshuffles order_, never starting with the last variant played.
+	};
+}
+
+#endif // AUDIO_SOUND_CONTAINER_H
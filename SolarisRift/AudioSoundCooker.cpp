@@ -0,0 +1,658 @@
+/* ======================================================================== /
+/!
+\file AudioSoundCooker.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioSoundCooker class.
+This file contains the readers of the sound file headers, the decode cost
+model picking the format of every sound, and the IMA ADPCM encoder.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdafx.h>
+#include <AudioSoundCooker.h>
+
+namespace DeckedOut
+{
+	static constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+	static constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+	static constexpr uint16_t WAVE_FORMAT_IMA_ADPCM = 0x0011;
+	static constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+	static constexpr float ADPCM_SAMPLE_COST = 3e-9f; //! Seconds of a core to decode an IMA ADPCM sample
+	static constexpr float VORBIS_SAMPLE_COST = 25e-9f; //! Seconds of a core to decode a Vorbis sample
+	static constexpr float MPEG_SAMPLE_COST = 15e-9f; //! Seconds of a core to decode an MP3 sample
+	static constexpr float FLAC_SAMPLE_COST = 8e-9f; //! Seconds of a core to decode a FLAC sample
+	static constexpr size_t OGG_TAIL_BYTES = 65536; //! Bytes searched at the end of an Ogg file for its last page
+	static constexpr size_t MPEG_SEARCH_BYTES = 8192; //! Bytes searched after the tags of an MP3 file for its first frame
+	static const char PROFILE_SECONDS_KEY[] = "seconds"; //! Key of the line of a play profile holding its duration
+
+	static const int ADPCM_STEPS[89] =
+	{
+		7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+		50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+		337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+		2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+		15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+	};
+	static const int ADPCM_INDEX_CHANGES[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+	static const int MPEG1_BITRATES[16] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0 }; //! Layer III kbps of MPEG 1
+	static const int MPEG2_BITRATES[16] = { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0 }; //! Layer III kbps of MPEG 2 and 2.5
+	static const int MPEG1_RATES[3] = { 44100, 48000, 32000 };
+
+	/**
+	 * \brief The layout of a WAV file.
+	 */
+	struct WavLayout
+	{
+		uint16_t formatTag_ = 0; //!< Encoding of the samples.
+		uint16_t channels_ = 0; //!< Number of channels.
+		uint32_t sampleRate_ = 0; //!< Frames per second.
+		uint16_t blockAlign_ = 0; //!< Bytes of a frame, or of an ADPCM block.
+		uint16_t bitsPerSample_ = 0; //!< Bits of a sample.
+		uint16_t samplesPerBlock_ = 0; //!< Frames of an ADPCM block.
+		uint64_t dataOffset_ = 0; //!< Offset of the samples.
+		uint64_t dataSize_ = 0; //!< Size of the samples.
+		uint64_t factFrames_ = 0; //!< Length from the fact chunk, 0 if there is none.
+	};
+
+	static uint16_t ReadU16(const uint8_t* bytes)
+	{
+		return (uint16_t)(bytes[0] | (bytes[1] << 8));
+	}
+
+	static uint32_t ReadU32(const uint8_t* bytes)
+	{
+		return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+	}
+
+	static uint64_t ReadU64(const uint8_t* bytes)
+	{
+		return (uint64_t)ReadU32(bytes) | ((uint64_t)ReadU32(bytes + 4) << 32);
+	}
+
+	static void WriteU16(std::vector<uint8_t>& bytes, uint16_t value)
+	{
+		bytes.push_back((uint8_t)value);
+		bytes.push_back((uint8_t)(value >> 8));
+	}
+
+	static void WriteU32(std::vector<uint8_t>& bytes, uint32_t value)
+	{
+		WriteU16(bytes, (uint16_t)value);
+		WriteU16(bytes, (uint16_t)(value >> 16));
+	}
+
+	/**
+	 * \brief Reads bytes at an offset of a file.
+	 * \param file The file.
+	 * \param offset The offset of the first byte.
+	 * \param size The most bytes to read.
+	 * \return The bytes read, fewer at the end of the file.
+	 */
+	static std::vector<uint8_t> ReadBytes(std::ifstream& file, uint64_t offset, size_t size)
+	{
+		std::vector<uint8_t> bytes(size);
+		file.clear();
+		file.seekg((std::streamoff)offset);
+		file.read(reinterpret_cast<char*>(bytes.data()), (std::streamsize)size);
+		bytes.resize((size_t)std::max<std::streamsize>(file.gcount(), 0));
+		return bytes;
+	}
+
+	/**
+	 * \brief Reads the chunks of a WAV file up to its samples.
+	 * \param file The file.
+	 * \param fileBytes The size of the file.
+	 * \param layout Receives the layout of the file.
+	 * \return True if the file has a format and a data chunk, false otherwise.
+	 */
+	static bool ReadWavLayout(std::ifstream& file, uint64_t fileBytes, WavLayout& layout)
+	{
+		std::vector<uint8_t> riff = ReadBytes(file, 0, 12);
+		if (riff.size() < 12 || memcmp(riff.data(), "RIFF", 4) != 0 || memcmp(riff.data() + 8, "WAVE", 4) != 0)
+		{
+			return false;
+		}
+
+		bool format = false;
+		uint64_t offset = 12;
+		while (offset + 8 <= fileBytes)
+		{
+			std::vector<uint8_t> chunk = ReadBytes(file, offset, 8);
+			if (chunk.size() < 8)
+			{
+				break;
+			}
+			uint64_t size = ReadU32(chunk.data() + 4);
+			if (memcmp(chunk.data(), "fmt ", 4) == 0 && size >= 16)
+			{
+				std::vector<uint8_t> fmt = ReadBytes(file, offset + 8, (size_t)std::min<uint64_t>(size, 40));
+				if (fmt.size() < 16)
+				{
+					return false;
+				}
+				layout.formatTag_ = ReadU16(fmt.data());
+				layout.channels_ = ReadU16(fmt.data() + 2);
+				layout.sampleRate_ = ReadU32(fmt.data() + 4);
+				layout.blockAlign_ = ReadU16(fmt.data() + 12);
+				layout.bitsPerSample_ = ReadU16(fmt.data() + 14);
+				if (layout.formatTag_ == WAVE_FORMAT_EXTENSIBLE && fmt.size() >= 26)
+				{
+					// The sub-format GUID starts with the tag of the actual encoding
+					layout.formatTag_ = ReadU16(fmt.data() + 24);
+				}
+				if (layout.formatTag_ == WAVE_FORMAT_IMA_ADPCM && fmt.size() >= 20)
+				{
+					layout.samplesPerBlock_ = ReadU16(fmt.data() + 18);
+				}
+				format = true;
+			}
+			else if (memcmp(chunk.data(), "fact", 4) == 0 && size >= 4)
+			{
+				std::vector<uint8_t> fact = ReadBytes(file, offset + 8, 4);
+				layout.factFrames_ = (fact.size() == 4) ? ReadU32(fact.data()) : 0;
+			}
+			else if (memcmp(chunk.data(), "data", 4) == 0)
+			{
+				layout.dataOffset_ = offset + 8;
+				layout.dataSize_ = std::min(size, fileBytes - layout.dataOffset_);
+				return format && layout.channels_ > 0 && layout.sampleRate_ > 0 && layout.blockAlign_ > 0;
+			}
+			offset += 8 + size + (size & 1);
+		}
+		return false;
+	}
+
+	static bool AnalyzeWav(std::ifstream& file, AudioSoundInfo& info)
+	{
+		WavLayout layout;
+		if (!ReadWavLayout(file, info.fileBytes_, layout))
+		{
+			return false;
+		}
+		info.channels_ = layout.channels_;
+		info.sampleRate_ = (int)layout.sampleRate_;
+		info.bitsPerSample_ = layout.bitsPerSample_;
+		if (layout.formatTag_ == WAVE_FORMAT_PCM || layout.formatTag_ == WAVE_FORMAT_IEEE_FLOAT)
+		{
+			info.frames_ = layout.dataSize_ / layout.blockAlign_;
+			return true;
+		}
+		if (layout.formatTag_ == WAVE_FORMAT_IMA_ADPCM && layout.samplesPerBlock_ > 0)
+		{
+			info.adpcm_ = true;
+			info.frames_ = (layout.factFrames_ > 0) ? layout.factFrames_ :
+				layout.dataSize_ / layout.blockAlign_ * layout.samplesPerBlock_;
+			return true;
+		}
+		return false;
+	}
+
+	static bool AnalyzeOgg(std::ifstream& file, AudioSoundInfo& info)
+	{
+		// The identification header of Vorbis is the first packet of the first page
+		std::vector<uint8_t> head = ReadBytes(file, 0, 512);
+		static const uint8_t VORBIS_ID[7] = { 0x01, 'v', 'o', 'r', 'b', 'i', 's' };
+		auto id = std::search(head.begin(), head.end(), std::begin(VORBIS_ID), std::end(VORBIS_ID));
+		if (memcmp(head.data(), "OggS", std::min<size_t>(4, head.size())) != 0 || head.end() - id < 16)
+		{
+			return false;
+		}
+		const uint8_t* identification = &*id;
+		info.channels_ = identification[11];
+		info.sampleRate_ = (int)ReadU32(identification + 12);
+
+		// The granule position of the last page is the length in frames
+		uint64_t tailSize = std::min<uint64_t>(info.fileBytes_, OGG_TAIL_BYTES);
+		std::vector<uint8_t> tail = ReadBytes(file, info.fileBytes_ - tailSize, (size_t)tailSize);
+		for (size_t i = (tail.size() >= 14) ? tail.size() - 14 : 0; i-- > 0;)
+		{
+			if (memcmp(tail.data() + i, "OggS", 4) == 0)
+			{
+				uint64_t granule = ReadU64(tail.data() + i + 6);
+				if (granule != UINT64_MAX)
+				{
+					info.frames_ = granule;
+					break;
+				}
+			}
+		}
+		return info.channels_ > 0 && info.sampleRate_ > 0 && info.frames_ > 0;
+	}
+
+	static bool AnalyzeFlac(std::ifstream& file, AudioSoundInfo& info)
+	{
+		// STREAMINFO is always the first metadata block
+		std::vector<uint8_t> head = ReadBytes(file, 0, 42);
+		if (head.size() < 42 || memcmp(head.data(), "fLaC", 4) != 0 || (head[4] & 0x7F) != 0)
+		{
+			return false;
+		}
+		const uint8_t* streamInfo = head.data() + 8;
+		info.sampleRate_ = (int)(((uint32_t)streamInfo[10] << 12) | ((uint32_t)streamInfo[11] << 4) | (streamInfo[12] >> 4));
+		info.channels_ = ((streamInfo[12] >> 1) & 0x7) + 1;
+		info.bitsPerSample_ = (((streamInfo[12] & 0x1) << 4) | (streamInfo[13] >> 4)) + 1;
+		info.frames_ = ((uint64_t)(streamInfo[13] & 0xF) << 32) |
+			((uint64_t)streamInfo[14] << 24) | ((uint64_t)streamInfo[15] << 16) | ((uint64_t)streamInfo[16] << 8) | streamInfo[17];
+		return info.sampleRate_ > 0 && info.frames_ > 0;
+	}
+
+	static bool AnalyzeMpeg(std::ifstream& file, AudioSoundInfo& info)
+	{
+		// Skip an ID3v2 tag, its size is stored 7 bits per byte
+		uint64_t offset = 0;
+		std::vector<uint8_t> tag = ReadBytes(file, 0, 10);
+		if (tag.size() == 10 && memcmp(tag.data(), "ID3", 3) == 0)
+		{
+			offset = 10 + (((uint64_t)(tag[6] & 0x7F) << 21) | ((tag[7] & 0x7F) << 14) | ((tag[8] & 0x7F) << 7) | (tag[9] & 0x7F));
+			offset += (tag[5] & 0x10) ? 10 : 0;
+		}
+
+		std::vector<uint8_t> frames = ReadBytes(file, offset, MPEG_SEARCH_BYTES);
+		for (size_t i = 0; i + 4 <= frames.size(); ++i)
+		{
+			const uint8_t* header = frames.data() + i;
+			int version = (header[1] >> 3) & 0x3;
+			int layer = (header[1] >> 1) & 0x3;
+			int bitrateIndex = header[2] >> 4;
+			int rateIndex = (header[2] >> 2) & 0x3;
+			if (header[0] != 0xFF || (header[1] & 0xE0) != 0xE0 || version == 1 || layer != 1 || rateIndex == 3 ||
+				bitrateIndex == 0 || bitrateIndex == 15)
+			{
+				continue;
+			}
+
+			// Only the first frame is read, so the length assumes a constant bit rate
+			int bitrate = ((version == 3) ? MPEG1_BITRATES : MPEG2_BITRATES)[bitrateIndex] * 1000;
+			info.sampleRate_ = MPEG1_RATES[rateIndex] >> ((version == 3) ? 0 : (version == 2) ? 1 : 2);
+			info.channels_ = ((header[3] >> 6) == 3) ? 1 : 2;
+			info.frames_ = (info.fileBytes_ - offset - i) * 8 * (uint64_t)info.sampleRate_ / (uint64_t)bitrate;
+			info.estimated_ = true;
+			return info.frames_ > 0;
+		}
+		return false;
+	}
+
+	/**
+	 * \brief Gets the seconds of a core a voice spends decoding a sample of a format.
+	 * \param format The format.
+	 * \param info The source file.
+	 * \return The cost of a sample.
+	 */
+	static float GetSampleCost(AudioSoundFormat format, const AudioSoundInfo& info)
+	{
+		if (format == AudioSoundFormat::PCM)
+		{
+			return 0.0f;
+		}
+		if (format == AudioSoundFormat::ADPCM || info.adpcm_)
+		{
+			return ADPCM_SAMPLE_COST;
+		}
+		switch (info.codec_)
+		{
+		case AudioPackCodec::Vorbis: return VORBIS_SAMPLE_COST;
+		case AudioPackCodec::Mpeg:   return MPEG_SAMPLE_COST;
+		case AudioPackCodec::Flac:   return FLAC_SAMPLE_COST;
+		default:                     return 0.0f;
+		}
+	}
+
+	/**
+	 * \brief Gets the size of an IMA ADPCM block per channel, following the Microsoft convention.
+	 * \param sampleRate The sample rate.
+	 * \return The bytes of the block of one channel.
+	 */
+	static uint32_t GetADPCMChannelBlockBytes(int sampleRate)
+	{
+		return 256u * (uint32_t)std::min(std::max(sampleRate / 11025, 1), 4);
+	}
+
+	/**
+	 * \brief Encodes one sample to an IMA ADPCM nibble.
+	 * \param sample The sample.
+	 * \param predictor The decoded value of the previous sample, updated.
+	 * \param index The step index, updated.
+	 * \return The nibble.
+	 */
+	static uint8_t EncodeADPCMSample(int sample, int& predictor, int& index)
+	{
+		int step = ADPCM_STEPS[index];
+		int difference = sample - predictor;
+		uint8_t nibble = 0;
+		if (difference < 0)
+		{
+			nibble = 8;
+			difference = -difference;
+		}
+
+		// Mirror the decoder, so the encoder tracks exactly what the decoder will reconstruct
+		int delta = step >> 3;
+		if (difference >= step)
+		{
+			nibble |= 4;
+			difference -= step;
+			delta += step;
+		}
+		step >>= 1;
+		if (difference >= step)
+		{
+			nibble |= 2;
+			difference -= step;
+			delta += step;
+		}
+		step >>= 1;
+		if (difference >= step)
+		{
+			nibble |= 1;
+			delta += step;
+		}
+
+		predictor += (nibble & 8) ? -delta : delta;
+		predictor = std::min(std::max(predictor, -32768), 32767);
+		index = std::min(std::max(index + ADPCM_INDEX_CHANGES[nibble & 7], 0), 88);
+		return nibble;
+	}
+
+	bool AudioSoundCooker::Cook(const char* directory, const char* profilePath, const char* cookedDirectory,
+		const char* manifestPath, const AudioSoundCookSettings& settings, std::vector<AudioSoundCookResult>* results)
+	{
+		std::unordered_map<std::string, float> playsPerSecond;
+		if (profilePath != nullptr)
+		{
+			ReadProfile(profilePath, playsPerSecond);
+		}
+
+		std::error_code error;
+		std::filesystem::path root(directory);
+		std::filesystem::path cookedRoot(cookedDirectory);
+		std::string prefix = root.generic_string();
+		std::string cookedPrefix = cookedRoot.generic_string();
+		if (!prefix.empty() && prefix.back() != '/')
+		{
+			prefix += '/';
+		}
+		if (!cookedPrefix.empty() && cookedPrefix.back() != '/')
+		{
+			cookedPrefix += '/';
+		}
+
+		// Offset 0 holds an empty string, the cooked name of the sounds opened from their source
+		std::vector<AudioSoundManifestEntry> entries;
+		std::vector<char> strings(1, '\0');
+		for (std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+		{
+			if (!it->is_regular_file())
+			{
+				continue;
+			}
+			std::filesystem::path relative = std::filesystem::relative(it->path(), root);
+			AudioSoundCookResult result;
+			result.name_ = prefix + relative.generic_string();
+
+			// Sounds the cooker cannot read keep loading with the flags the game gives them
+			if (!Analyze(it->path().string(), result.info_))
+			{
+				continue;
+			}
+			auto plays = playsPerSecond.find(result.name_);
+			result.playsPerSecond_ = (plays != playsPerSecond.end()) ? plays->second : 0.0f;
+			ChooseFormat(result.info_, result.playsPerSecond_, settings, result);
+
+			if (result.format_ == AudioSoundFormat::ADPCM && !result.info_.adpcm_)
+			{
+				result.cookedName_ = cookedPrefix + relative.generic_string();
+				if (!EncodeADPCM(it->path().string(), (cookedRoot / relative).string()))
+				{
+					return false;
+				}
+			}
+
+			AudioSoundManifestEntry entry = {};
+			entry.hash_ = AudioId(result.name_).Value();
+			entry.format_ = (uint32_t)result.format_;
+			entry.nameOffset_ = (uint32_t)strings.size();
+			entry.nameLength_ = (uint32_t)result.name_.size();
+			strings.insert(strings.end(), result.name_.begin(), result.name_.end());
+			strings.push_back('\0');
+			if (!result.cookedName_.empty())
+			{
+				entry.cookedOffset_ = (uint32_t)strings.size();
+				entry.cookedLength_ = (uint32_t)result.cookedName_.size();
+				strings.insert(strings.end(), result.cookedName_.begin(), result.cookedName_.end());
+				strings.push_back('\0');
+			}
+			entries.push_back(entry);
+			if (results != nullptr)
+			{
+				results->push_back(result);
+			}
+		}
+		if (error)
+		{
+			return false;
+		}
+		return AudioSoundManifest::Write(manifestPath, std::move(entries), strings);
+	}
+
+	bool AudioSoundCooker::Analyze(const std::string& path, AudioSoundInfo& info)
+	{
+		info = AudioSoundInfo();
+		info.codec_ = AudioPack::GetCodec(path);
+		std::error_code error;
+		info.fileBytes_ = (uint64_t)std::filesystem::file_size(path, error);
+		std::ifstream file(path, std::ios::binary);
+		if (error || !file.is_open())
+		{
+			return false;
+		}
+
+		switch (info.codec_)
+		{
+		case AudioPackCodec::Wav:    return AnalyzeWav(file, info);
+		case AudioPackCodec::Vorbis: return AnalyzeOgg(file, info);
+		case AudioPackCodec::Flac:   return AnalyzeFlac(file, info);
+		case AudioPackCodec::Mpeg:   return AnalyzeMpeg(file, info);
+		default:                     return false; // FSB files were already encoded by the FMOD tools
+		}
+	}
+
+	void AudioSoundCooker::ChooseFormat(const AudioSoundInfo& info, float playsPerSecond,
+		const AudioSoundCookSettings& settings, AudioSoundCookResult& result)
+	{
+		float seconds = (info.sampleRate_ > 0) ? (float)info.frames_ / (float)info.sampleRate_ : 0.0f;
+		float voices = std::max(1.0f, playsPerSecond * seconds);
+		float samplesPerSecond = (float)info.sampleRate_ * (float)info.channels_;
+		uint64_t pcmBytes = info.frames_ * (uint64_t)info.channels_ * sizeof(int16_t);
+
+		auto choose = [&](AudioSoundFormat format, uint64_t memoryBytes)
+		{
+			result.format_ = format;
+			result.memoryBytes_ = memoryBytes;
+			result.decodeCost_ = samplesPerSecond * GetSampleCost(format, info) * voices;
+		};
+
+		// Long sounds are music and ambience, played by a voice or two, whose decoded size would dwarf the rest
+		if (seconds >= settings.streamSeconds_)
+		{
+			choose(AudioSoundFormat::Stream, 0);
+			return;
+		}
+		if (pcmBytes <= settings.pcmBytes_)
+		{
+			choose(AudioSoundFormat::PCM, pcmBytes);
+			return;
+		}
+
+		// Smallest in memory first, FMOD only keeps Vorbis and MP3 compressed in memory
+		uint32_t blockBytes = GetADPCMChannelBlockBytes(info.sampleRate_) * (uint32_t)info.channels_;
+		uint64_t blockFrames = (GetADPCMChannelBlockBytes(info.sampleRate_) - 4) * 2 + 1;
+		uint64_t adpcmBytes = info.adpcm_ ? info.fileBytes_ : (info.frames_ + blockFrames - 1) / blockFrames * blockBytes;
+		bool compressed = (info.codec_ == AudioPackCodec::Vorbis || info.codec_ == AudioPackCodec::Mpeg);
+		bool adpcm = info.adpcm_ || (info.codec_ == AudioPackCodec::Wav && info.bitsPerSample_ == 16);
+		const std::pair<AudioSoundFormat, uint64_t> candidates[] =
+		{
+			{ compressed ? AudioSoundFormat::Compressed : AudioSoundFormat::Count, info.fileBytes_ },
+			{ adpcm ? AudioSoundFormat::ADPCM : AudioSoundFormat::Count, adpcmBytes }
+		};
+		for (const auto& candidate : candidates)
+		{
+			if (candidate.first == AudioSoundFormat::Count)
+			{
+				continue;
+			}
+			float voiceCost = samplesPerSecond * GetSampleCost(candidate.first, info);
+			if (voiceCost <= settings.voiceDecodeBudget_ && voiceCost * voices <= settings.soundDecodeBudget_)
+			{
+				choose(candidate.first, candidate.second);
+				return;
+			}
+		}
+		choose(AudioSoundFormat::PCM, pcmBytes);
+	}
+
+	bool AudioSoundCooker::EncodeADPCM(const std::string& sourcePath, const std::string& cookedPath)
+	{
+		std::error_code error;
+		uint64_t fileBytes = (uint64_t)std::filesystem::file_size(sourcePath, error);
+		std::ifstream source(sourcePath, std::ios::binary);
+		WavLayout layout;
+		if (error || !source.is_open() || !ReadWavLayout(source, fileBytes, layout) ||
+			layout.formatTag_ != WAVE_FORMAT_PCM || layout.bitsPerSample_ != 16)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> data = ReadBytes(source, layout.dataOffset_, (size_t)layout.dataSize_);
+		int channels = layout.channels_;
+		uint64_t frames = data.size() / layout.blockAlign_;
+		auto sample = [&](uint64_t frame, int channel) -> int
+		{
+			return (frame < frames) ? (int16_t)ReadU16(data.data() + (frame * channels + channel) * 2) : 0;
+		};
+
+		uint32_t channelBlockBytes = GetADPCMChannelBlockBytes((int)layout.sampleRate_);
+		uint32_t blockBytes = channelBlockBytes * channels;
+		uint32_t blockFrames = (channelBlockBytes - 4) * 2 + 1;
+		uint64_t blocks = (frames + blockFrames - 1) / blockFrames;
+
+		std::vector<uint8_t> encoded;
+		encoded.reserve((size_t)(blocks * blockBytes));
+		std::vector<int> predictors(channels, 0);
+		std::vector<int> indices(channels, 0);
+		for (uint64_t block = 0; block < blocks; ++block)
+		{
+			// Each channel starts its block with a raw sample and the step index carried over
+			uint64_t first = block * blockFrames;
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				predictors[channel] = sample(first, channel);
+				WriteU16(encoded, (uint16_t)(int16_t)predictors[channel]);
+				encoded.push_back((uint8_t)indices[channel]);
+				encoded.push_back(0);
+			}
+
+			// Then words of 8 nibbles, the channels taking turns
+			for (uint32_t group = 0; group < (blockFrames - 1) / 8; ++group)
+			{
+				for (int channel = 0; channel < channels; ++channel)
+				{
+					for (int pair = 0; pair < 4; ++pair)
+					{
+						uint64_t frame = first + 1 + group * 8 + pair * 2;
+						uint8_t low = EncodeADPCMSample(sample(frame, channel), predictors[channel], indices[channel]);
+						uint8_t high = EncodeADPCMSample(sample(frame + 1, channel), predictors[channel], indices[channel]);
+						encoded.push_back((uint8_t)(low | (high << 4)));
+					}
+				}
+			}
+		}
+
+		std::vector<uint8_t> header;
+		header.insert(header.end(), { 'R', 'I', 'F', 'F' });
+		WriteU32(header, (uint32_t)(4 + (8 + 20) + (8 + 4) + 8 + encoded.size()));
+		header.insert(header.end(), { 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+		WriteU32(header, 20);
+		WriteU16(header, WAVE_FORMAT_IMA_ADPCM);
+		WriteU16(header, (uint16_t)channels);
+		WriteU32(header, layout.sampleRate_);
+		WriteU32(header, (uint32_t)((uint64_t)layout.sampleRate_ * blockBytes / blockFrames));
+		WriteU16(header, (uint16_t)blockBytes);
+		WriteU16(header, 4);
+		WriteU16(header, 2);
+		WriteU16(header, (uint16_t)blockFrames);
+		header.insert(header.end(), { 'f', 'a', 'c', 't' });
+		WriteU32(header, 4);
+		WriteU32(header, (uint32_t)frames);
+		header.insert(header.end(), { 'd', 'a', 't', 'a' });
+		WriteU32(header, (uint32_t)encoded.size());
+
+		std::filesystem::create_directories(std::filesystem::path(cookedPath).parent_path(), error);
+		std::ofstream cooked(cookedPath, std::ios::binary | std::ios::trunc);
+		if (!cooked.is_open())
+		{
+			return false;
+		}
+		cooked.write(reinterpret_cast<const char*>(header.data()), (std::streamsize)header.size());
+		cooked.write(reinterpret_cast<const char*>(encoded.data()), (std::streamsize)encoded.size());
+		return cooked.good();
+	}
+
+	bool AudioSoundCooker::ReadProfile(const char* path, std::unordered_map<std::string, float>& playsPerSecond)
+	{
+		std::ifstream profile(path);
+		if (!profile.is_open())
+		{
+			return false;
+		}
+
+		// A "seconds" line holds the duration, every other line a play count and the name it counts
+		float seconds = 0.0f;
+		std::unordered_map<std::string, float> plays;
+		std::string line;
+		while (std::getline(profile, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+			std::istringstream fields(line);
+			std::string first;
+			if (!(fields >> first))
+			{
+				continue;
+			}
+			if (first == PROFILE_SECONDS_KEY)
+			{
+				fields >> seconds;
+				continue;
+			}
+			std::string name;
+			std::getline(fields >> std::ws, name);
+			if (!name.empty())
+			{
+				plays[name] += (float)atof(first.c_str());
+			}
+		}
+		if (seconds <= 0.0f)
+		{
+			return false;
+		}
+
+		for (auto& sound : plays)
+		{
+			playsPerSecond[sound.first] = sound.second / seconds;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,132 @@
+/* ======================================================================== /
+/!
+\file AudioSoundCooker.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioSoundCooker class.
+This file contains the declaration of the offline cooker that measures every
+sound file, weighs its length and how often the game plays it against a
+decode budget, picks the format it loads in and writes the sound manifest.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_SOUND_COOKER_H
+#define AUDIO_SOUND_COOKER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <AudioPack.h>
+#include <AudioSoundManifest.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Struct describing how the AudioSoundCooker weighs decode cost against memory.
+	 *
+	 * Decode cost is a share of one core. A voice of a sound costs its sample rate times its channels
+	 * times the cost of a sample of its format, and a sound costs that times its average number of
+	 * playing voices, its plays per second times its length.
+	 */
+	struct AudioSoundCookSettings
+	{
+		float streamSeconds_ = 10.0f; //!< Sounds at least this long are streamed.
+		size_t pcmBytes_ = 64 * 1024; //!< Sounds at most this large once decoded stay PCM, they cost too little memory to compress.
+		float voiceDecodeBudget_ = 0.002f; //!< Share of a core one voice may spend decoding.
+		float soundDecodeBudget_ = 0.005f; //!< Share of a core every playing voice of one sound may spend decoding.
+	};
+
+	/**
+	 * \brief Struct describing a sound file, as read from its headers.
+	 */
+	struct AudioSoundInfo
+	{
+		AudioPackCodec codec_ = AudioPackCodec::Unknown; //!< Encoding of the file.
+		int channels_ = 0; //!< Number of channels.
+		int sampleRate_ = 0; //!< Frames per second.
+		int bitsPerSample_ = 0; //!< Bits of a PCM sample, 4 for IMA ADPCM, 0 for the other encodings.
+		uint64_t frames_ = 0; //!< Length in frames.
+		uint64_t fileBytes_ = 0; //!< Size of the file.
+		bool adpcm_ = false; //!< Whether the file is already IMA ADPCM.
+		bool estimated_ = false; //!< Whether the length was estimated from the bit rate.
+	};
+
+	/**
+	 * \brief Struct reporting the format the cooker picked for one sound.
+	 */
+	struct AudioSoundCookResult
+	{
+		std::string name_; //!< Name the sound is loaded by.
+		std::string cookedName_; //!< Name of the file written by the cooker, empty if the source is opened.
+		AudioSoundInfo info_; //!< The source file.
+		float playsPerSecond_ = 0.0f; //!< Plays per second of the profile.
+		AudioSoundFormat format_ = AudioSoundFormat::PCM; //!< The format picked.
+		uint64_t memoryBytes_ = 0; //!< Bytes the sound holds while loaded, the stream buffer aside.
+		float decodeCost_ = 0.0f; //!< Share of a core the playing voices spend decoding.
+	};
+
+	/**
+	 * \brief Class representing the offline cooker of the sound manifest.
+	 */
+	class AudioSoundCooker
+	{
+	public:
+		/**
+		 * \brief Cooks every sound file of a directory and its subdirectories. Sounds are named like
+		 * AudioPack::Build names them, files re-encoded to ADPCM are written under the cooked
+		 * directory with the same relative path, and the manifest lists the format of every sound.
+		 * Files the cooker cannot read are left out and load with the flags the game gives them.
+		 * \param directory The directory of the sound files.
+		 * \param profilePath The play profile written by AudioSystem::WriteSoundPlayProfile, nullptr
+		 * or missing to cook as if no sound was ever played.
+		 * \param cookedDirectory The directory the ADPCM files are written to.
+		 * \param manifestPath The path of the manifest to write.
+		 * \param settings The decode budgets.
+		 * \param results Receives the format of every sound, may be nullptr.
+		 * \return True if the manifest was written, false if the directory could not be walked, a file
+		 * could not be written or two names share a hash.
+		 */
+		static bool Cook(const char* directory, const char* profilePath, const char* cookedDirectory,
+			const char* manifestPath, const AudioSoundCookSettings& settings, std::vector<AudioSoundCookResult>* results);
+
+		/**
+		 * \brief Reads the format and length of a sound file from its headers.
+		 * \param path The path of the file.
+		 * \param info Receives the description of the file.
+		 * \return True if the file is a sound the cooker understands, false otherwise.
+		 */
+		static bool Analyze(const std::string& path, AudioSoundInfo& info);
+
+		/**
+		 * \brief Picks the format of a sound, the smallest in memory that fits the decode budgets.
+		 * \param info The source file.
+		 * \param playsPerSecond How often the game plays it.
+		 * \param settings The decode budgets.
+		 * \param result Receives the format, its memory and its decode cost.
+		 */
+		static void ChooseFormat(const AudioSoundInfo& info, float playsPerSecond,
+			const AudioSoundCookSettings& settings, AudioSoundCookResult& result);
+
+		/**
+		 * \brief Encodes a 16-bit PCM WAV file to an IMA ADPCM WAV file.
+		 * \param sourcePath The path of the PCM file.
+		 * \param cookedPath The path of the ADPCM file to write.
+		 * \return True if the file was written, false if the source is not 16-bit PCM or a file failed.
+		 */
+		static bool EncodeADPCM(const std::string& sourcePath, const std::string& cookedPath);
+
+		/**
+		 * \brief Reads a play profile.
+		 * \param path The path of the profile.
+		 * \param playsPerSecond Receives the plays per second of every sound in the profile.
+		 * \return True if the profile was read, false if it is missing or has no duration.
+		 */
+		static bool ReadProfile(const char* path, std::unordered_map<std::string, float>& playsPerSecond);
+	};
+}
+
+#endif // AUDIO_SOUND_COOKER_H
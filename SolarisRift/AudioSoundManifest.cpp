@@ -0,0 +1,146 @@
+/* ======================================================================== /
+/!
+\file AudioSoundManifest.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioSoundManifest class.
+This file contains the implementation of the checks made when a sound
+manifest is mapped, of the lookup of its sounds and of its writer.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdafx.h>
+#include <AudioSoundManifest.h>
+
+namespace DeckedOut
+{
+	static const char SOUND_MANIFEST_MAGIC[4] = { 'S', 'R', 'S', 'M' };
+	static constexpr uint32_t SOUND_MANIFEST_VERSION = 1;
+
+	AudioSoundManifest::AudioSoundManifest() :
+		file_(),
+		entries_(nullptr),
+		strings_(nullptr),
+		entryCount_(0)
+	{
+	}
+
+	bool AudioSoundManifest::Load(const char* path)
+	{
+		Unload();
+		if (!file_.Open(path) || file_.Size() < sizeof(AudioSoundManifestHeader))
+		{
+			Unload();
+			return false;
+		}
+
+		const AudioSoundManifestHeader* header = reinterpret_cast<const AudioSoundManifestHeader*>(file_.Data());
+		if (memcmp(header->magic_, SOUND_MANIFEST_MAGIC, sizeof(SOUND_MANIFEST_MAGIC)) != 0 ||
+			header->version_ != SOUND_MANIFEST_VERSION)
+		{
+			Unload();
+			return false;
+		}
+
+		size_t expectedSize = sizeof(AudioSoundManifestHeader) +
+			(size_t)header->entryCount_ * sizeof(AudioSoundManifestEntry) + header->stringPoolSize_;
+		if (file_.Size() != expectedSize)
+		{
+			Unload();
+			return false;
+		}
+		entries_ = reinterpret_cast<const AudioSoundManifestEntry*>(file_.Data() + sizeof(AudioSoundManifestHeader));
+		strings_ = reinterpret_cast<const char*>(entries_ + header->entryCount_);
+		entryCount_ = header->entryCount_;
+
+		// Every name must be a terminated string inside the pool, and every format one the game knows
+		for (size_t i = 0; i < entryCount_; ++i)
+		{
+			const AudioSoundManifestEntry& entry = entries_[i];
+			size_t nameEnd = (size_t)entry.nameOffset_ + entry.nameLength_;
+			size_t cookedEnd = (size_t)entry.cookedOffset_ + entry.cookedLength_;
+			if (nameEnd >= header->stringPoolSize_ || strings_[nameEnd] != '\0' ||
+				cookedEnd >= header->stringPoolSize_ || strings_[cookedEnd] != '\0' ||
+				entry.format_ >= (uint32_t)AudioSoundFormat::Count)
+			{
+				Unload();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AudioSoundManifest::Unload()
+	{
+		file_.Close();
+		entries_ = nullptr;
+		strings_ = nullptr;
+		entryCount_ = 0;
+	}
+
+	bool AudioSoundManifest::IsLoaded() const
+	{
+		return file_.IsOpen();
+	}
+
+	const AudioSoundManifestEntry* AudioSoundManifest::Find(const std::string& name) const
+	{
+		uint32_t hash = AudioId(name).Value();
+		const AudioSoundManifestEntry* end = entries_ + entryCount_;
+		const AudioSoundManifestEntry* entry = std::lower_bound(entries_, end, hash,
+			[](const AudioSoundManifestEntry& lhs, uint32_t key) { return lhs.hash_ < key; });
+
+		// A name that only shares the hash of a listed sound is loaded with the flags it is given
+		if (entry == end || entry->hash_ != hash || entry->nameLength_ != name.size() ||
+			memcmp(strings_ + entry->nameOffset_, name.data(), name.size()) != 0)
+		{
+			return nullptr;
+		}
+		return entry;
+	}
+
+	const char* AudioSoundManifest::GetOpenName(const AudioSoundManifestEntry& entry) const
+	{
+		return strings_ + ((entry.cookedLength_ > 0) ? entry.cookedOffset_ : entry.nameOffset_);
+	}
+
+	size_t AudioSoundManifest::Count() const
+	{
+		return entryCount_;
+	}
+
+	bool AudioSoundManifest::Write(const char* path, std::vector<AudioSoundManifestEntry> entries, const std::vector<char>& strings)
+	{
+		std::sort(entries.begin(), entries.end(),
+			[](const AudioSoundManifestEntry& lhs, const AudioSoundManifestEntry& rhs) { return lhs.hash_ < rhs.hash_; });
+		auto duplicate = std::adjacent_find(entries.begin(), entries.end(),
+			[](const AudioSoundManifestEntry& lhs, const AudioSoundManifestEntry& rhs) { return lhs.hash_ == rhs.hash_; });
+		if (duplicate != entries.end())
+		{
+			return false;
+		}
+
+		AudioSoundManifestHeader header = {};
+		memcpy(header.magic_, SOUND_MANIFEST_MAGIC, sizeof(SOUND_MANIFEST_MAGIC));
+		header.version_ = SOUND_MANIFEST_VERSION;
+		header.entryCount_ = (uint32_t)entries.size();
+		header.stringPoolSize_ = (uint32_t)strings.size();
+
+		std::ofstream manifestFile(path, std::ios::binary | std::ios::trunc);
+		if (!manifestFile.is_open())
+		{
+			return false;
+		}
+		manifestFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		manifestFile.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(AudioSoundManifestEntry)));
+		manifestFile.write(strings.data(), (std::streamsize)strings.size());
+		return manifestFile.good();
+	}
+}
@@ -0,0 +1,132 @@
+/* ======================================================================== /
+/!
+\file AudioSoundManifest.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioSoundManifest class.
+This file contains the declaration of the AudioSoundManifest class, which
+maps a cooked list of the sound files with the format each is loaded in,
+chosen offline by the AudioSoundCooker.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_SOUND_MANIFEST_H
+#define AUDIO_SOUND_MANIFEST_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <AudioId.h>
+#include <MappedFile.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Enumeration representing the formats a sound is loaded in, from the cheapest to decode.
+	 */
+	enum class AudioSoundFormat : uint32_t
+	{
+		PCM,        //!< Decoded once when it loads, no decoding when it plays.
+		ADPCM,      //!< Encoded to IMA ADPCM by the cooker, decoded cheaply by every voice.
+		Compressed, //!< Kept in its Vorbis or MP3 source encoding, decoded by every voice.
+		Stream,     //!< Read and decoded from the file while it plays.
+		Count       //!< Number of formats.
+	};
+
+	/**
+	 * \brief Struct representing one sound in a manifest.
+	 */
+	struct AudioSoundManifestEntry
+	{
+		uint32_t hash_; //!< AudioId of the name the sound is loaded by.
+		uint32_t format_; //!< AudioSoundFormat the sound is loaded in.
+		uint32_t nameOffset_; //!< Offset of the null-terminated name in the string pool.
+		uint32_t nameLength_; //!< Length of the name, excluding the terminator.
+		uint32_t cookedOffset_; //!< Offset of the null-terminated name of the cooked file in the string pool.
+		uint32_t cookedLength_; //!< Length of the name of the cooked file, 0 when the source file is opened.
+	};
+
+	/**
+	 * \brief Struct representing the header of a sound manifest.
+	 *
+	 * The header is followed by the entries, sorted by hash, and by the string pool.
+	 */
+	struct AudioSoundManifestHeader
+	{
+		char magic_[4]; //!< Always "SRSM".
+		uint32_t version_; //!< Version of the format.
+		uint32_t entryCount_; //!< Number of sounds.
+		uint32_t stringPoolSize_; //!< Size of the string pool in bytes.
+	};
+
+	/**
+	 * \brief Class representing the formats the sounds are loaded in.
+	 */
+	class AudioSoundManifest
+	{
+	public:
+		/**
+		 * \brief Default constructor for AudioSoundManifest.
+		 */
+		AudioSoundManifest();
+
+		/**
+		 * \brief Maps a manifest, unloading any manifest mapped before.
+		 * \param path The path of the manifest.
+		 * \return True if the manifest was mapped, false if it is missing or invalid.
+		 */
+		bool Load(const char* path);
+
+		/**
+		 * \brief Unmaps the manifest.
+		 */
+		void Unload();
+
+		/**
+		 * \brief Checks if a manifest is mapped.
+		 * \return True if a manifest is mapped, false otherwise.
+		 */
+		bool IsLoaded() const;
+
+		/**
+		 * \brief Finds a sound by the name it is loaded by.
+		 * \param name The name of the sound, as given to AudioSystem::LoadSound.
+		 * \return The entry of the sound, or nullptr if the manifest does not list it.
+		 */
+		const AudioSoundManifestEntry* Find(const std::string& name) const;
+
+		/**
+		 * \brief Gets the name of the file to open for a sound.
+		 * \param entry The entry of the sound.
+		 * \return The null-terminated name of the cooked file, or of the source file if it was not re-encoded.
+		 */
+		const char* GetOpenName(const AudioSoundManifestEntry& entry) const;
+
+		/**
+		 * \brief Gets the number of sounds in the manifest.
+		 * \return The number of sounds.
+		 */
+		size_t Count() const;
+
+		/**
+		 * \brief Writes a manifest.
+		 * \param path The path of the manifest to write.
+		 * \param entries The entries, sorted by this function.
+		 * \param strings The string pool the entries point into.
+		 * \return True if the manifest was written, false if two names share a hash or the file could not be written.
+		 */
+		static bool Write(const char* path, std::vector<AudioSoundManifestEntry> entries, const std::vector<char>& strings);
+
+	private:
+		MappedFile file_; //!< The mapping of the manifest.
+		const AudioSoundManifestEntry* entries_; //!< The entries, sorted by hash.
+		const char* strings_; //!< The string pool.
+		size_t entryCount_; //!< Number of entries.
+	};
+}
+
+#endif // AUDIO_SOUND_MANIFEST_H
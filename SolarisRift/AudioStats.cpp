@@ -0,0 +1,145 @@
+/* ======================================================================== /
+/!
+\file AudioStats.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the AudioStatsHistory class.
+This file contains the implementation of the rolling window of audio stats
+and its CSV and JSON writers.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <fstream>
+#include <stdafx.h>
+#include <AudioStats.h>
+
+namespace DeckedOut
+{
+	static constexpr int STAT_COLUMNS = 21; //! Number of fields of AudioStats
+	static const char* const STAT_NAMES[STAT_COLUMNS] =
+	{
+		"frame", "dspCPU", "streamCPU", "coreUpdateCPU", "studioUpdateCPU",
+		"channelsPlaying", "realChannels", "virtualChannels", "soundVoices",
+		"memoryBytes", "memoryPeakBytes", "banksLoaded", "banksLoading",
+		"sampleDataBytes", "soundCacheBytes", "commandQueueDepth", "updateTime",
+		"arenaAllocations", "arenaFrees", "arenaPeakBytes", "arenaFragmentation"
+	};
+
+	/**
+	 * \brief Writes the fields of a frame, in the order of STAT_NAMES.
+	 * \param file The file to write to.
+	 * \param stats The stats of the frame.
+	 * \param format The file format.
+	 */
+	static void WriteFrame(std::ofstream& file, const AudioStats& stats, AudioStatsFormat format)
+	{
+		int column = 0;
+		auto writeField = [&](auto value)
+		{
+			if (format == AudioStatsFormat::JSON)
+			{
+				file << (column == 0 ? "{" : ",") << '"' << STAT_NAMES[column] << "\":" << value;
+			}
+			else
+			{
+				file << (column == 0 ? "" : ",") << value;
+			}
+			++column;
+		};
+
+		writeField(stats.frame_);
+		writeField(stats.dspCPU_);
+		writeField(stats.streamCPU_);
+		writeField(stats.coreUpdateCPU_);
+		writeField(stats.studioUpdateCPU_);
+		writeField(stats.channelsPlaying_);
+		writeField(stats.realChannels_);
+		writeField(stats.virtualChannels_);
+		writeField(stats.soundVoices_);
+		writeField(stats.memoryBytes_);
+		writeField(stats.memoryPeakBytes_);
+		writeField(stats.banksLoaded_);
+		writeField(stats.banksLoading_);
+		writeField(stats.sampleDataBytes_);
+		writeField(stats.soundCacheBytes_);
+		writeField(stats.commandQueueDepth_);
+		writeField(stats.updateTime_);
+		writeField(stats.arenaAllocations_);
+		writeField(stats.arenaFrees_);
+		writeField(stats.arenaPeakBytes_);
+		writeField(stats.arenaFragmentation_);
+		file << (format == AudioStatsFormat::JSON ? "}" : "");
+	}
+
+	AudioStatsHistory::AudioStatsHistory() :
+		frames_(),
+		pushed_(0)
+	{
+	}
+
+	void AudioStatsHistory::SetCapacity(size_t frames)
+	{
+		frames_.assign(frames, AudioStats());
+		pushed_ = 0;
+	}
+
+	void AudioStatsHistory::Push(const AudioStats& stats)
+	{
+		if (frames_.empty())
+		{
+			return;
+		}
+		frames_[pushed_ % frames_.size()] = stats;
+		++pushed_;
+	}
+
+	size_t AudioStatsHistory::GetCount() const
+	{
+		return (pushed_ < frames_.size()) ? pushed_ : frames_.size();
+	}
+
+	bool AudioStatsHistory::Write(const char* path, AudioStatsFormat format) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		if (format == AudioStatsFormat::CSV)
+		{
+			for (int column = 0; column < STAT_COLUMNS; ++column)
+			{
+				file << (column == 0 ? "" : ",") << STAT_NAMES[column];
+			}
+			file << '\n';
+		}
+		else
+		{
+			file << "[\n";
+		}
+
+		// The oldest frame is the one the next push overwrites
+		size_t count = GetCount();
+		size_t first = pushed_ - count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			WriteFrame(file, frames_[(first + i) % frames_.size()], format);
+			if (format == AudioStatsFormat::JSON && i + 1 < count)
+			{
+				file << ',';
+			}
+			file << '\n';
+		}
+
+		if (format == AudioStatsFormat::JSON)
+		{
+			file << "]\n";
+		}
+		return file.good();
+	}
+}
@@ -0,0 +1,110 @@
+/* ======================================================================== /
+/!
+\file AudioStats.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the AudioStats struct and AudioStatsHistory class.
+This file contains the declaration of AudioStats, the per-frame cost of the
+audio system, and AudioStatsHistory, a rolling window of those frames that
+can be written out as CSV or JSON to compare builds under load.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef AUDIO_STATS_H
+#define AUDIO_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Struct reporting the cost of the audio system during a frame. CPU usages are percentages
+	 * of a core, times are in seconds.
+	 */
+	struct AudioStats
+	{
+		uint64_t frame_; //!< Number of the game frame, counted by AudioSystem::Update.
+		float dspCPU_; //!< CPU used by the mixer thread.
+		float streamCPU_; //!< CPU used by the stream thread.
+		float coreUpdateCPU_; //!< CPU used by the update of the core system.
+		float studioUpdateCPU_; //!< CPU used by the update of the studio system.
+		int channelsPlaying_; //!< Channels playing, real and virtual.
+		int realChannels_; //!< Channels actually mixed.
+		int virtualChannels_; //!< Channels virtualized by FMOD.
+		unsigned soundVoices_; //!< Voices of PlaySound in use.
+		int memoryBytes_; //!< Bytes currently allocated by FMOD.
+		int memoryPeakBytes_; //!< Most bytes FMOD had allocated at once.
+		unsigned banksLoaded_; //!< Number of banks that finished loading, failed loads aside.
+		unsigned banksLoading_; //!< Number of banks still loading asynchronously.
+		int sampleDataBytes_; //!< Bytes of sample data loaded by FMOD studio.
+		size_t soundCacheBytes_; //!< Bytes of the loaded sounds.
+		size_t commandQueueDepth_; //!< Commands waiting in the command queue.
+		float updateTime_; //!< Time spent in AudioSystem::Update.
+		unsigned arenaAllocations_; //!< Allocations and reallocations FMOD made in its memory arena during the frame.
+		unsigned arenaFrees_; //!< Blocks FMOD freed in its memory arena during the frame.
+		size_t arenaPeakBytes_; //!< Most bytes of the memory arena committed at once.
+		float arenaFragmentation_; //!< Share of the free bytes of the memory arena outside its largest free run.
+	};
+
+	/**
+	 * \brief Enumeration representing the file formats an AudioStatsHistory can be written as.
+	 */
+	enum class AudioStatsFormat
+	{
+		CSV, //!< One header row, then one row per frame.
+		JSON //!< An array with one object per frame.
+	};
+
+	/**
+	 * \brief Class representing the stats of the most recent frames.
+	 *
+	 * The window is allocated once by SetCapacity, pushing a frame never allocates and overwrites
+	 * the oldest frame once the window is full.
+	 */
+	class AudioStatsHistory
+	{
+	public:
+		/**
+		 * \brief Default constructor for AudioStatsHistory. The history keeps no frames until SetCapacity.
+		 */
+		AudioStatsHistory();
+
+		/**
+		 * \brief Sets the number of frames kept, dropping every frame recorded so far.
+		 * \param frames The number of frames, 0 to stop recording.
+		 */
+		void SetCapacity(size_t frames);
+
+		/**
+		 * \brief Records a frame.
+		 * \param stats The stats of the frame.
+		 */
+		void Push(const AudioStats& stats);
+
+		/**
+		 * \brief Gets the number of frames recorded, at most the capacity.
+		 * \return The number of frames.
+		 */
+		size_t GetCount() const;
+
+		/**
+		 * \brief Writes the recorded frames, oldest first.
+		 * \param path The path of the file to write.
+		 * \param format The file format.
+		 * \return True if the file was written, false otherwise.
+		 */
+		bool Write(const char* path, AudioStatsFormat format) const;
+
+	private:
+		std::vector<AudioStats> frames_; //!< The ring of frames.
+		size_t pushed_; //!< Number of frames pushed since the last SetCapacity, the next one goes at pushed_ % capacity.
+	};
+}
+
+#endif // AUDIO_STATS_H
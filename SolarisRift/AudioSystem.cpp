@@ -16,6 +16,11 @@ COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
 / ======================================================================== */
 
 #include <FMOD/fmod_errors.h>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
 #include <EventSystem.h>
 #include <BuiltInEvents.h>
 #include <GameObject.h>
@@ -29,20 +34,56 @@ COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
 #include <Window.h>
 #include <stdafx.h>
 #include <AudioSystem.h>
+#include <AudioPitch.h>
+#include <FMODAudioBackend.h>
+#include <NullAudioBackend.h>
 #include <Logger.h>
 #include <Utilities.h>
 
 namespace DeckedOut
 {
-	static const char GUID_BANK_ID[] = "bank:/";
-	static const char GUID_EVENT_ID[] = "event:/";
-	static const char GUID_BUS_ID[] = "bus:/";
+	static const char GUID_PARAMETER_ID[] = "parameter:/";
 	static const char GUIDS_PATH[] = "Assets/Audio/Project/Build/GUIDs.txt";
+	static const char AUDIO_MANIFEST_PATH[] = "Assets/Audio/Project/Build/GUIDs.manifest";
 	static const char BANKS_DIRECTORY_PATH[] = "Assets/Audio/Project/Build/Desktop/";
 	static const char BANKS_FILE_EXT[] = ".bank";
 	static constexpr int FMOD_MAX_CHANNELS = 64;
-	static constexpr float OCTAVE_RATIO = 2.0f; //! Frequency ratio of an octave in a 12-tone temperament
-	static constexpr float SEMITONE_RATIO = 1.0595f; //! Frequency ratio of a semitone in 12-tone temperament
+	static constexpr int MAX_BATCHED_PARAMETERS = 32; //! Number of parameters sent to FMOD per setParametersByIDs call
+	static constexpr unsigned MAX_EVENT_POOL_SIZE = 256; //! Largest number of voices an event can play at once
+	static constexpr unsigned MAX_SOUND_VOICES = 4096; //! Number of sounds PlaySound can keep track of at once, at most 65535
+	static constexpr size_t AUDIO_COMMAND_CAPACITY = 4096; //! Number of commands that can be queued between two updates
+	static constexpr float MIN_AUDIO_TICK_RATE = 10.0f; //! Slowest rate the audio update thread can tick at
+	static constexpr float MAX_AUDIO_TICK_RATE = 1000.0f; //! Fastest rate the audio update thread can tick at
+	static constexpr unsigned MAX_ERROR_LOGS_PER_SECOND = 8; //! Number of recorded FMOD errors logged per second, the rest are only counted
+	static constexpr float IDLE_SWEEP_INTERVAL = 1.0f; //! Seconds between two searches for idle event instances
+	static constexpr AudioId MUTE_SNAPSHOT("snapshot:/MuteAllBuses"); //! Snapshot holding the state of the buses saved by MuteAllBuses
+	static constexpr int MAX_EFFECT_CHANNELS = 8; //! Channels an effect is prepared for, a 7.1 mix
+	static const char* const GAME_PARAMETER_PATHS[(int)GameParameter::Count] = { "parameter:/Pausing", "parameter:/Combat", "parameter:/Health" };
+
+	/**
+	 * \brief Hashes a parameter name, ignoring the "parameter:/" prefix used by studio paths.
+	 * \param name The name of the parameter.
+	 * \return The identifier of the parameter.
+	 */
+	static AudioId GetParameterId(const char* name)
+	{
+		size_t prefixLength = sizeof(GUID_PARAMETER_ID) - 1;
+		if (strncmp(name, GUID_PARAMETER_ID, prefixLength) == 0)
+		{
+			name += prefixLength;
+		}
+		return AudioId(name, strlen(name));
+	}
+
+	/**
+	 * \brief Treats the results of a channel that already ended as a success.
+	 * \param result The result of a call made on a channel.
+	 * \return FMOD_OK if the channel ended or was stolen, the result otherwise.
+	 */
+	static FMOD_RESULT IgnoreEndedChannel(FMOD_RESULT result)
+	{
+		return (result == FMOD_ERR_INVALID_HANDLE || result == FMOD_ERR_CHANNEL_STOLEN) ? FMOD_OK : result;
+	}
 
 	ChangeVolumeEvent::ChangeVolumeEvent(const std::string& busName, float volume) :
 		Event("ChangeVolumeEvent"), busName_(busName), volume_(volume)
@@ -52,10 +93,90 @@ namespace DeckedOut
 	AudioSystem::AudioSystem() :
 		DeckedOutObject("AudioSystem"),
 		sounds_(),
-		sys_(nullptr),
-		sysLow_(nullptr),
-		channelGroups_()
+		soundVoices_(MAX_SOUND_VOICES),
+		activeSoundVoices_(),
+		freeSoundVoice_(0),
+		outputRate_(0),
+		mixBlockSamples_(0),
+		pendingSoundVoices_(),
+		soundContainers_(),
+		soundPack_(),
+		soundManifest_(),
+		soundDedupWindow_(0.0f),
+		soundClock_(0.0),
+		soundCacheBudget_(SIZE_MAX),
+		soundCacheBytes_(0),
+		soundCacheTick_(0),
+		soundCacheHits_(0),
+		soundCacheMisses_(0),
+		soundCacheEvictions_(0),
+		pendingPlayPolicy_(PendingPlayPolicy::Queue),
+		soundCullSettings_(),
+		channelGroupVolumes_(),
+		soundGroupVoices_(),
+		soundCullStats_(),
+		lastSoundCullStats_(),
+		residentInstanceCount_(0),
+		banksLoading_(0),
+		studioLoadMode_(StudioLoadMode::Blocking),
+		eventInstanceMode_(EventInstanceMode::Eager),
+		idleInstanceTimeout_(30.0f),
+		audioTime_(0.0f),
+		nextIdleSweepTime_(0.0f),
+		studioReady_(false),
+		gameParameterIds_(),
+		resolvedGameParameters_(0),
+		dirtyGameParameters_(0),
+		mixSnapshots_(),
+		busesMuted_(false),
+		commands_(AUDIO_COMMAND_CAPACITY),
+		reportedCommandOverflows_(0),
+		updateMode_(AudioUpdateMode::GameFrame),
+		tickRate_(60.0f),
+		updateThread_(),
+		audioThreadId_(std::thread::id()),
+		stopUpdateThread_(false),
+		threadStatsMutex_(),
+		studioMutex_(),
+		eventReservationMutex_(),
+		threadStats_(),
+		errorLog_(),
+		audioFrame_(0),
+		loggedErrorCount_(0),
+		errorLogWindowStart_(),
+		errorLogsInWindow_(0),
+		suppressedErrorLogs_(0),
+		stats_(),
+		statsHistory_(),
+		backendKind_(AudioBackendKind::FMOD),
+		outputMode_(AudioOutputMode::Device),
+		outputPath_(),
+		memoryArenaBytes_(0),
+		memoryArena_(),
+		fileIOSettings_(AudioFileIOSettings{ 0, 0 }),
+		fileIO_(),
+		backend_(),
+		channelGroups_(),
+		groupEffects_()
 	{
+		for (int i = 0; i < (int)GameParameter::Count; ++i)
+		{
+			gameParameterValues_[i].store(0.0f, std::memory_order_relaxed);
+		}
+
+		for (int i = 0; i < 3; ++i)
+		{
+			channelGroupVolumes_[i] = 1.0f;
+		}
+
+		// Chain every voice into the free list
+		activeSoundVoices_.reserve(MAX_SOUND_VOICES);
+		for (unsigned i = 0; i < MAX_SOUND_VOICES; ++i)
+		{
+			soundVoices_[i] = SoundVoice();
+			soundVoices_[i].generation_ = 1;
+			soundVoices_[i].slot_ = (uint16_t)(i + 1);
+		}
 	}
 
 	AudioSystem::~AudioSystem()
@@ -65,436 +186,3284 @@ namespace DeckedOut
 
 	void AudioSystem::Initialize()
 	{
-		// Create the FMOD system
+		// Create the backend, FMOD unless a stand-in was asked for
+		if (backendKind_ == AudioBackendKind::Null)
+		{
+			backend_ = std::make_unique<NullAudioBackend>();
+		}
+		else
+		{
+			backend_ = std::make_unique<FMODAudioBackend>();
+		}
+		if (outputMode_ != AudioOutputMode::Device && updateMode_ == AudioUpdateMode::Thread)
+		{
+			// A non-realtime mixer renders a block per tick, it has to follow the calls to Update
+			LogWarning("The audio update thread is not used with a non-realtime output.");
+			updateMode_ = AudioUpdateMode::GameFrame;
+		}
+		if (memoryArenaBytes_ > 0 && memoryArena_ == nullptr)
+		{
+			memoryArena_ = std::make_unique<AudioMemoryArena>(memoryArenaBytes_);
+		}
+		if (memoryArena_ != nullptr)
+		{
+			ReportFMODError(
+				backend_->SetMemoryArena(memoryArena_.get()));
+		}
+		if (fileIOSettings_.threads_ > 0)
+		{
+			fileIO_.Start(fileIOSettings_);
+		}
 		ReportFMODError(
-			FMOD::Studio::System::create(&sys_));
+			backend_->SetFileIO(fileIO_.IsRunning() ? &fileIO_ : nullptr));
+		ReportFMODError(
+			backend_->SetOutput(outputMode_, outputPath_.c_str()));
 #ifdef _DEBUG
 		// Initialize with live-update settings if in debug mode
 		ReportFMODError(
-			sys_->initialize(FMOD_MAX_CHANNELS, FMOD_STUDIO_INIT_LIVEUPDATE, FMOD_INIT_NORMAL, 0));
+			backend_->Initialize(FMOD_MAX_CHANNELS, FMOD_STUDIO_INIT_LIVEUPDATE));
 #endif
 #ifndef _DEBUG
 		// Initialize with normal settings if in release mode
 		ReportFMODError(
-			sys_->initialize(FMOD_MAX_CHANNELS, FMOD_STUDIO_INIT_NORMAL, FMOD_INIT_NORMAL, 0));
+			backend_->Initialize(FMOD_MAX_CHANNELS, FMOD_STUDIO_INIT_NORMAL));
 #endif
-		// Access the the low-level system API
-		ReportFMODError(
-			sys_->getCoreSystem(&sysLow_));
 		// Access the master channel group
 		ReportFMODError(
-			sysLow_->getMasterChannelGroup(&channelGroups_[(int)AudioChannelGroup::Master]));
+			backend_->GetMasterChannelGroup(&channelGroups_[(int)AudioChannelGroup::Master]));
 		// Create a sound effects channel
 		ReportFMODError(
-			sysLow_->createChannelGroup("Sound", &channelGroups_[(int)AudioChannelGroup::Sound]));
+			backend_->CreateChannelGroup("Sound", &channelGroups_[(int)AudioChannelGroup::Sound]));
 		// Create a streamed audio channel
 		ReportFMODError(
-			sysLow_->createChannelGroup("Stream", &channelGroups_[(int)AudioChannelGroup::Stream]));
+			backend_->CreateChannelGroup("Stream", &channelGroups_[(int)AudioChannelGroup::Stream]));
+		// Read the mixer rate used to schedule fades
+		ReportFMODError(
+			backend_->GetOutputRate(&outputRate_));
+		int mixBlockCount;
+		ReportFMODError(
+			backend_->GetDSPBufferSize(&mixBlockSamples_, &mixBlockCount));
 
-		InitializeStudio();
+		InitializeStudio(studioLoadMode_);
 
 		unsigned int ver;
-		sysLow_->getVersion(&ver);
+		backend_->GetVersion(&ver);
 		// Initialize the event systems.
 		EventSystem::ConnectEvent(this, this, "ChangeVolumeEvent", &AudioSystem::HandleVolumeEvent);
 		EventSystem::ConnectEvent(&InputManager::Instance(), this, "KeyTriggered", &AudioSystem::OnKeyTriggered);
 		EventSystem::ConnectEvent(&SpaceManager::Instance(), this, "PauseScreenClosed", &AudioSystem::OnPauseScreenClosed);
+
+		if (updateMode_ == AudioUpdateMode::Thread)
+		{
+			stopUpdateThread_ = false;
+			threadStats_ = AudioThreadStats();
+			threadStats_.tickRate_ = tickRate_;
+			updateThread_ = std::thread(&AudioSystem::RunUpdateThread, this);
+			audioThreadId_.store(updateThread_.get_id(), std::memory_order_release);
+		}
 	}
 	
-	void AudioSystem::InitializeStudio()
+	void AudioSystem::InitializeStudio(StudioLoadMode mode)
 	{
-		std::ifstream guidsFile(GUIDS_PATH);
-		std::string line;
+		FMOD_STUDIO_LOAD_BANK_FLAGS loadFlags = (mode == StudioLoadMode::Async) ?
+			FMOD_STUDIO_LOAD_BANK_NONBLOCKING : FMOD_STUDIO_LOAD_BANK_NORMAL;
+
+		studioReady_ = false;
+		studioLoadStart_ = std::chrono::steady_clock::now();
 
-		if (guidsFile.is_open())
+		// Map the cooked manifest, falling back to GUIDs.txt when it is missing or stale
+		if (!manifest_.LoadCooked(AUDIO_MANIFEST_PATH, GUIDS_PATH))
 		{
-			while (std::getline(guidsFile, line))
+			if (manifest_.LoadText(GUIDS_PATH))
 			{
-				// Skip the unique identifier, advance to the named portion
-				size_t begin = line.find('}') + 2;
-				line = line.substr(begin);
-
-				if (line.find(GUID_BANK_ID) != std::string::npos)
-				{
-					CreateBankPathFromGUID(line);
-					FMOD::Studio::Bank* bank;
-					ReportFMODError(
-						sys_->loadBankFile(line.c_str(), FMOD_STUDIO_LOAD_BANK_NORMAL, &bank));
-					banks_[line] = bank;
-				}
+#ifdef _DEBUG
+				// Re-cook so the next run can map the manifest directly
+				manifest_.Write(AUDIO_MANIFEST_PATH, GUIDS_PATH);
+#endif
+			}
+			else
+			{
+				LogCritical("Invalid GUIDs file");
+			}
+		}
 
-				if (line.find(GUID_EVENT_ID) != std::string::npos)
-				{
-					// Load the event description
-					FMOD::Studio::EventDescription* eventDescription;
-					sys_->getEvent(line.c_str(), &eventDescription);
-					eventDescriptions_[line] = eventDescription;
-
-					// Load the event instance
-					FMOD::Studio::EventInstance* eventInstance;
-					eventDescriptions_[line]->createInstance(&eventInstance);
-					eventInstances_[line] = eventInstance;
-				}
+		const AudioManifestEntry* bank = manifest_.Begin(AudioManifestKind::Bank);
+		for (size_t i = 0; i < manifest_.Count(AudioManifestKind::Bank); ++i, ++bank)
+		{
+			std::string path = manifest_.GetName(*bank);
+			CreateBankPathFromGUID(path);
+			LoadBank(path, loadFlags);
+		}
 
-				if (line.find(GUID_BUS_ID) != std::string::npos)
-				{
-					// Load the bus
-					FMOD::Studio::Bus* bus;
-					sys_->getBus(line.c_str(), &bus);
-					buses_[line] = bus;
-				}
-			}
+		// Events and buses can only be resolved once every bank is loaded. Blocking loads are
+		// already done, async loads are polled from Update until they finish
+		if (mode == StudioLoadMode::Blocking)
+		{
+			ResolveStudioObjects();
 		}
 		else
 		{
-			LogCritical("Invalid GUIDs file");
+			PollBankLoading();
 		}
-		guidsFile.close();
 	}
 
-	void AudioSystem::Update(float dt)
+	void AudioSystem::LoadBank(const std::string& path, FMOD_STUDIO_LOAD_BANK_FLAGS flags)
 	{
-		UNREFERENCED_PARAMETER(dt);
+		auto issued = std::chrono::steady_clock::now();
+		FMOD::Studio::Bank* bank;
 		ReportFMODError(
-			sys_->update());
-	}
+			backend_->LoadBankFile(path.c_str(), flags, &bank));
+		banks_[path] = bank;
 
-	void AudioSystem::Shutdown()
-	{
-		// Release all sounds
-		auto sounds_it = sounds_.begin();
-		while (sounds_it != sounds_.end())
+		BankLoadReport report;
+		report.path_ = path;
+		report.seconds_ = 0.0f;
+		report.state_ = FMOD_STUDIO_LOADING_STATE_LOADING;
+		if (!(flags & FMOD_STUDIO_LOAD_BANK_NONBLOCKING))
 		{
-			ReportFMODError(
-				sounds_it->second->release());
-			sounds_it->second = nullptr;
-			sounds_it++;
+			report.seconds_ = std::chrono::duration<float>(std::chrono::steady_clock::now() - issued).count();
+			report.state_ = FMOD_STUDIO_LOADING_STATE_LOADED;
 		}
+		else
+		{
+			++banksLoading_;
+		}
+		loadingBanks_.push_back(bank);
+		bankLoadReports_.push_back(report);
+	}
 
-		// Release all event descriptions/instances
-		auto eventDescriptions_it = eventDescriptions_.begin();
-		while (eventDescriptions_it != eventDescriptions_.end())
+	void AudioSystem::PollBankLoading()
+	{
+		float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - studioLoadStart_).count();
+		for (size_t i = 0; i < loadingBanks_.size(); ++i)
 		{
-			if (eventDescriptions_it->second != nullptr)
+			BankLoadReport& report = bankLoadReports_[i];
+			if (report.state_ != FMOD_STUDIO_LOADING_STATE_LOADING)
+			{
+				continue;
+			}
+
+			// A failed load is reported through the result of getLoadingState
+			FMOD_STUDIO_LOADING_STATE state;
+			if (backend_->GetBankLoadingState(loadingBanks_[i], &state) != FMOD_OK)
+			{
+				state = FMOD_STUDIO_LOADING_STATE_ERROR;
+			}
+
+			if (state == FMOD_STUDIO_LOADING_STATE_LOADED || state == FMOD_STUDIO_LOADING_STATE_ERROR)
 			{
-				ReportFMODError(
-					eventDescriptions_it->second->releaseAllInstances());
+				report.state_ = state;
+				report.seconds_ = elapsed;
+				--banksLoading_;
+				if (state == FMOD_STUDIO_LOADING_STATE_ERROR)
+				{
+					LogCritical("Failed to load the FMOD studio bank '", report.path_, "'");
+				}
 			}
-			eventDescriptions_it->second = nullptr;
-			eventDescriptions_it++;
 		}
 
-		// Release all banks
-		auto banks_it = banks_.begin();
-		while (banks_it != banks_.end())
+		if (banksLoading_ == 0)
 		{
-			ReportFMODError(
-				banks_it->second->unload());
-			banks_it->second = nullptr;
-			banks_it++;
+			ResolveStudioObjects();
 		}
-		
-		ReportFMODError(
-			sysLow_->release());
 	}
-	
-	void AudioSystem::LoadSound(const std::string& filename, bool loop, bool stream)
+
+	void AudioSystem::ResolveStudioObjects()
 	{
-		if (SoundIsLoaded(filename))
+		// Reservations read the event table, which is unsorted until Build
+		std::unique_lock<std::mutex> lock = LockEventReservations();
+		size_t eventCount = manifest_.Count(AudioManifestKind::Event);
+		size_t busCount = manifest_.Count(AudioManifestKind::Bus);
+		events_.reserve(events_.size() + eventCount);
+		eventVoices_.reserve(eventVoices_.size() + eventCount);
+		residentEvents_.reserve(events_.size() + eventCount);
+		eventIndices_.Reserve(eventIndices_.Size() + eventCount);
+		buses_.Reserve(buses_.Size() + busCount);
+
+		const AudioManifestEntry* event = manifest_.Begin(AudioManifestKind::Event);
+		for (size_t i = 0; i < eventCount; ++i, ++event)
 		{
-			return;
+			ResolveEvent(AudioManifest::GetId(*event), manifest_.GetName(*event));
 		}
 
-		FMOD_MODE mode = FMOD_DEFAULT;
-		mode |= loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
-		mode |= stream ? FMOD_CREATESTREAM : FMOD_CREATECOMPRESSEDSAMPLE;
-
-		FMOD::Sound* sound = nullptr;
-		ReportFMODError(
-			sysLow_->createSound(filename.c_str(), mode, nullptr, &sound));
-		if (sound)
+		const AudioManifestEntry* bus = manifest_.Begin(AudioManifestKind::Bus);
+		for (size_t i = 0; i < busCount; ++i, ++bus)
 		{
-			sounds_[filename] = sound;
+			// Load the bus
+			FMOD::Studio::Bus* studioBus = nullptr;
+			backend_->GetBus(manifest_.GetName(*bus), &studioBus);
+			buses_.Insert(AudioManifest::GetId(*bus), studioBus);
 		}
-	}
 
-	void AudioSystem::UnloadSound(const std::string& filename)
-	{
-		if (sounds_.find(filename) == sounds_.end())
+		// The paths are only needed to resolve the studio objects
+		manifest_.Unload();
+
+		// Sort the lookup tables, a failure here means two paths share a hash
+		if (!eventIndices_.Build())
 		{
-			LogWarning("Tried to unload the sound '", filename, "', but this sound had never been loaded.");
-			return;
+			LogCritical("AudioId collision between two FMOD studio events");
+		}
+		if (!buses_.Build())
+		{
+			LogCritical("AudioId collision between two FMOD studio buses");
 		}
+		mixSnapshots_.Reset(buses_.Size());
+		busesMuted_ = false;
 
-		ReportFMODError(
-			sounds_[filename]->release());
-		sounds_.erase(filename);
+		ResolveGameParameters();
+		studioReady_ = true;
 	}
 
-	bool AudioSystem::SoundIsLoaded(const std::string& filename) const
+	void AudioSystem::ResolveEvent(AudioId id, const char* path)
 	{
-		return (sounds_.find(filename) != sounds_.end());
-	}
+		// Every event starts with a single voice, SetEventPoolSize grows the pool
+		EventRecord record = {};
+		record.id_ = id;
+		record.firstVoice_ = AllocateEventVoices(1);
+		record.voiceCount_ = 1;
+		record.stealMode_ = EventStealMode::Oldest;
 
-	FMOD::Channel* AudioSystem::PlaySound(const std::string& filename, float volume, float pitch)
-	{
-		FMOD::Sound* sound = sounds_[filename];
-		FMOD_MODE mode;
-		ReportFMODError(
-			sound->getMode(&mode));
-		FMOD::ChannelGroup* channelGroup = (mode - FMOD_CREATESTREAM - FMOD_LOOP_NORMAL == FMOD_DEFAULT) ?
-			channelGroups_[(int)AudioChannelGroup::Stream] : channelGroups_[(int)AudioChannelGroup::Sound];
-		FMOD::Channel* channel;
-		float frequency, newFrequency;
+		// Load the event description
+		backend_->GetEvent(path, &record.description_);
 
-		ReportFMODError(
-			sysLow_->playSound(sound, channelGroup, true, &channel));
-		ReportFMODError(
-			channel->setVolume(volume));
-		ReportFMODError(
-			channel->getFrequency(&frequency));
-		newFrequency = ChangeSemitone(frequency, pitch);
-		ReportFMODError(
-			channel->setFrequency(newFrequency));
-		ReportFMODError(
-			channel->setPaused(false));
+		// Cache the parameter ids so they are never resolved by name at runtime
+		CacheEventParameters(record);
 
-		return channel;
-	}
+		eventIndices_.Insert(record.id_, (unsigned)events_.size());
+		events_.push_back(record);
 
-	void AudioSystem::PlayEvent(const std::string& event)
-	{
-		if (eventInstances_.find(event) != eventInstances_.end())
-		{
-			ReportFMODError(
-				eventInstances_[event]->start());
-		}
-		else
+		// Load the event instance, lazy instances are created on first use instead
+		if (eventInstanceMode_ == EventInstanceMode::Eager)
 		{
-			const char* eventWarning = "Tried to play an unknown FMOD studio event.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			CreateVoiceInstance(events_.back(), 0);
 		}
 	}
 
-	void AudioSystem::StopEvent(const std::string& event)
+	void AudioSystem::ResolveGameParameters()
 	{
-		if (eventInstances_.find(event) != eventInstances_.end())
-		{
-			ReportFMODError(
-				eventInstances_[event]->stop(FMOD_STUDIO_STOP_IMMEDIATE));
-		}
-		else
+		resolvedGameParameters_ = 0;
+		for (int i = 0; i < (int)GameParameter::Count; ++i)
 		{
-			const char* eventWarning = "Tried to stop an unknown FMOD studio event.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			FMOD_STUDIO_PARAMETER_DESCRIPTION description;
+			if (backend_->GetGlobalParameterDescription(GAME_PARAMETER_PATHS[i], &description) == FMOD_OK)
+			{
+				gameParameterIds_[i] = description.id;
+				resolvedGameParameters_ |= 1u << i;
+			}
+			else
+			{
+				LogWarning("The FMOD studio project has no global parameter '", GAME_PARAMETER_PATHS[i], "'.");
+			}
 		}
 	}
 
-	void AudioSystem::StopAllEvents()
+	void AudioSystem::FlushGameParameters()
 	{
-		for (auto it = eventInstances_.begin(); it != eventInstances_.end(); ++it)
+		uint32_t dirty = dirtyGameParameters_.exchange(0, std::memory_order_acquire) & resolvedGameParameters_;
+		if (dirty == 0)
+		{
+			return;
+		}
+
+		FMOD_STUDIO_PARAMETER_ID ids[(int)GameParameter::Count];
+		float values[(int)GameParameter::Count];
+		int count = 0;
+		for (int i = 0; i < (int)GameParameter::Count; ++i)
 		{
-			if (it->second != nullptr)
+			if (dirty & (1u << i))
 			{
-				ReportFMODError(
-					it->second->stop(FMOD_STUDIO_STOP_IMMEDIATE));
+				ids[count] = gameParameterIds_[i];
+				values[count] = gameParameterValues_[i].load(std::memory_order_relaxed);
+				++count;
 			}
 		}
+		CheckFMODResult(
+			backend_->SetGlobalParameters(ids, values, count), __func__);
 	}
 
-	void AudioSystem::SetEventParameter(const std::string& event, const std::string& parameter, float value)
+	void AudioSystem::SetStudioLoadMode(StudioLoadMode mode)
 	{
-		if (eventInstances_.find(event) != eventInstances_.end())
-		{
-			ReportFMODError(
-				eventInstances_[event]->setParameterByName(parameter.c_str(), value));
-			
-		}
-		else
-		{
-			const char* eventWarning = "Tried to play an unknown FMOD studio event.";
-			LogWarning(eventWarning);
-			//throw std::exception(eventWarning);
-		}
+		studioLoadMode_ = mode;
 	}
 
-	bool AudioSystem::GetEventPlaying(const std::string& event)
+	bool AudioSystem::IsStudioReady() const
 	{
-		if (eventInstances_.find(event) != eventInstances_.end())
-		{
-			FMOD_STUDIO_PLAYBACK_STATE state;
-			ReportFMODError(
-				eventInstances_[event]->getPlaybackState(&state));
-			return (state != FMOD_STUDIO_PLAYBACK_STOPPED);
+		return studioReady_;
+	}
 
+	float AudioSystem::GetStudioLoadProgress() const
+	{
+		if (studioReady_)
+		{
+			return 1.0f;
 		}
-		else
+		if (bankLoadReports_.empty())
 		{
-			const char* eventWarning = "Tried to get data about an unknown FMOD studio event.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			return 0.0f;
 		}
+		return (float)(bankLoadReports_.size() - banksLoading_) / (float)bankLoadReports_.size();
 	}
 
-	void AudioSystem::SetChannelGroupVolume(AudioChannelGroup channelGroup, float volume)
+	const std::vector<BankLoadReport>& AudioSystem::GetBankLoadReports() const
 	{
-		volume = Clamp(volume, 0.0f, 1.0f);
-		channelGroups_[(int)channelGroup]->setVolume(volume);
+		return bankLoadReports_;
 	}
 
-	void AudioSystem::SetBusVolume(const std::string& bus, float volume)
+	void AudioSystem::Update(float dt)
 	{
-		if (buses_.find(bus) != buses_.end())
-		{
-			volume = Clamp(volume, 0.0f, 1.0f);
-			buses_[bus]->setVolume(volume);
-		}
-		else
+		auto updateStart = std::chrono::steady_clock::now();
+		if (updateMode_ == AudioUpdateMode::GameFrame)
 		{
-			const char* eventWarning = "Tried to modify an unkown FMOD studio bus.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			Tick(dt);
 		}
+
+		// The sound cache belongs to the game thread in either mode
+		soundClock_ += dt;
+		UpdateSoundChannels();
+		UpdateSoundLoads();
+		StartSoundVoices();
+		lastSoundCullStats_ = soundCullStats_;
+		soundCullStats_.fill(SoundCullStats());
+		LogRecordedErrors();
+		CollectAudioStats(std::chrono::duration<float>(std::chrono::steady_clock::now() - updateStart).count());
 	}
 
-	float AudioSystem::GetBusVolume(const std::string& bus)
+	void AudioSystem::Shutdown()
 	{
-		float volume = -1.0f;
-		if (buses_.find(bus) != buses_.end())
-		{
-			buses_[bus]->getVolume(&volume);
-		}
-		else
+		// Stop the update thread before releasing anything it ticks
+		if (updateThread_.joinable())
 		{
-			const char* eventWarning = "Tried to read data from an unkown FMOD studio bus.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			stopUpdateThread_ = true;
+			updateThread_.join();
+			audioThreadId_.store(std::thread::id(), std::memory_order_release);
 		}
-		return volume;
-	}
 
-	void AudioSystem::SetBusPaused(const std::string& bus, bool pause)
-	{
-		if (buses_.find(bus) != buses_.end())
+		// Release all sounds
+		auto sounds_it = sounds_.begin();
+		while (sounds_it != sounds_.end())
 		{
-			bool paused;
-			buses_[bus]->getPaused(&paused);
-			if (paused != pause)
+			if (sounds_it->second.sound_ != nullptr)
 			{
-				buses_[bus]->setPaused(pause);
+				CheckFMODResult(
+					backend_->ReleaseSound(sounds_it->second.sound_), __func__);
 			}
+			sounds_it->second.sound_ = nullptr;
+			sounds_it++;
 		}
-		else
+		while (!activeSoundVoices_.empty())
 		{
-			const char* eventWarning = "Tried to modify an unkown FMOD studio bus.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			FreeSoundVoice(activeSoundVoices_.back());
 		}
-	}
-
-	bool AudioSystem::GetBusPaused(const std::string& bus)
-	{
-		bool paused = false;
-		if (buses_.find(bus) != buses_.end())
+		for (PendingSoundLoad& load : pendingSoundLoads_)
 		{
-			buses_[bus]->getPaused(&paused);
+			load.status_->state_ = SoundLoadState::Failed;
 		}
-		else
+		pendingSoundLoads_.clear();
+		queuedSoundPlays_.clear();
+		pendingSoundVoices_.clear();
+		soundPack_.Close();
+		soundManifest_.Unload();
+		soundCacheBytes_ = 0;
+
+		// Release all event descriptions/instances
+		auto events_it = events_.begin();
+		while (events_it != events_.end())
 		{
-			const char* eventWarning = "Tried to read data from an unkown FMOD studio bus.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			if (events_it->description_ != nullptr)
+			{
+				CheckFMODResult(
+					backend_->ReleaseAllInstances(events_it->description_), __func__);
+			}
+			events_it->description_ = nullptr;
+			events_it->createdVoices_ = 0;
+			events_it++;
 		}
-		return paused;
-	}
+		eventVoices_.clear();
+		freeEventVoices_.clear();
+		residentEvents_.clear();
+		prefetchedEvents_.clear();
+		residentInstanceCount_ = 0;
 
-	void AudioSystem::BusStopAllEvents(const std::string& bus)
-	{
-		if (buses_.find(bus) != buses_.end())
+		// Release all banks
+		auto banks_it = banks_.begin();
+		while (banks_it != banks_.end())
+		{
+			CheckFMODResult(
+				backend_->UnloadBank(banks_it->second), __func__);
+			banks_it->second = nullptr;
+			banks_it++;
+		}
+		
+		// Release the effects, whose DSPs call into them until removed
+		for (int i = 0; i < 3; ++i)
 		{
-			buses_[bus]->stopAllEvents(FMOD_STUDIO_STOP_IMMEDIATE);
+			DetachEffects((AudioChannelGroup)i);
 		}
-		else
+
+		CheckFMODResult(
+			backend_->Release(), __func__);
+		backend_.reset();
+		fileIO_.Stop();
+		if (memoryArena_ != nullptr)
 		{
-			const char* eventWarning = "Tried to modify an unkown FMOD studio bus.";
-			LogWarning(eventWarning);
-			throw std::exception(eventWarning);
+			// Every block still live was leaked by whatever was loaded during the run
+			AudioMemoryStats memory = memoryArena_->GetStats();
+			if (memory.liveAllocations_ > 0)
+			{
+				LogWarning("FMOD left ", memory.liveAllocations_, " allocations of ", memory.usedBytes_,
+					" bytes in the audio memory arena after shutting down.");
+			}
 		}
+		LogRecordedErrors();
 	}
 
-	AudioSystem& AudioSystem::Instance()
+	void AudioSystem::SetAudioBackend(AudioBackendKind kind)
 	{
-        static AudioSystem audioSystem;
-		return audioSystem;
+		backendKind_ = kind;
 	}
 
-	void AudioSystem::ReportFMODError(FMOD_RESULT err)
+	AudioBackend* AudioSystem::GetAudioBackend() const
 	{
-		if (err != FMOD_OK)
-		{
-			const char* FMODError = FMOD_ErrorString(err);
-			LogCritical("FMOD ERROR: ", FMODError);
-			throw std::exception(FMODError);
-		}
+		return backend_.get();
 	}
 
-	void AudioSystem::CreateBankPathFromGUID(std::string& guid)
+	void AudioSystem::SetOutputMode(AudioOutputMode mode, const std::string& wavPath)
 	{
-		size_t pathSuffix = guid.find_last_of('/') + 1;
-		guid = BANKS_DIRECTORY_PATH + guid.substr(pathSuffix) + BANKS_FILE_EXT;
+		outputMode_ = mode;
+		outputPath_ = wavPath;
 	}
 
-	float AudioSystem::ChangeOctave(float frequency, float variation)
+	float AudioSystem::GetMixBlockLength() const
 	{
-		return frequency * pow(OCTAVE_RATIO, variation);
+		return (outputRate_ > 0) ? (float)mixBlockSamples_ / outputRate_ : 0.0f;
 	}
 
-	float AudioSystem::ChangeSemitone(float frequency, float variation)
+	void AudioSystem::SetAudioMemoryArena(size_t bytes)
+	{
+		if (memoryArena_ != nullptr)
+		{
+			LogWarning("The audio memory arena was already created, its size cannot change.");
+			return;
+		}
+		memoryArenaBytes_ = bytes;
+	}
+
+	AudioMemoryStats AudioSystem::GetAudioMemoryStats() const
 	{
-		return frequency * pow(SEMITONE_RATIO, variation);
+		return (memoryArena_ != nullptr) ? memoryArena_->GetStats() : AudioMemoryStats();
 	}
 
-	void AudioSystem::OnKeyTriggered(const KeyboardButtonEvent* event)
+	void AudioSystem::ResetAudioMemoryPeaks()
 	{
-		if (event->key_ == InputManager::InputButton::KEY_ESCAPE)
+		if (memoryArena_ != nullptr)
 		{
-			SetEventParameter("event:/MUSIC/ForestMap/AdaptiveForestMusic", "parameter:/Pausing", 1.0f);
-			SetEventParameter("event:/MUSIC/BossMap/Boss Music", "parameter:/Pausing", 1.0f);
+			memoryArena_->ResetPeaks();
 		}
 	}
 
-	void AudioSystem::OnPauseScreenClosed(const NamedEvent* event)
+	void AudioSystem::SetAudioFileIO(const AudioFileIOSettings& settings)
 	{
-		UNREFERENCED_PARAMETER(event);
-		SetEventParameter("event:/MUSIC/ForestMap/AdaptiveForestMusic", "parameter:/Pausing", 0.0f);
-		SetEventParameter("event:/MUSIC/BossMap/Boss Music", "parameter:/Pausing", 0.0f);
+		fileIOSettings_ = settings;
 	}
 
-	void AudioSystem::MuteAllBuses()
+	AudioFileIOStats AudioSystem::GetAudioFileIOStats() const
 	{
-		for (auto bus = buses_.begin(); bus != buses_.end(); ++bus)
+		return fileIO_.GetStats();
+	}
+	
+	void AudioSystem::LoadSound(const std::string& filename, bool loop, bool stream)
+	{
+		SoundCacheEntry& entry = sounds_[filename];
+		entry.lastUsed_ = ++soundCacheTick_;
+		if (entry.sound_ != nullptr)
 		{
-			float volume = 0.0f;
-			bus->second->getVolume(&volume);
-			busVolumes_.push(std::make_pair(bus->first, volume));
-			bus->second->setVolume(0.0f);
+			return;
+		}
+
+		FMOD_MODE mode = FMOD_DEFAULT;
+		mode |= loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
+		mode |= GetSoundDecodeMode(filename, stream);
+
+		FMOD::Sound* sound = nullptr;
+		CheckFMODResult(
+			OpenSound(filename, mode, entry, &sound), __func__, AudioId(filename));
+		entry.failed_ = (sound == nullptr);
+		if (sound)
+		{
+			entry.sound_ = sound;
+			entry.loop_ = loop;
+			entry.stream_ = (mode & FMOD_CREATESTREAM) != 0;
+			entry.bytes_ = MeasureSound(sound);
+			soundCacheBytes_ += entry.bytes_;
+			EnforceSoundCacheBudget(&entry);
 		}
 	}
 
-	void AudioSystem::UnmuteAllBuses()
+	SoundLoadHandle AudioSystem::LoadSoundAsync(const std::string& filename, bool loop, bool stream)
 	{
-		while (!busVolumes_.empty())
+		SoundLoadHandle handle;
+		SoundCacheEntry& entry = sounds_[filename];
+		entry.lastUsed_ = ++soundCacheTick_;
+		if (entry.sound_ != nullptr)
+		{
+			// Share the progress of a load that is already in flight
+			for (PendingSoundLoad& load : pendingSoundLoads_)
+			{
+				if (load.entry_ == &entry)
+				{
+					handle.status_ = load.status_;
+					return handle;
+				}
+			}
+			handle.status_ = std::make_shared<SoundLoadStatus>();
+			handle.status_->state_ = SoundLoadState::Ready;
+			return handle;
+		}
+
+		FMOD_MODE mode = FMOD_NONBLOCKING;
+		mode |= loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
+		mode |= GetSoundDecodeMode(filename, stream);
+
+		FMOD::Sound* sound = nullptr;
+		CheckFMODResult(
+			OpenSound(filename, mode, entry, &sound), __func__, AudioId(filename));
+		handle.status_ = std::make_shared<SoundLoadStatus>();
+		entry.failed_ = (sound == nullptr);
+		if (sound == nullptr)
 		{
-			std::pair<std::string, float> busVolume = busVolumes_.top();
-			buses_[busVolume.first]->setVolume(busVolume.second);
-			busVolumes_.pop();
+			handle.status_->state_ = SoundLoadState::Failed;
+			return handle;
 		}
+
+		// The size is charged to the cache once the sound has opened
+		entry.sound_ = sound;
+		entry.loop_ = loop;
+		entry.stream_ = (mode & FMOD_CREATESTREAM) != 0;
+		entry.loading_ = true;
+		entry.bytes_ = 0;
+
+		PendingSoundLoad load;
+		load.status_ = handle.status_;
+		load.entry_ = &entry;
+		load.id_ = AudioId(filename);
+		pendingSoundLoads_.push_back(load);
+		return handle;
 	}
 
-	void AudioSystem::HandleVolumeEvent(const ChangeVolumeEvent* event)
+	SoundLoadState AudioSystem::GetSoundLoadState(const SoundLoadHandle& handle) const
 	{
-		SetBusVolume(event->busName_, event->volume_);
+		return handle.IsValid() ? handle.status_->state_ : SoundLoadState::Failed;
+	}
+
+	bool AudioSystem::WaitForSoundLoad(const SoundLoadHandle& handle, float timeout)
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<float>(timeout);
+		while (GetSoundLoadState(handle) == SoundLoadState::Loading)
+		{
+			UpdateSoundLoads();
+			if (GetSoundLoadState(handle) != SoundLoadState::Loading || std::chrono::steady_clock::now() >= deadline)
+			{
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return GetSoundLoadState(handle) == SoundLoadState::Ready;
+	}
+
+	void AudioSystem::SetPendingPlayPolicy(PendingPlayPolicy policy)
+	{
+		pendingPlayPolicy_ = policy;
+	}
+
+	void AudioSystem::UnloadSound(const std::string& filename)
+	{
+		auto it = sounds_.find(filename);
+		if (it == sounds_.end())
+		{
+			LogWarning("Tried to unload the sound '", filename, "', but this sound had never been loaded.");
+			return;
+		}
+
+		// Forget everything referring to the sound before its entry goes away
+		ForgetSound(it->second);
+
+		if (it->second.sound_ != nullptr)
+		{
+			CheckFMODResult(
+				backend_->ReleaseSound(it->second.sound_), __func__, AudioId(filename));
+			soundCacheBytes_ -= it->second.bytes_;
+		}
+		sounds_.erase(it);
+	}
+
+	bool AudioSystem::MountSoundPack(const std::string& path)
+	{
+		UnmountSoundPack();
+		if (!soundPack_.Open(path.c_str()))
+		{
+			LogWarning("Failed to mount the sound pack '", path, "', sounds will be loaded from their files.");
+			return false;
+		}
+		return true;
+	}
+
+	void AudioSystem::UnmountSoundPack()
+	{
+		// The sounds opened from the pack read from its mapping, so they go before it does
+		for (auto& sound : sounds_)
+		{
+			SoundCacheEntry& entry = sound.second;
+			if (!entry.packed_ || entry.sound_ == nullptr)
+			{
+				continue;
+			}
+			ForgetSound(entry);
+			CheckFMODResult(
+				backend_->ReleaseSound(entry.sound_), __func__, AudioId(sound.first));
+			soundCacheBytes_ -= entry.bytes_;
+			entry.sound_ = nullptr;
+			entry.bytes_ = 0;
+			entry.loading_ = false;
+			entry.packed_ = false;
+		}
+		soundPack_.Close();
+	}
+
+	bool AudioSystem::LoadSoundManifest(const std::string& path)
+	{
+		if (!soundManifest_.Load(path.c_str()))
+		{
+			LogWarning("Failed to load the sound manifest '", path, "', sounds will load with the flags they are given.");
+			return false;
+		}
+		return true;
+	}
+
+	bool AudioSystem::WriteSoundPlayProfile(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file.is_open())
+		{
+			LogWarning("Failed to write the sound play profile '", path, "'.");
+			return false;
+		}
+
+		file << "seconds " << soundClock_ << '\n';
+		for (const auto& sound : sounds_)
+		{
+			if (sound.second.plays_ > 0)
+			{
+				file << sound.second.plays_ << ' ' << sound.first << '\n';
+			}
+		}
+		return file.good();
+	}
+
+	bool AudioSystem::SoundIsLoaded(const std::string& filename) const
+	{
+		auto it = sounds_.find(filename);
+		return (it != sounds_.end() && it->second.sound_ != nullptr && !it->second.loading_);
+	}
+
+	void AudioSystem::SetSoundCacheBudget(size_t bytes)
+	{
+		soundCacheBudget_ = bytes;
+		EnforceSoundCacheBudget(nullptr);
+	}
+
+	SoundCacheStats AudioSystem::GetSoundCacheStats() const
+	{
+		SoundCacheStats stats;
+		stats.budgetBytes_ = soundCacheBudget_;
+		stats.residentBytes_ = soundCacheBytes_;
+		stats.residentSounds_ = 0;
+		for (auto it = sounds_.begin(); it != sounds_.end(); ++it)
+		{
+			stats.residentSounds_ += (it->second.sound_ != nullptr && !it->second.loading_) ? 1 : 0;
+		}
+		stats.hits_ = soundCacheHits_;
+		stats.misses_ = soundCacheMisses_;
+		stats.evictions_ = soundCacheEvictions_;
+		return stats;
+	}
+
+	SoundHandle AudioSystem::PlaySound(const std::string& filename, float volume, float pitch, AudioId tag)
+	{
+		SoundPlayParams params;
+		params.volume_ = volume;
+		params.pitch_ = pitch;
+		params.tag_ = tag;
+		return PlaySound(filename, params);
+	}
+
+	SoundHandle AudioSystem::PlaySound(const std::string& filename, const SoundPlayParams& params)
+	{
+		SoundHandle merged = MergeSoundPlay(filename, params);
+		if (merged.IsValid())
+		{
+			return merged;
+		}
+
+		// Cull before the sound is loaded or any channel is touched
+		AudioChannelGroup group = GetSoundGroup(filename);
+		SoundCullStats& stats = soundCullStats_[(int)group];
+		float attenuation = GetDistanceAttenuation(group, params.distance_);
+		float audibility = EstimateAudibility(group, params.volume_ * attenuation);
+		if (audibility < soundCullSettings_[(int)group].minAudibility_)
+		{
+			++stats.culledInaudible_;
+			return SoundHandle();
+		}
+		unsigned victims[2];
+		if (!SelectSoundVictims(group, params.priority_, audibility, victims))
+		{
+			++stats.culledByCap_;
+			return SoundHandle();
+		}
+
+		SoundCacheEntry* entry = AcquireSound(filename);
+		if (entry == nullptr)
+		{
+			LogWarning("Tried to play the sound '", filename, "', but it could not be loaded.");
+			return SoundHandle();
+		}
+		if (entry->loading_ && pendingPlayPolicy_ == PendingPlayPolicy::Drop)
+		{
+			return SoundHandle();
+		}
+
+		// Only a play that is going ahead takes the voices it needs
+		for (unsigned victim : victims)
+		{
+			if (victim != soundVoices_.size())
+			{
+				StealSoundVoice(victim);
+			}
+		}
+
+		unsigned index = AllocateSoundVoice(group);
+		if (index == soundVoices_.size())
+		{
+			CheckFMODResult(FMOD_ERR_CHANNEL_ALLOC, __func__, AudioId(filename));
+			return SoundHandle();
+		}
+
+		// The voice pins the sound in the cache until it is freed
+		SoundVoice& voice = soundVoices_[index];
+		voice.channel_ = nullptr;
+		voice.entry_ = entry;
+		voice.tag_ = params.tag_;
+		voice.volume_ = params.volume_;
+		voice.pitch_ = CentsToPitchRatio(SemitonesToCents(params.pitch_));
+		voice.priority_ = params.priority_;
+		voice.attenuation_ = attenuation;
+		voice.pending_ = !entry->loading_;
+		++entry->playing_;
+
+		// Channels are started together by Update, or once the sound finishes loading
+		SoundHandle handle = GetSoundHandle(index);
+		if (entry->loading_)
+		{
+			queuedSoundPlays_.push_back(handle);
+		}
+		else
+		{
+			pendingSoundVoices_.push_back(handle);
+		}
+		entry->lastPlay_ = handle;
+		entry->lastPlayTime_ = soundClock_;
+		++entry->plays_;
+		++stats.played_;
+		return handle;
+	}
+
+	void AudioSystem::SetSoundContainer(AudioId container, const SoundContainerDesc& desc)
+	{
+		// Seeding from the identifier makes every run pick the same sequence of variants
+		uint32_t seed = container.Value() ^ 0x9E3779B9u;
+		SoundContainer* existing = soundContainers_.Find(container);
+		if (existing != nullptr)
+		{
+			existing->Set(desc, seed);
+			return;
+		}
+
+		SoundContainer added;
+		added.Set(desc, seed);
+		soundContainers_.Insert(container, added);
+		soundContainers_.Build();
+	}
+
+	SoundHandle AudioSystem::PlaySoundContainer(AudioId container, const SoundPlayParams& params)
+	{
+		SoundContainer* found = soundContainers_.Find(container);
+		const std::string* variant = (found != nullptr) ? found->Select() : nullptr;
+		if (variant == nullptr)
+		{
+			// An unknown or empty container is a bad argument, not a missing studio event
+			CheckFMODResult(FMOD_ERR_INVALID_PARAM, __func__, container);
+			return SoundHandle();
+		}
+
+		SoundPlayParams varied = params;
+		varied.volume_ *= found->RollVolume();
+		varied.pitch_ += (float)found->RollPitch() / CENTS_PER_SEMITONE;
+		return PlaySound(*variant, varied);
+	}
+
+	void AudioSystem::PlaySoundBatch(const SoundPlayRequest* requests, size_t count, SoundHandle* handles)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			SoundHandle handle = PlaySound(requests[i].filename_, requests[i].params_);
+			if (handles != nullptr)
+			{
+				handles[i] = handle;
+			}
+		}
+	}
+
+	void AudioSystem::SetSoundDedupWindow(float seconds)
+	{
+		soundDedupWindow_ = std::max(seconds, 0.0f);
+	}
+
+	void AudioSystem::SetSoundCullSettings(AudioChannelGroup channelGroup, const SoundCullSettings& settings)
+	{
+		soundCullSettings_[(int)channelGroup] = settings;
+	}
+
+	const SoundCullSettings& AudioSystem::GetSoundCullSettings(AudioChannelGroup channelGroup) const
+	{
+		return soundCullSettings_[(int)channelGroup];
+	}
+
+	SoundCullStats AudioSystem::GetSoundCullStats(AudioChannelGroup channelGroup) const
+	{
+		if (channelGroup != AudioChannelGroup::Master)
+		{
+			return lastSoundCullStats_[(int)channelGroup];
+		}
+
+		SoundCullStats total = SoundCullStats();
+		for (const SoundCullStats& stats : lastSoundCullStats_)
+		{
+			total.played_ += stats.played_;
+			total.culledInaudible_ += stats.culledInaudible_;
+			total.culledByCap_ += stats.culledByCap_;
+			total.stolen_ += stats.stolen_;
+			total.merged_ += stats.merged_;
+		}
+		return total;
+	}
+
+	void AudioSystem::StopSound(SoundHandle sound)
+	{
+		SoundVoice* voice = FindSoundVoice(sound);
+		if (voice == nullptr)
+		{
+			return;
+		}
+
+		if (voice->channel_ != nullptr)
+		{
+			CheckFMODResult(
+				IgnoreEndedChannel(backend_->StopChannel(voice->channel_)), __func__);
+		}
+		FreeSoundVoice(sound.value_ & 0xFFFF);
+	}
+
+	void AudioSystem::SetSoundVolume(SoundHandle sound, float volume)
+	{
+		SoundVoice* voice = FindSoundVoice(sound);
+		if (voice == nullptr)
+		{
+			return;
+		}
+
+		voice->volume_ = volume;
+		if (voice->channel_ != nullptr)
+		{
+			CheckFMODResult(
+				IgnoreEndedChannel(backend_->SetChannelVolume(voice->channel_, volume)), __func__);
+		}
+	}
+
+	bool AudioSystem::GetSoundPlaying(SoundHandle sound)
+	{
+		return FindSoundVoice(sound) != nullptr;
+	}
+
+	void AudioSystem::StopSounds(AudioChannelGroup channelGroup)
+	{
+		// Freeing a voice moves the last active voice into its slot, so the index only advances past kept voices
+		for (size_t i = 0; i < activeSoundVoices_.size();)
+		{
+			SoundVoice& voice = soundVoices_[activeSoundVoices_[i]];
+			if (channelGroup != AudioChannelGroup::Master && voice.group_ != channelGroup)
+			{
+				++i;
+				continue;
+			}
+
+			if (voice.channel_ != nullptr)
+			{
+				CheckFMODResult(
+					IgnoreEndedChannel(backend_->StopChannel(voice.channel_)), __func__);
+			}
+			FreeSoundVoice(activeSoundVoices_[i]);
+		}
+	}
+
+	void AudioSystem::FadeSounds(AudioChannelGroup channelGroup, float volume, float seconds, bool stopWhenDone)
+	{
+		unsigned long long fadeClocks = (unsigned long long)(std::max(seconds, 0.0f) * (float)outputRate_);
+		for (size_t i = 0; i < activeSoundVoices_.size();)
+		{
+			SoundVoice& voice = soundVoices_[activeSoundVoices_[i]];
+			if (channelGroup != AudioChannelGroup::Master && voice.group_ != channelGroup)
+			{
+				++i;
+				continue;
+			}
+
+			// A sound that has not started yet has nothing to fade
+			if (voice.channel_ == nullptr)
+			{
+				if (stopWhenDone)
+				{
+					FreeSoundVoice(activeSoundVoices_[i]);
+					continue;
+				}
+				++i;
+				continue;
+			}
+
+			// FMOD ramps the fade on the mixer clock, so no per-frame work is needed
+			unsigned long long clock = 0;
+			if (CheckFMODResult(IgnoreEndedChannel(backend_->GetChannelDSPClock(voice.channel_, &clock)), __func__))
+			{
+				CheckFMODResult(
+					IgnoreEndedChannel(backend_->SetChannelFadeRamp(voice.channel_, clock + fadeClocks, volume)), __func__);
+				if (stopWhenDone)
+				{
+					CheckFMODResult(
+						IgnoreEndedChannel(backend_->SetChannelDelay(voice.channel_, 0, clock + fadeClocks, true)), __func__);
+				}
+			}
+			++i;
+		}
+	}
+
+	void AudioSystem::SetSoundVolumeByTag(AudioId tag, float volume)
+	{
+		for (uint16_t index : activeSoundVoices_)
+		{
+			SoundVoice& voice = soundVoices_[index];
+			if (voice.tag_ != tag)
+			{
+				continue;
+			}
+
+			voice.volume_ = volume;
+			if (voice.channel_ != nullptr)
+			{
+				CheckFMODResult(
+					IgnoreEndedChannel(backend_->SetChannelVolume(voice.channel_, volume)), __func__, tag);
+			}
+		}
+	}
+
+	EventInstanceHandle AudioSystem::PlayEvent(const std::string& event, int priority)
+	{
+		return PlayEvent(AudioId(event), priority);
+	}
+
+	EventInstanceHandle AudioSystem::PlayEvent(AudioId event, int priority) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			// The handle is reserved now and the update thread binds the play to it
+			EventInstanceHandle handle = ReserveEventVoice(event);
+			if (!handle.IsValid())
+			{
+				CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, event);
+				return handle;
+			}
+
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::PlayEvent;
+			command.target_ = event;
+			command.priority_ = priority;
+			command.index_ = handle.event_;
+			command.voice_ = handle.voice_;
+			command.generation_ = handle.generation_;
+			return commands_.Enqueue(command) ? handle : EventInstanceHandle();
+		}
+
+		EventRecord* record = FindEvent(event);
+		if (record == nullptr || record->description_ == nullptr)
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, event);
+			return EventInstanceHandle();
+		}
+		return StartEventVoice(*record, priority, EventInstanceHandle());
+	}
+
+	void AudioSystem::StopEvent(const std::string& event)
+	{
+		StopEvent(AudioId(event));
+	}
+
+	void AudioSystem::StopEvent(AudioId event) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			QueueStopEvent(event);
+			return;
+		}
+
+		EventRecord* record = FindEvent(event);
+		if (record != nullptr)
+		{
+			// Voices without an instance cannot be playing
+			for (unsigned i = 0; i < record->voiceCount_; ++i)
+			{
+				EventVoice& voice = eventVoices_[record->firstVoice_ + i];
+				if (voice.instance_ != nullptr)
+				{
+					CheckFMODResult(
+						backend_->StopInstance(voice.instance_, FMOD_STUDIO_STOP_IMMEDIATE), __func__, event);
+				}
+			}
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, event);
+		}
+	}
+
+	void AudioSystem::StopEvent(EventInstanceHandle instance) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::StopInstance;
+			command.index_ = instance.event_;
+			command.voice_ = instance.voice_;
+			command.generation_ = instance.generation_;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		EventVoice* voice = FindEventVoice(instance);
+		if (voice != nullptr)
+		{
+			CheckFMODResult(
+				backend_->StopInstance(voice->instance_, FMOD_STUDIO_STOP_IMMEDIATE), __func__);
+		}
+	}
+
+	void AudioSystem::StopAllEvents() noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::StopAllEvents;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		for (auto it = eventVoices_.begin(); it != eventVoices_.end(); ++it)
+		{
+			if (it->instance_ != nullptr)
+			{
+				CheckFMODResult(
+					backend_->StopInstance(it->instance_, FMOD_STUDIO_STOP_IMMEDIATE), __func__);
+			}
+		}
+	}
+
+	void AudioSystem::SetEventParameter(const std::string& event, const std::string& parameter, float value)
+	{
+		SetEventParameter(AudioId(event), parameter, value);
+	}
+
+	void AudioSystem::SetEventParameter(AudioId event, const std::string& parameter, float value) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			QueueSetEventParameter(event, GetParameterId(parameter.c_str()), value);
+			return;
+		}
+
+		EventRecord* record = FindEvent(event);
+		if (record != nullptr && record->description_ != nullptr)
+		{
+			// Parameters apply to every voice, the first voice is created so the value is kept for the next play
+			EnsureEventInstance(*record);
+			const EventParameter* cached = FindEventParameter(*record, parameter.c_str());
+			for (unsigned i = 0; i < record->voiceCount_; ++i)
+			{
+				EventVoice& voice = eventVoices_[record->firstVoice_ + i];
+				if (voice.instance_ == nullptr)
+				{
+					continue;
+				}
+				voice.lastActiveTime_ = audioTime_;
+
+				if (cached != nullptr)
+				{
+					CheckFMODResult(
+						backend_->SetInstanceParameter(voice.instance_, cached->id_, value), __func__, event);
+				}
+				else
+				{
+					CheckFMODResult(
+						backend_->SetInstanceParameterByName(voice.instance_, parameter.c_str(), value), __func__, event);
+				}
+			}
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, event);
+		}
+	}
+
+	void AudioSystem::SetEventParameter(EventHandle event, ParamHandle parameter, float value) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			if (parameter.IsValid())
+			{
+				AudioCommand command = {};
+				command.type_ = AudioCommandType::SetHandleParameter;
+				command.index_ = event.index_;
+				command.parameterId_[0] = parameter.id_.data1;
+				command.parameterId_[1] = parameter.id_.data2;
+				command.value_ = value;
+				commands_.Enqueue(command);
+			}
+			return;
+		}
+
+		if (event.index_ < events_.size() && events_[event.index_].description_ != nullptr && parameter.IsValid())
+		{
+			EventRecord& record = events_[event.index_];
+			EnsureEventInstance(record);
+			for (unsigned i = 0; i < record.voiceCount_; ++i)
+			{
+				EventVoice& voice = eventVoices_[record.firstVoice_ + i];
+				if (voice.instance_ != nullptr)
+				{
+					voice.lastActiveTime_ = audioTime_;
+					CheckFMODResult(
+						backend_->SetInstanceParameter(voice.instance_, parameter.id_, value), __func__, record.id_);
+				}
+			}
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_INVALID_PARAM, __func__);
+		}
+	}
+
+	void AudioSystem::SetEventParameter(EventInstanceHandle instance, ParamHandle parameter, float value) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			if (parameter.IsValid())
+			{
+				AudioCommand command = {};
+				command.type_ = AudioCommandType::SetInstanceParameter;
+				command.index_ = instance.event_;
+				command.voice_ = instance.voice_;
+				command.generation_ = instance.generation_;
+				command.parameterId_[0] = parameter.id_.data1;
+				command.parameterId_[1] = parameter.id_.data2;
+				command.value_ = value;
+				commands_.Enqueue(command);
+			}
+			return;
+		}
+
+		EventVoice* voice = FindEventVoice(instance);
+		if (voice != nullptr && parameter.IsValid())
+		{
+			voice->lastActiveTime_ = audioTime_;
+			CheckFMODResult(
+				backend_->SetInstanceParameter(voice->instance_, parameter.id_, value), __func__);
+		}
+	}
+
+	void AudioSystem::SetEventParameters(EventHandle event, const ParamHandle* parameters, const float* values, int count) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			// Commands are fixed-size, so the batch is queued one parameter at a time
+			for (int i = 0; i < count; ++i)
+			{
+				SetEventParameter(event, parameters[i], values[i]);
+			}
+			return;
+		}
+
+		if (event.index_ >= events_.size() || events_[event.index_].description_ == nullptr)
+		{
+			CheckFMODResult(FMOD_ERR_INVALID_PARAM, __func__);
+			return;
+		}
+
+		EventRecord& record = events_[event.index_];
+		FMOD_STUDIO_PARAMETER_ID batchIds[MAX_BATCHED_PARAMETERS];
+		float batchValues[MAX_BATCHED_PARAMETERS];
+		EnsureEventInstance(record);
+
+		int first = 0;
+		while (first < count)
+		{
+			// Unresolved parameters are skipped rather than failing the whole batch
+			int batchCount = 0;
+			while (first < count && batchCount < MAX_BATCHED_PARAMETERS)
+			{
+				if (parameters[first].IsValid())
+				{
+					batchIds[batchCount] = parameters[first].id_;
+					batchValues[batchCount] = values[first];
+					++batchCount;
+				}
+				++first;
+			}
+			if (batchCount == 0)
+			{
+				continue;
+			}
+
+			for (unsigned i = 0; i < record.voiceCount_; ++i)
+			{
+				EventVoice& voice = eventVoices_[record.firstVoice_ + i];
+				if (voice.instance_ != nullptr)
+				{
+					voice.lastActiveTime_ = audioTime_;
+					CheckFMODResult(
+						backend_->SetInstanceParameters(voice.instance_, batchIds, batchValues, batchCount), __func__, record.id_);
+				}
+			}
+		}
+	}
+
+	void AudioSystem::SetGameParameter(GameParameter parameter, float value)
+	{
+		// Only the last value of the frame is sent, earlier writes are simply overwritten
+		gameParameterValues_[(int)parameter].store(value, std::memory_order_relaxed);
+		dirtyGameParameters_.fetch_or(1u << (int)parameter, std::memory_order_release);
+	}
+
+	float AudioSystem::GetGameParameter(GameParameter parameter) const
+	{
+		return gameParameterValues_[(int)parameter].load(std::memory_order_relaxed);
+	}
+
+	AudioId AudioSystem::AddEvent(const std::string& path)
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		AudioId id(path);
+		if (!studioReady_)
+		{
+			LogWarning("The event '", path, "' cannot be added before the studio is ready.");
+			return id;
+		}
+		if (eventIndices_.Find(id) == nullptr)
+		{
+			std::unique_lock<std::mutex> reservations = LockEventReservations();
+			ResolveEvent(id, path.c_str());
+			eventIndices_.Build();
+		}
+		return id;
+	}
+
+	EventHandle AudioSystem::GetEventHandle(AudioId event) const
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		EventHandle handle;
+		const unsigned* index = eventIndices_.Find(event);
+		if (index != nullptr)
+		{
+			handle.index_ = *index;
+		}
+		return handle;
+	}
+
+	ParamHandle AudioSystem::GetParameterHandle(EventHandle event, const std::string& parameter) const
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		ParamHandle handle;
+		if (event.index_ < events_.size())
+		{
+			const EventParameter* cached = FindEventParameter(events_[event.index_], parameter.c_str());
+			if (cached != nullptr)
+			{
+				handle.id_ = cached->id_;
+				handle.valid_ = true;
+			}
+		}
+		return handle;
+	}
+
+	bool AudioSystem::GetEventPlaying(const std::string& event)
+	{
+		return GetEventPlaying(AudioId(event));
+	}
+
+	bool AudioSystem::GetEventPlaying(AudioId event) noexcept
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		EventRecord* record = FindEvent(event);
+		if (record != nullptr)
+		{
+			// Voices without an instance cannot be playing
+			for (unsigned i = 0; i < record->voiceCount_; ++i)
+			{
+				EventVoice& voice = eventVoices_[record->firstVoice_ + i];
+				if (voice.instance_ == nullptr)
+				{
+					continue;
+				}
+
+				FMOD_STUDIO_PLAYBACK_STATE state = FMOD_STUDIO_PLAYBACK_STOPPED;
+				CheckFMODResult(
+					backend_->GetInstancePlaybackState(voice.instance_, &state), __func__, event);
+				if (state != FMOD_STUDIO_PLAYBACK_STOPPED)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, event);
+			return false;
+		}
+	}
+
+	bool AudioSystem::GetEventPlaying(EventInstanceHandle instance) noexcept
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		EventVoice* voice = FindEventVoice(instance);
+		if (voice == nullptr)
+		{
+			return false;
+		}
+
+		FMOD_STUDIO_PLAYBACK_STATE state = FMOD_STUDIO_PLAYBACK_STOPPED;
+		CheckFMODResult(
+			backend_->GetInstancePlaybackState(voice->instance_, &state), __func__);
+		return (state != FMOD_STUDIO_PLAYBACK_STOPPED);
+	}
+
+	bool AudioSystem::EnqueueCommand(const AudioCommand& command)
+	{
+		return commands_.Enqueue(command);
+	}
+
+	bool AudioSystem::QueuePlayEvent(AudioId event, int priority)
+	{
+		AudioCommand command = {};
+		command.type_ = AudioCommandType::PlayEvent;
+		command.target_ = event;
+		command.priority_ = priority;
+		return commands_.Enqueue(command);
+	}
+
+	bool AudioSystem::QueueStopEvent(AudioId event)
+	{
+		AudioCommand command = {};
+		command.type_ = AudioCommandType::StopEvent;
+		command.target_ = event;
+		return commands_.Enqueue(command);
+	}
+
+	bool AudioSystem::QueueSetEventParameter(AudioId event, AudioId parameter, float value)
+	{
+		AudioCommand command = {};
+		command.type_ = AudioCommandType::SetEventParameter;
+		command.target_ = event;
+		command.parameter_ = parameter;
+		command.value_ = value;
+		return commands_.Enqueue(command);
+	}
+
+	bool AudioSystem::QueueSetBusVolume(AudioId bus, float volume)
+	{
+		AudioCommand command = {};
+		command.type_ = AudioCommandType::SetBusVolume;
+		command.target_ = bus;
+		command.value_ = volume;
+		return commands_.Enqueue(command);
+	}
+
+	AudioCommandQueueStats AudioSystem::GetCommandQueueStats() const
+	{
+		return commands_.GetStats();
+	}
+
+	void AudioSystem::SetChannelGroupVolume(AudioChannelGroup channelGroup, float volume)
+	{
+		volume = Clamp(volume, 0.0f, 1.0f);
+		channelGroupVolumes_[(int)channelGroup] = volume;
+		backend_->SetChannelGroupVolume(channelGroups_[(int)channelGroup], volume);
+	}
+
+	AudioEffect* AudioSystem::AttachEffect(AudioChannelGroup channelGroup, std::unique_ptr<AudioEffect> effect)
+	{
+		if (effect == nullptr)
+		{
+			return nullptr;
+		}
+
+		// Groups mix in the speaker layout of the output, wider blocks pass through the effect
+		effect->Prepare(outputRate_, mixBlockSamples_, MAX_EFFECT_CHANNELS);
+		FMOD::DSP* dsp = nullptr;
+		if (!CheckFMODResult(
+			backend_->CreateEffectDSP(effect.get(), &dsp), __func__))
+		{
+			return nullptr;
+		}
+		if (!CheckFMODResult(
+			backend_->AddChannelGroupDSP(channelGroups_[(int)channelGroup], dsp), __func__))
+		{
+			backend_->ReleaseDSP(dsp);
+			return nullptr;
+		}
+
+		groupEffects_.push_back(GroupEffect{ std::move(effect), dsp, channelGroup });
+		return groupEffects_.back().effect_.get();
+	}
+
+	void AudioSystem::DetachEffects(AudioChannelGroup channelGroup)
+	{
+		auto it = groupEffects_.begin();
+		while (it != groupEffects_.end())
+		{
+			if (it->group_ != channelGroup)
+			{
+				++it;
+				continue;
+			}
+			CheckFMODResult(
+				backend_->RemoveChannelGroupDSP(channelGroups_[(int)it->group_], it->dsp_), __func__);
+			CheckFMODResult(
+				backend_->ReleaseDSP(it->dsp_), __func__);
+			it = groupEffects_.erase(it);
+		}
+	}
+
+	void AudioSystem::SetBusVolume(const std::string& bus, float volume)
+	{
+		SetBusVolume(AudioId(bus), volume);
+	}
+
+	void AudioSystem::SetBusVolume(AudioId bus, float volume) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			QueueSetBusVolume(bus, volume);
+			return;
+		}
+
+		FMOD::Studio::Bus* studioBus = FindBus(bus);
+		if (studioBus != nullptr)
+		{
+			volume = Clamp(volume, 0.0f, 1.0f);
+			CheckFMODResult(
+				backend_->SetBusVolume(studioBus, volume), __func__, bus);
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, bus);
+		}
+	}
+
+	float AudioSystem::GetBusVolume(const std::string& bus)
+	{
+		return GetBusVolume(AudioId(bus));
+	}
+
+	float AudioSystem::GetBusVolume(AudioId bus) noexcept
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		float volume = -1.0f;
+		FMOD::Studio::Bus* studioBus = FindBus(bus);
+		if (studioBus != nullptr)
+		{
+			CheckFMODResult(
+				backend_->GetBusVolume(studioBus, &volume), __func__, bus);
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, bus);
+		}
+		return volume;
+	}
+
+	void AudioSystem::SetBusPaused(const std::string& bus, bool pause)
+	{
+		SetBusPaused(AudioId(bus), pause);
+	}
+
+	void AudioSystem::SetBusPaused(AudioId bus, bool pause) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::SetBusPaused;
+			command.target_ = bus;
+			command.value_ = pause ? 1.0f : 0.0f;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		FMOD::Studio::Bus* studioBus = FindBus(bus);
+		if (studioBus != nullptr)
+		{
+			bool paused = !pause;
+			CheckFMODResult(
+				backend_->GetBusPaused(studioBus, &paused), __func__, bus);
+			if (paused != pause)
+			{
+				CheckFMODResult(
+					backend_->SetBusPaused(studioBus, pause), __func__, bus);
+			}
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, bus);
+		}
+	}
+
+	bool AudioSystem::GetBusPaused(const std::string& bus)
+	{
+		return GetBusPaused(AudioId(bus));
+	}
+
+	bool AudioSystem::GetBusPaused(AudioId bus) noexcept
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		bool paused = false;
+		FMOD::Studio::Bus* studioBus = FindBus(bus);
+		if (studioBus != nullptr)
+		{
+			CheckFMODResult(
+				backend_->GetBusPaused(studioBus, &paused), __func__, bus);
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, bus);
+		}
+		return paused;
+	}
+
+	void AudioSystem::BusStopAllEvents(const std::string& bus)
+	{
+		BusStopAllEvents(AudioId(bus));
+	}
+
+	void AudioSystem::BusStopAllEvents(AudioId bus) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::BusStopAllEvents;
+			command.target_ = bus;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		FMOD::Studio::Bus* studioBus = FindBus(bus);
+		if (studioBus != nullptr)
+		{
+			CheckFMODResult(
+				backend_->StopBusEvents(studioBus, FMOD_STUDIO_STOP_IMMEDIATE), __func__, bus);
+		}
+		else
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, bus);
+		}
+	}
+
+	AudioSystem& AudioSystem::Instance()
+	{
+        static AudioSystem audioSystem;
+		return audioSystem;
+	}
+
+	void AudioSystem::ReportFMODError(FMOD_RESULT err)
+	{
+		if (err != FMOD_OK)
+		{
+			const char* FMODError = FMOD_ErrorString(err);
+			LogCritical("FMOD ERROR: ", FMODError);
+			throw std::runtime_error(FMODError);
+		}
+	}
+
+	bool AudioSystem::CheckFMODResult(FMOD_RESULT result, const char* site, AudioId id) const noexcept
+	{
+		if (result == FMOD_OK)
+		{
+			return true;
+		}
+		errorLog_.Record(result, site, id, audioFrame_.load(std::memory_order_relaxed));
+		return false;
+	}
+
+	const AudioErrorLog& AudioSystem::GetErrorLog() const
+	{
+		return errorLog_;
+	}
+
+	const AudioStats& AudioSystem::GetAudioStats() const
+	{
+		return stats_;
+	}
+
+	void AudioSystem::SetAudioStatsHistory(size_t frames)
+	{
+		statsHistory_.SetCapacity(frames);
+	}
+
+	bool AudioSystem::WriteAudioStatsHistory(const std::string& path, AudioStatsFormat format) const
+	{
+		if (!statsHistory_.Write(path.c_str(), format))
+		{
+			LogWarning("Could not write the audio stats to '", path, "'.");
+			return false;
+		}
+		return true;
+	}
+
+	void AudioSystem::CollectAudioStats(float updateTime)
+	{
+		// Failed queries leave their fields at zero rather than filling the error log every frame
+		AudioStats stats = AudioStats();
+		stats.frame_ = stats_.frame_ + 1;
+		stats.updateTime_ = updateTime;
+		stats.soundVoices_ = (unsigned)activeSoundVoices_.size();
+		stats.banksLoaded_ = (unsigned)std::count_if(bankLoadReports_.begin(), bankLoadReports_.end(),
+			[](const BankLoadReport& report) { return report.state_ == FMOD_STUDIO_LOADING_STATE_LOADED; });
+		stats.banksLoading_ = banksLoading_.load(std::memory_order_relaxed);
+		stats.soundCacheBytes_ = soundCacheBytes_;
+		stats.commandQueueDepth_ = commands_.GetStats().depth_;
+		if (backend_ != nullptr)
+		{
+			FMOD_STUDIO_CPU_USAGE studioUsage;
+			FMOD_CPU_USAGE coreUsage;
+			if (backend_->GetCPUUsage(&studioUsage, &coreUsage) == FMOD_OK)
+			{
+				stats.dspCPU_ = coreUsage.dsp;
+				stats.streamCPU_ = coreUsage.stream;
+				stats.coreUpdateCPU_ = coreUsage.update;
+				stats.studioUpdateCPU_ = studioUsage.update;
+			}
+
+			FMOD_STUDIO_MEMORY_USAGE memoryUsage;
+			if (backend_->GetStudioMemoryUsage(&memoryUsage) == FMOD_OK)
+			{
+				stats.sampleDataBytes_ = memoryUsage.sampledata;
+			}
+
+			if (backend_->GetChannelsPlaying(&stats.channelsPlaying_, &stats.realChannels_) == FMOD_OK)
+			{
+				stats.virtualChannels_ = stats.channelsPlaying_ - stats.realChannels_;
+			}
+			backend_->GetMemoryStats(&stats.memoryBytes_, &stats.memoryPeakBytes_);
+		}
+		if (memoryArena_ != nullptr)
+		{
+			AudioMemoryStats memory = memoryArena_->EndFrame();
+			stats.arenaAllocations_ = memory.frameAllocations_ + memory.frameReallocations_;
+			stats.arenaFrees_ = memory.frameFrees_;
+			stats.arenaPeakBytes_ = memory.peakCommittedBytes_;
+			stats.arenaFragmentation_ = memory.fragmentation_;
+		}
+
+		stats_ = stats;
+		statsHistory_.Push(stats);
+	}
+
+	void AudioSystem::LogRecordedErrors()
+	{
+		// Every second the budget of logged errors is refilled and the errors left out are summed up
+		auto now = std::chrono::steady_clock::now();
+		if (now - errorLogWindowStart_ >= std::chrono::seconds(1))
+		{
+			if (suppressedErrorLogs_ > 0)
+			{
+				LogWarning(suppressedErrorLogs_, " more FMOD errors were recorded without being logged.");
+			}
+			errorLogWindowStart_ = now;
+			errorLogsInWindow_ = 0;
+			suppressedErrorLogs_ = 0;
+		}
+
+		uint64_t recordCount = errorLog_.GetRecordCount();
+		for (; loggedErrorCount_ < recordCount; ++loggedErrorCount_)
+		{
+			// Records overwritten since the last update are counted as suppressed
+			AudioErrorRecord record;
+			if (errorLogsInWindow_ >= MAX_ERROR_LOGS_PER_SECOND || !errorLog_.GetRecord(loggedErrorCount_, record))
+			{
+				++suppressedErrorLogs_;
+				continue;
+			}
+			++errorLogsInWindow_;
+			LogWarning("FMOD error in ", record.site_, " (id ", record.id_.Value(), ", frame ", record.frame_, "): ",
+				FMOD_ErrorString(record.result_));
+		}
+	}
+
+	void AudioSystem::CreateBankPathFromGUID(std::string& guid)
+	{
+		size_t pathSuffix = guid.find_last_of('/') + 1;
+		guid = BANKS_DIRECTORY_PATH + guid.substr(pathSuffix) + BANKS_FILE_EXT;
+	}
+
+	float AudioSystem::ChangeOctave(float frequency, float variation)
+	{
+		return frequency * CentsToPitchRatio(SemitonesToCents(variation * 12.0f));
+	}
+
+	float AudioSystem::ChangeSemitone(float frequency, float variation)
+	{
+		return frequency * CentsToPitchRatio(SemitonesToCents(variation));
+	}
+
+	void AudioSystem::OnKeyTriggered(const KeyboardButtonEvent* event)
+	{
+		if (event->key_ == InputManager::InputButton::KEY_ESCAPE)
+		{
+			SetGameParameter(GameParameter::Pausing, 1.0f);
+		}
+	}
+
+	void AudioSystem::OnPauseScreenClosed(const NamedEvent* event)
+	{
+		UNREFERENCED_PARAMETER(event);
+		SetGameParameter(GameParameter::Pausing, 0.0f);
+	}
+
+	void AudioSystem::CaptureMixSnapshot(AudioId snapshot) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::CaptureMixSnapshot;
+			command.target_ = snapshot;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		unsigned index = mixSnapshots_.Acquire(snapshot);
+		if (index == MixSnapshotTable::INVALID_SNAPSHOT)
+		{
+			CheckFMODResult(FMOD_ERR_MEMORY, __func__, snapshot);
+			return;
+		}
+		CaptureMixSnapshot(index);
+	}
+
+	void AudioSystem::SetMixSnapshotBus(AudioId snapshot, AudioId bus, float volume, bool paused) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::SetMixSnapshotBus;
+			command.target_ = snapshot;
+			command.parameter_ = bus;
+			command.value_ = volume;
+			command.priority_ = paused ? 1 : 0;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		size_t busIndex = buses_.IndexOf(bus);
+		if (busIndex == buses_.Size())
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, bus);
+			return;
+		}
+		unsigned index = mixSnapshots_.Acquire(snapshot);
+		if (index == MixSnapshotTable::INVALID_SNAPSHOT)
+		{
+			CheckFMODResult(FMOD_ERR_MEMORY, __func__, snapshot);
+			return;
+		}
+		mixSnapshots_.GetVolumes(index)[busIndex] = Clamp(volume, 0.0f, 1.0f);
+		mixSnapshots_.GetPaused(index)[busIndex] = paused ? 1 : 0;
+	}
+
+	void AudioSystem::ApplyMixSnapshot(AudioId snapshot, float seconds) noexcept
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::ApplyMixSnapshot;
+			command.target_ = snapshot;
+			command.value_ = seconds;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		unsigned index = mixSnapshots_.Find(snapshot);
+		if (index == MixSnapshotTable::INVALID_SNAPSHOT)
+		{
+			CheckFMODResult(FMOD_ERR_EVENT_NOTFOUND, __func__, snapshot);
+			return;
+		}
+		if (seconds <= 0.0f)
+		{
+			mixSnapshots_.StopFade();
+			RestoreMixSnapshot(index);
+			return;
+		}
+
+		// Start from what is heard now, which may be the middle of another crossfade
+		float* source = mixSnapshots_.GetFadeSource();
+		const uint8_t* paused = mixSnapshots_.GetPaused(index);
+		size_t i = 0;
+		for (auto bus = buses_.begin(); bus != buses_.end(); ++bus, ++i)
+		{
+			source[i] = 0.0f;
+			CheckFMODResult(
+				backend_->GetBusVolume(bus->second, &source[i]), __func__, bus->first);
+			if (!paused[i])
+			{
+				CheckFMODResult(
+					backend_->SetBusPaused(bus->second, false), __func__, bus->first);
+			}
+		}
+		mixSnapshots_.StartFade(index, seconds);
+	}
+
+	bool AudioSystem::IsMixSnapshotFading() const
+	{
+		return mixSnapshots_.IsFading();
+	}
+
+	void AudioSystem::MuteAllBuses()
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::MuteAllBuses;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		// A second mute would save the muted volumes over the ones to restore
+		if (busesMuted_)
+		{
+			return;
+		}
+		unsigned index = mixSnapshots_.Acquire(MUTE_SNAPSHOT);
+		if (index == MixSnapshotTable::INVALID_SNAPSHOT)
+		{
+			CheckFMODResult(FMOD_ERR_MEMORY, __func__, MUTE_SNAPSHOT);
+			return;
+		}
+		mixSnapshots_.StopFade();
+		CaptureMixSnapshot(index);
+		for (auto bus = buses_.begin(); bus != buses_.end(); ++bus)
+		{
+			CheckFMODResult(
+				backend_->SetBusVolume(bus->second, 0.0f), __func__, bus->first);
+		}
+		busesMuted_ = true;
+	}
+
+	void AudioSystem::UnmuteAllBuses()
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::UnmuteAllBuses;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		if (!busesMuted_)
+		{
+			return;
+		}
+		mixSnapshots_.StopFade();
+		RestoreMixSnapshot(mixSnapshots_.Find(MUTE_SNAPSHOT));
+		busesMuted_ = false;
+	}
+
+	void AudioSystem::CaptureMixSnapshot(unsigned snapshot)
+	{
+		float* volumes = mixSnapshots_.GetVolumes(snapshot);
+		uint8_t* paused = mixSnapshots_.GetPaused(snapshot);
+		size_t i = 0;
+		for (auto bus = buses_.begin(); bus != buses_.end(); ++bus, ++i)
+		{
+			bool busPaused = false;
+			volumes[i] = 1.0f;
+			CheckFMODResult(
+				backend_->GetBusVolume(bus->second, &volumes[i]), __func__, bus->first);
+			CheckFMODResult(
+				backend_->GetBusPaused(bus->second, &busPaused), __func__, bus->first);
+			paused[i] = busPaused ? 1 : 0;
+		}
+	}
+
+	void AudioSystem::RestoreMixSnapshot(unsigned snapshot)
+	{
+		const float* volumes = mixSnapshots_.GetVolumes(snapshot);
+		const uint8_t* paused = mixSnapshots_.GetPaused(snapshot);
+		size_t i = 0;
+		for (auto bus = buses_.begin(); bus != buses_.end(); ++bus, ++i)
+		{
+			CheckFMODResult(
+				backend_->SetBusVolume(bus->second, volumes[i]), __func__, bus->first);
+			CheckFMODResult(
+				backend_->SetBusPaused(bus->second, paused[i] != 0), __func__, bus->first);
+		}
+	}
+
+	void AudioSystem::UpdateMixFade(float dt)
+	{
+		unsigned target = mixSnapshots_.GetFadeTarget();
+		const float* volumes = mixSnapshots_.Advance(dt);
+		if (volumes == nullptr)
+		{
+			return;
+		}
+
+		size_t i = 0;
+		for (auto bus = buses_.begin(); bus != buses_.end(); ++bus, ++i)
+		{
+			CheckFMODResult(
+				backend_->SetBusVolume(bus->second, volumes[i]), __func__, bus->first);
+		}
+
+		// Buses paused in the snapshot keep playing until the crossfade has silenced them
+		if (!mixSnapshots_.IsFading())
+		{
+			const uint8_t* paused = mixSnapshots_.GetPaused(target);
+			i = 0;
+			for (auto bus = buses_.begin(); bus != buses_.end(); ++bus, ++i)
+			{
+				if (paused[i])
+				{
+					CheckFMODResult(
+						backend_->SetBusPaused(bus->second, true), __func__, bus->first);
+				}
+			}
+		}
+	}
+
+	void AudioSystem::HandleVolumeEvent(const ChangeVolumeEvent* event)
+	{
+		SetBusVolume(event->busName_, event->volume_);
+	}
+
+	AudioSystem::SoundCacheEntry* AudioSystem::AcquireSound(const std::string& filename)
+	{
+		auto it = sounds_.find(filename);
+		if (it != sounds_.end() && it->second.sound_ != nullptr)
+		{
+			// A sound still loading asynchronously counts as a hit, its play is queued or dropped
+			++soundCacheHits_;
+			it->second.lastUsed_ = ++soundCacheTick_;
+			return &it->second;
+		}
+		if (it != sounds_.end() && it->second.failed_)
+		{
+			// The file is not opened again on every play, only an explicit load retries it
+			return nullptr;
+		}
+
+		// Reload evicted sounds with the settings they were first loaded with
+		++soundCacheMisses_;
+		bool loop = (it != sounds_.end()) ? it->second.loop_ : false;
+		bool stream = (it != sounds_.end()) ? it->second.stream_ : false;
+		LoadSound(filename, loop, stream);
+
+		it = sounds_.find(filename);
+		return (it != sounds_.end() && it->second.sound_ != nullptr) ? &it->second : nullptr;
+	}
+
+	size_t AudioSystem::MeasureSound(FMOD::Sound* sound) const
+	{
+		FMOD_MODE mode;
+		unsigned int bytes = 0;
+		if (!CheckFMODResult(backend_->GetSoundMode(sound, &mode), __func__))
+		{
+			return 0;
+		}
+
+		if (mode & FMOD_CREATESTREAM)
+		{
+			// Streams only keep their file buffer resident
+			FMOD_TIMEUNIT unit;
+			CheckFMODResult(
+				backend_->GetStreamBufferSize(&bytes, &unit), __func__);
+		}
+		else
+		{
+			CheckFMODResult(
+				backend_->GetSoundLength(sound, &bytes, (mode & FMOD_CREATECOMPRESSEDSAMPLE) ? FMOD_TIMEUNIT_RAWBYTES : FMOD_TIMEUNIT_PCMBYTES), __func__);
+		}
+		return bytes;
+	}
+
+	void AudioSystem::EnforceSoundCacheBudget(const SoundCacheEntry* keep)
+	{
+		// Evictions are rare, so a scan for the least recently used sound beats maintaining an ordered list
+		while (soundCacheBytes_ > soundCacheBudget_)
+		{
+			SoundCacheEntry* oldest = nullptr;
+			for (auto it = sounds_.begin(); it != sounds_.end(); ++it)
+			{
+				SoundCacheEntry& entry = it->second;
+				if (entry.sound_ != nullptr && !entry.loading_ && entry.playing_ == 0 && &entry != keep &&
+					(oldest == nullptr || entry.lastUsed_ < oldest->lastUsed_))
+				{
+					oldest = &entry;
+				}
+			}
+
+			// Everything left is playing or was just loaded
+			if (oldest == nullptr)
+			{
+				break;
+			}
+
+			CheckFMODResult(
+				backend_->ReleaseSound(oldest->sound_), __func__);
+			oldest->sound_ = nullptr;
+			soundCacheBytes_ -= oldest->bytes_;
+			++soundCacheEvictions_;
+		}
+	}
+
+	FMOD_MODE AudioSystem::GetSoundDecodeMode(const std::string& filename, bool stream) const
+	{
+		const AudioSoundManifestEntry* cooked = soundManifest_.IsLoaded() ? soundManifest_.Find(filename) : nullptr;
+		if (cooked == nullptr)
+		{
+			return stream ? FMOD_CREATESTREAM : FMOD_CREATECOMPRESSEDSAMPLE;
+		}
+
+		// ADPCM and compressed sounds stay encoded in memory, PCM is decoded once when it loads
+		switch ((AudioSoundFormat)cooked->format_)
+		{
+		case AudioSoundFormat::PCM:    return FMOD_CREATESAMPLE;
+		case AudioSoundFormat::Stream: return FMOD_CREATESTREAM;
+		default:                       return FMOD_CREATECOMPRESSEDSAMPLE;
+		}
+	}
+
+	FMOD_RESULT AudioSystem::OpenSound(const std::string& filename, FMOD_MODE mode, SoundCacheEntry& entry, FMOD::Sound** sound)
+	{
+		// Sounds re-encoded by the cooker open their cooked file, from the pack when it holds it
+		const AudioSoundManifestEntry* cooked = soundManifest_.IsLoaded() ? soundManifest_.Find(filename) : nullptr;
+		std::string openName = (cooked != nullptr) ? soundManifest_.GetOpenName(*cooked) : filename;
+		const AudioPackEntry* packed = soundPack_.IsOpen() ? soundPack_.Find(openName) : nullptr;
+		entry.packed_ = (packed != nullptr);
+		if (packed == nullptr && fileIO_.IsRunning())
+		{
+			// Tag the file so the I/O threads serve its reads at the priority of its kind
+			FMOD_CREATESOUNDEXINFO info = {};
+			info.cbsize = sizeof(info);
+			info.fileuserdata = AudioFileIO::GetUserData((mode & FMOD_CREATESTREAM) ?
+				AudioFilePriority::Stream : AudioFilePriority::Sample);
+			return backend_->CreateSound(openName.c_str(), mode, &info, sound);
+		}
+		if (packed == nullptr)
+		{
+			return backend_->CreateSound(openName.c_str(), mode, nullptr, sound);
+		}
+
+		FMOD_CREATESOUNDEXINFO info = {};
+		info.cbsize = sizeof(info);
+		info.length = (unsigned)packed->size_;
+		switch ((AudioPackCodec)packed->codec_)
+		{
+		case AudioPackCodec::Wav:    info.suggestedsoundtype = FMOD_SOUND_TYPE_WAV; break;
+		case AudioPackCodec::Vorbis: info.suggestedsoundtype = FMOD_SOUND_TYPE_OGGVORBIS; break;
+		case AudioPackCodec::Mpeg:   info.suggestedsoundtype = FMOD_SOUND_TYPE_MPEG; break;
+		case AudioPackCodec::Flac:   info.suggestedsoundtype = FMOD_SOUND_TYPE_FLAC; break;
+		case AudioPackCodec::FSB:    info.suggestedsoundtype = FMOD_SOUND_TYPE_FSB; break;
+		default:                     info.suggestedsoundtype = FMOD_SOUND_TYPE_UNKNOWN; break;
+		}
+
+		// Streams read straight from the mapping, samples are decoded or copied out of it once when they open
+		const char* data = reinterpret_cast<const char*>(soundPack_.GetData(*packed));
+		return backend_->CreateSound(data, mode | FMOD_OPENMEMORY_POINT, &info, sound);
+	}
+
+	void AudioSystem::UpdateSoundLoads()
+	{
+		for (size_t i = 0; i < pendingSoundLoads_.size();)
+		{
+			PendingSoundLoad load = pendingSoundLoads_[i];
+			SoundCacheEntry& entry = *load.entry_;
+			FMOD_OPENSTATE openState;
+			FMOD_RESULT result = backend_->GetSoundOpenState(entry.sound_, &openState);
+			if (result == FMOD_OK && (openState == FMOD_OPENSTATE_LOADING || openState == FMOD_OPENSTATE_CONNECTING))
+			{
+				++i;
+				continue;
+			}
+
+			pendingSoundLoads_[i] = pendingSoundLoads_.back();
+			pendingSoundLoads_.pop_back();
+			entry.loading_ = false;
+
+			if (result != FMOD_OK || openState == FMOD_OPENSTATE_ERROR)
+			{
+				// FMOD returns the error of the load from getOpenState, a bare error state means a bad file
+				CheckFMODResult((result != FMOD_OK) ? result : FMOD_ERR_FILE_BAD, __func__, load.id_);
+				CheckFMODResult(
+					backend_->ReleaseSound(entry.sound_), __func__, load.id_);
+				entry.sound_ = nullptr;
+				entry.failed_ = true;
+				load.status_->state_ = SoundLoadState::Failed;
+			}
+			else
+			{
+				entry.bytes_ = MeasureSound(entry.sound_);
+				soundCacheBytes_ += entry.bytes_;
+				load.status_->state_ = SoundLoadState::Ready;
+			}
+
+			// Start or free the voices that were waiting on this sound, and drop the ones stopped meanwhile
+			for (size_t play = 0; play < queuedSoundPlays_.size();)
+			{
+				SoundHandle queued = queuedSoundPlays_[play];
+				SoundVoice* voice = FindSoundVoice(queued);
+				if (voice != nullptr && voice->entry_ != &entry)
+				{
+					++play;
+					continue;
+				}
+
+				queuedSoundPlays_.erase(queuedSoundPlays_.begin() + play);
+				if (voice != nullptr && (entry.sound_ == nullptr || !StartSoundVoice(*voice)))
+				{
+					FreeSoundVoice(queued.value_ & 0xFFFF);
+				}
+			}
+
+			if (entry.sound_ != nullptr)
+			{
+				EnforceSoundCacheBudget(&entry);
+			}
+		}
+	}
+
+	void AudioSystem::ForgetSound(const SoundCacheEntry& entry)
+	{
+		for (size_t i = 0; i < activeSoundVoices_.size();)
+		{
+			if (soundVoices_[activeSoundVoices_[i]].entry_ == &entry)
+			{
+				FreeSoundVoice(activeSoundVoices_[i]);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		for (size_t i = 0; i < pendingSoundLoads_.size();)
+		{
+			if (pendingSoundLoads_[i].entry_ == &entry)
+			{
+				pendingSoundLoads_[i].status_->state_ = SoundLoadState::Failed;
+				pendingSoundLoads_[i] = pendingSoundLoads_.back();
+				pendingSoundLoads_.pop_back();
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		// The voices waiting on the sound were freed above
+		for (size_t i = 0; i < queuedSoundPlays_.size();)
+		{
+			if (FindSoundVoice(queuedSoundPlays_[i]) == nullptr)
+			{
+				queuedSoundPlays_.erase(queuedSoundPlays_.begin() + i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		for (size_t i = 0; i < pendingSoundVoices_.size();)
+		{
+			if (FindSoundVoice(pendingSoundVoices_[i]) == nullptr)
+			{
+				pendingSoundVoices_.erase(pendingSoundVoices_.begin() + i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+
+	void AudioSystem::UpdateSoundChannels()
+	{
+		for (size_t i = 0; i < activeSoundVoices_.size();)
+		{
+			// Voices waiting for their sound have no channel yet
+			SoundVoice& voice = soundVoices_[activeSoundVoices_[i]];
+			if (voice.channel_ == nullptr)
+			{
+				++i;
+				continue;
+			}
+
+			// A stolen or finished channel reports an invalid handle instead of false
+			bool playing = false;
+			if (backend_->IsChannelPlaying(voice.channel_, &playing) != FMOD_OK || !playing)
+			{
+				FreeSoundVoice(activeSoundVoices_[i]);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+
+	AudioSystem::SoundVoice* AudioSystem::FindSoundVoice(SoundHandle sound)
+	{
+		unsigned index = sound.value_ & 0xFFFF;
+		if (index >= soundVoices_.size())
+		{
+			return nullptr;
+		}
+
+		SoundVoice& voice = soundVoices_[index];
+		if (voice.entry_ == nullptr || voice.generation_ != (sound.value_ >> 16))
+		{
+			return nullptr;
+		}
+		return &voice;
+	}
+
+	unsigned AudioSystem::AllocateSoundVoice(AudioChannelGroup group)
+	{
+		if (freeSoundVoice_ == soundVoices_.size())
+		{
+			return (unsigned)soundVoices_.size();
+		}
+
+		unsigned index = freeSoundVoice_;
+		SoundVoice& voice = soundVoices_[index];
+		freeSoundVoice_ = voice.slot_;
+		voice.slot_ = (uint16_t)activeSoundVoices_.size();
+		voice.group_ = group;
+		activeSoundVoices_.push_back((uint16_t)index);
+		++soundGroupVoices_[(int)group];
+		++soundGroupVoices_[(int)AudioChannelGroup::Master];
+		return index;
+	}
+
+	AudioChannelGroup AudioSystem::GetSoundGroup(const std::string& filename) const
+	{
+		// Evicted entries remember how they were loaded, and new sounds load as one-shots
+		auto it = sounds_.find(filename);
+		if (it != sounds_.end() && it->second.stream_ && it->second.loop_)
+		{
+			return AudioChannelGroup::Stream;
+		}
+		return AudioChannelGroup::Sound;
+	}
+
+	float AudioSystem::GetDistanceAttenuation(AudioChannelGroup group, float distance) const
+	{
+		// Inverse rolloff between the two distances, as FMOD applies to 3D sounds by default
+		const SoundCullSettings& settings = soundCullSettings_[(int)group];
+		if (settings.maxDistance_ <= 0.0f || distance <= settings.minDistance_)
+		{
+			return 1.0f;
+		}
+		if (distance >= settings.maxDistance_)
+		{
+			return 0.0f;
+		}
+		return settings.minDistance_ / distance;
+	}
+
+	float AudioSystem::EstimateAudibility(AudioChannelGroup group, float volume) const
+	{
+		return volume * channelGroupVolumes_[(int)group] * channelGroupVolumes_[(int)AudioChannelGroup::Master];
+	}
+
+	bool AudioSystem::SelectSoundVictims(AudioChannelGroup group, int priority, float audibility, unsigned (&victims)[2])
+	{
+		// The group cap is checked first, then the cap on every sound
+		AudioChannelGroup caps[2] = { group, AudioChannelGroup::Master };
+		victims[0] = victims[1] = (unsigned)soundVoices_.size();
+		for (int i = 0; i < 2; ++i)
+		{
+			// A voice stolen for the group cap also makes room under the cap on every sound
+			AudioChannelGroup cap = caps[i];
+			unsigned maxVoices = soundCullSettings_[(int)cap].maxVoices_;
+			unsigned voices = soundGroupVoices_[(int)cap] - ((i == 1 && victims[0] != soundVoices_.size()) ? 1 : 0);
+			if (maxVoices == 0 || voices < maxVoices)
+			{
+				continue;
+			}
+
+			// The victim is the least important voice under the cap, the quietest one on a tie
+			unsigned victim = (unsigned)soundVoices_.size();
+			float victimAudibility = 0.0f;
+			for (uint16_t index : activeSoundVoices_)
+			{
+				const SoundVoice& voice = soundVoices_[index];
+				if ((cap != AudioChannelGroup::Master && voice.group_ != cap) || index == victims[0])
+				{
+					continue;
+				}
+
+				float voiceAudibility = EstimateAudibility(voice.group_, voice.volume_ * voice.attenuation_);
+				if (victim == soundVoices_.size() || voice.priority_ < soundVoices_[victim].priority_ ||
+					(voice.priority_ == soundVoices_[victim].priority_ && voiceAudibility < victimAudibility))
+				{
+					victim = index;
+					victimAudibility = voiceAudibility;
+				}
+			}
+
+			if (victim == soundVoices_.size())
+			{
+				return false;
+			}
+			const SoundVoice& voice = soundVoices_[victim];
+			if (voice.priority_ > priority || (voice.priority_ == priority && victimAudibility >= audibility))
+			{
+				return false;
+			}
+			victims[i] = victim;
+		}
+		return true;
+	}
+
+	void AudioSystem::StealSoundVoice(unsigned index)
+	{
+		SoundVoice& voice = soundVoices_[index];
+		++soundCullStats_[(int)voice.group_].stolen_;
+		if (voice.channel_ != nullptr)
+		{
+			CheckFMODResult(
+				IgnoreEndedChannel(backend_->StopChannel(voice.channel_)), __func__);
+		}
+		FreeSoundVoice(index);
+	}
+
+	void AudioSystem::FreeSoundVoice(unsigned index)
+	{
+		SoundVoice& voice = soundVoices_[index];
+		--voice.entry_->playing_;
+		--soundGroupVoices_[(int)voice.group_];
+		--soundGroupVoices_[(int)AudioChannelGroup::Master];
+
+		// Swap the last active voice into the freed slot
+		uint16_t last = activeSoundVoices_.back();
+		activeSoundVoices_[voice.slot_] = last;
+		soundVoices_[last].slot_ = voice.slot_;
+		activeSoundVoices_.pop_back();
+
+		// A new generation makes every handle to the previous play stale
+		voice.channel_ = nullptr;
+		voice.pending_ = false;
+		voice.entry_ = nullptr;
+		voice.generation_ = (voice.generation_ == 0xFFFF) ? 1 : (uint16_t)(voice.generation_ + 1);
+		voice.slot_ = freeSoundVoice_;
+		freeSoundVoice_ = (uint16_t)index;
+	}
+
+	bool AudioSystem::StartSoundVoice(SoundVoice& voice)
+	{
+		FMOD::Channel* channel = nullptr;
+		if (!CheckFMODResult(backend_->PlaySound(voice.entry_->sound_, channelGroups_[(int)voice.group_], true, &channel), __func__))
+		{
+			return false;
+		}
+
+		// The pitch scales the default frequency of the sound, so the channel's frequency is never read
+		CheckFMODResult(
+			backend_->SetChannelVolume(channel, voice.volume_), __func__);
+		if (voice.pitch_ != 1.0f)
+		{
+			CheckFMODResult(
+				backend_->SetChannelPitch(channel, voice.pitch_), __func__);
+		}
+		CheckFMODResult(
+			backend_->SetChannelPaused(channel, false), __func__);
+		voice.channel_ = channel;
+		return true;
+	}
+
+	void AudioSystem::StartSoundVoices()
+	{
+		for (SoundHandle handle : pendingSoundVoices_)
+		{
+			SoundVoice* voice = FindSoundVoice(handle);
+			if (voice == nullptr)
+			{
+				continue;
+			}
+
+			// A voice that already has a channel was merged into, only its volume changed
+			voice->pending_ = false;
+			if (voice->channel_ != nullptr)
+			{
+				CheckFMODResult(
+					IgnoreEndedChannel(backend_->SetChannelVolume(voice->channel_, voice->volume_)), __func__);
+			}
+			else if (!StartSoundVoice(*voice))
+			{
+				FreeSoundVoice(handle.value_ & 0xFFFF);
+			}
+		}
+		pendingSoundVoices_.clear();
+	}
+
+	SoundHandle AudioSystem::MergeSoundPlay(const std::string& filename, const SoundPlayParams& params)
+	{
+		if (soundDedupWindow_ <= 0.0f)
+		{
+			return SoundHandle();
+		}
+
+		auto it = sounds_.find(filename);
+		if (it == sounds_.end() || soundClock_ - it->second.lastPlayTime_ > soundDedupWindow_)
+		{
+			return SoundHandle();
+		}
+		SoundHandle handle = it->second.lastPlay_;
+		SoundVoice* voice = FindSoundVoice(handle);
+		if (voice == nullptr || voice->tag_ != params.tag_)
+		{
+			return SoundHandle();
+		}
+
+		// Identical plays add up in power, but never past full volume unless one of them already was
+		float volume = params.volume_ * GetDistanceAttenuation(voice->group_, params.distance_);
+		float summed = std::sqrt(voice->volume_ * voice->volume_ + volume * volume);
+		voice->volume_ = std::max(std::max(voice->volume_, volume), std::min(summed, 1.0f));
+		voice->priority_ = std::max(voice->priority_, params.priority_);
+		if (!voice->pending_ && voice->channel_ != nullptr)
+		{
+			voice->pending_ = true;
+			pendingSoundVoices_.push_back(handle);
+		}
+		++soundCullStats_[(int)voice->group_].merged_;
+		return handle;
+	}
+
+	SoundHandle AudioSystem::GetSoundHandle(unsigned index) const
+	{
+		SoundHandle handle;
+		handle.value_ = ((uint32_t)soundVoices_[index].generation_ << 16) | index;
+		return handle;
+	}
+
+	AudioSystem::EventRecord* AudioSystem::FindEvent(AudioId event)
+	{
+		const unsigned* index = eventIndices_.Find(event);
+		return (index != nullptr) ? &events_[*index] : nullptr;
+	}
+
+	AudioSystem::EventVoice* AudioSystem::FindEventVoice(EventInstanceHandle instance)
+	{
+		if (instance.event_ >= events_.size() || instance.generation_ == 0)
+		{
+			return nullptr;
+		}
+
+		const EventRecord& record = events_[instance.event_];
+		if (instance.voice_ < record.voiceCount_)
+		{
+			EventVoice& voice = eventVoices_[record.firstVoice_ + instance.voice_];
+			if (voice.instance_ != nullptr && voice.generation_ == instance.generation_)
+			{
+				return &voice;
+			}
+		}
+
+		// A reserved play can move the voice it replaces, which keeps its generation elsewhere in the pool
+		for (unsigned i = 0; i < record.voiceCount_; ++i)
+		{
+			EventVoice& voice = eventVoices_[record.firstVoice_ + i];
+			if (voice.instance_ != nullptr && voice.generation_ == instance.generation_)
+			{
+				return &voice;
+			}
+		}
+		return nullptr;
+	}
+
+	EventInstanceHandle AudioSystem::ReserveEventVoice(AudioId event)
+	{
+		std::lock_guard<std::mutex> lock(eventReservationMutex_);
+		EventInstanceHandle handle;
+		const unsigned* index = eventIndices_.Find(event);
+		if (index == nullptr || events_[*index].description_ == nullptr)
+		{
+			return handle;
+		}
+
+		// The slot cycles through the pool, the voice the oldest steal mode would take under load
+		EventRecord& record = events_[*index];
+		handle.event_ = *index;
+		handle.voice_ = (unsigned short)(record.nextReservedVoice_++ % record.voiceCount_);
+		handle.generation_ = NextEventGeneration(record);
+		return handle;
+	}
+
+	EventInstanceHandle AudioSystem::StartEventVoice(EventRecord& record, int priority, EventInstanceHandle reserved)
+	{
+		EventInstanceHandle handle;
+		unsigned voiceIndex = AcquireEventVoice(record, priority);
+		if (voiceIndex == record.voiceCount_)
+		{
+			// Every voice is busy with a more important play
+			return handle;
+		}
+
+		// A reserved play takes the slot its handle names, the voice there moves to the acquired slot
+		if (reserved.IsValid() && reserved.voice_ < record.voiceCount_ && reserved.voice_ != voiceIndex)
+		{
+			std::swap(eventVoices_[record.firstVoice_ + voiceIndex], eventVoices_[record.firstVoice_ + reserved.voice_]);
+			voiceIndex = reserved.voice_;
+		}
+
+		EventVoice& voice = eventVoices_[record.firstVoice_ + voiceIndex];
+		if (reserved.IsValid())
+		{
+			voice.generation_ = reserved.generation_;
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock = LockEventReservations();
+			voice.generation_ = NextEventGeneration(record);
+		}
+		voice.startTime_ = audioTime_;
+		voice.lastActiveTime_ = audioTime_;
+		voice.priority_ = priority;
+		if (!CheckFMODResult(backend_->StartInstance(voice.instance_), __func__, record.id_))
+		{
+			return handle;
+		}
+
+		handle.event_ = (unsigned)(&record - events_.data());
+		handle.voice_ = (unsigned short)voiceIndex;
+		handle.generation_ = voice.generation_;
+		return handle;
+	}
+
+	unsigned short AudioSystem::NextEventGeneration(EventRecord& record)
+	{
+		// Generations count the plays of the whole pool, 0 is never used
+		record.generation_ = (record.generation_ == 0xFFFF) ? 1 : (unsigned short)(record.generation_ + 1);
+		return record.generation_;
+	}
+
+	std::unique_lock<std::mutex> AudioSystem::LockEventReservations()
+	{
+		// Other threads only reserve plays while the update thread runs
+		if (audioThreadId_.load(std::memory_order_acquire) != std::thread::id())
+		{
+			return std::unique_lock<std::mutex>(eventReservationMutex_);
+		}
+		return std::unique_lock<std::mutex>(eventReservationMutex_, std::defer_lock);
+	}
+
+	FMOD::Studio::EventInstance* AudioSystem::CreateVoiceInstance(EventRecord& record, unsigned voice)
+	{
+		EventVoice& eventVoice = eventVoices_[record.firstVoice_ + voice];
+		if (eventVoice.instance_ == nullptr && record.description_ != nullptr)
+		{
+			if (!CheckFMODResult(backend_->CreateInstance(record.description_, &eventVoice.instance_), __func__, record.id_))
+			{
+				eventVoice.instance_ = nullptr;
+				return nullptr;
+			}
+			if (record.createdVoices_++ == 0)
+			{
+				residentEvents_.push_back((unsigned)(&record - events_.data()));
+			}
+			++residentInstanceCount_;
+		}
+		eventVoice.lastActiveTime_ = audioTime_;
+		return eventVoice.instance_;
+	}
+
+	void AudioSystem::ReleaseVoiceInstance(EventRecord& record, unsigned voice)
+	{
+		EventVoice& eventVoice = eventVoices_[record.firstVoice_ + voice];
+		if (eventVoice.instance_ == nullptr)
+		{
+			return;
+		}
+
+		// FMOD unloads the sample data with the last instance unless the event was prefetched
+		CheckFMODResult(
+			backend_->ReleaseInstance(eventVoice.instance_), __func__, record.id_);
+		eventVoice.instance_ = nullptr;
+		--residentInstanceCount_;
+		if (--record.createdVoices_ == 0)
+		{
+			auto resident = std::find(residentEvents_.begin(), residentEvents_.end(), (unsigned)(&record - events_.data()));
+			*resident = residentEvents_.back();
+			residentEvents_.pop_back();
+		}
+	}
+
+	void AudioSystem::EnsureEventInstance(EventRecord& record)
+	{
+		if (record.createdVoices_ == 0)
+		{
+			CreateVoiceInstance(record, 0);
+		}
+	}
+
+	unsigned AudioSystem::AcquireEventVoice(EventRecord& record, int priority)
+	{
+		// Prefer a created voice that has stopped, then a voice that was never created
+		unsigned uncreated = record.voiceCount_;
+		for (unsigned i = 0; i < record.voiceCount_; ++i)
+		{
+			EventVoice& voice = eventVoices_[record.firstVoice_ + i];
+			if (voice.instance_ == nullptr)
+			{
+				uncreated = (uncreated == record.voiceCount_) ? i : uncreated;
+				continue;
+			}
+
+			FMOD_STUDIO_PLAYBACK_STATE state = FMOD_STUDIO_PLAYBACK_STOPPED;
+			CheckFMODResult(
+				backend_->GetInstancePlaybackState(voice.instance_, &state), __func__, record.id_);
+			if (state == FMOD_STUDIO_PLAYBACK_STOPPED)
+			{
+				return i;
+			}
+		}
+		if (uncreated != record.voiceCount_ && CreateVoiceInstance(record, uncreated) != nullptr)
+		{
+			return uncreated;
+		}
+
+		// Every voice is playing, steal one that is not more important than the new play
+		unsigned stolen = record.voiceCount_;
+		float stolenVolume = 0.0f;
+		for (unsigned i = 0; i < record.voiceCount_; ++i)
+		{
+			EventVoice& voice = eventVoices_[record.firstVoice_ + i];
+			if (voice.instance_ == nullptr || voice.priority_ > priority)
+			{
+				continue;
+			}
+
+			float volume = 0.0f;
+			if (record.stealMode_ == EventStealMode::Quietest)
+			{
+				CheckFMODResult(
+					backend_->GetInstanceFinalVolume(voice.instance_, &volume), __func__, record.id_);
+			}
+
+			if (stolen == record.voiceCount_)
+			{
+				stolen = i;
+				stolenVolume = volume;
+				continue;
+			}
+
+			const EventVoice& candidate = eventVoices_[record.firstVoice_ + stolen];
+			bool older = voice.startTime_ < candidate.startTime_;
+			bool better = false;
+			switch (record.stealMode_)
+			{
+			case EventStealMode::Oldest:
+				better = older;
+				break;
+			case EventStealMode::Quietest:
+				better = (volume < stolenVolume) || (volume == stolenVolume && older);
+				break;
+			case EventStealMode::LowestPriority:
+				better = (voice.priority_ < candidate.priority_) || (voice.priority_ == candidate.priority_ && older);
+				break;
+			}
+			if (better)
+			{
+				stolen = i;
+				stolenVolume = volume;
+			}
+		}
+
+		if (stolen != record.voiceCount_)
+		{
+			CheckFMODResult(
+				backend_->StopInstance(eventVoices_[record.firstVoice_ + stolen].instance_, FMOD_STUDIO_STOP_IMMEDIATE), __func__, record.id_);
+		}
+		return stolen;
+	}
+
+	void AudioSystem::SetEventPoolSize(AudioId event, unsigned size, EventStealMode stealMode)
+	{
+		if (RouteThroughCommands())
+		{
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::SetEventPoolSize;
+			command.target_ = event;
+			command.index_ = size;
+			command.priority_ = (int)stealMode;
+			commands_.Enqueue(command);
+			return;
+		}
+
+		EventRecord* record = FindEvent(event);
+		if (record == nullptr)
+		{
+			LogWarning("Tried to size the voice pool of an unknown FMOD studio event.");
+			return;
+		}
+
+		size = Clamp(size, 1u, MAX_EVENT_POOL_SIZE);
+		record->stealMode_ = stealMode;
+		if (size <= record->voiceCount_)
+		{
+			for (unsigned i = size; i < record->voiceCount_; ++i)
+			{
+				EventVoice& voice = eventVoices_[record->firstVoice_ + i];
+				if (voice.instance_ != nullptr)
+				{
+					CheckFMODResult(
+						backend_->StopInstance(voice.instance_, FMOD_STUDIO_STOP_IMMEDIATE), __func__, event);
+				}
+				ReleaseVoiceInstance(*record, i);
+			}
+			FreeEventVoices(record->firstVoice_ + size, record->voiceCount_ - size);
+		}
+		else
+		{
+			// Grow in place when the slots after the pool are free, otherwise move the pool to a free
+			// range. Moved voices keep their generations so handles stay valid
+			unsigned end = record->firstVoice_ + record->voiceCount_;
+			unsigned extra = size - record->voiceCount_;
+			auto next = std::find_if(freeEventVoices_.begin(), freeEventVoices_.end(),
+				[end](const EventVoiceRange& range) { return range.first_ == end; });
+			if (end == eventVoices_.size())
+			{
+				eventVoices_.resize(end + extra);
+			}
+			else if (next != freeEventVoices_.end() && next->count_ >= extra)
+			{
+				next->first_ += extra;
+				next->count_ -= extra;
+				if (next->count_ == 0)
+				{
+					freeEventVoices_.erase(next);
+				}
+			}
+			else
+			{
+				unsigned firstVoice = AllocateEventVoices(size);
+				std::copy(eventVoices_.begin() + record->firstVoice_,
+					eventVoices_.begin() + end,
+					eventVoices_.begin() + firstVoice);
+				for (unsigned i = record->firstVoice_; i < end; ++i)
+				{
+					eventVoices_[i] = EventVoice();
+				}
+				FreeEventVoices(record->firstVoice_, record->voiceCount_);
+				record->firstVoice_ = firstVoice;
+			}
+
+			// Added slots start empty, their first play takes the next generation of the pool
+			for (unsigned i = record->voiceCount_; i < size; ++i)
+			{
+				eventVoices_[record->firstVoice_ + i] = EventVoice();
+			}
+		}
+		unsigned previousCount = record->voiceCount_;
+		{
+			std::unique_lock<std::mutex> lock = LockEventReservations();
+			record->voiceCount_ = size;
+		}
+
+		// Eager pools are warmed up front so plays never create instances
+		if (eventInstanceMode_ == EventInstanceMode::Eager)
+		{
+			for (unsigned i = previousCount; i < size; ++i)
+			{
+				CreateVoiceInstance(*record, i);
+			}
+		}
+	}
+
+	unsigned AudioSystem::AllocateEventVoices(unsigned count)
+	{
+		for (auto it = freeEventVoices_.begin(); it != freeEventVoices_.end(); ++it)
+		{
+			if (it->count_ >= count)
+			{
+				unsigned first = it->first_;
+				it->first_ += count;
+				it->count_ -= count;
+				if (it->count_ == 0)
+				{
+					freeEventVoices_.erase(it);
+				}
+				return first;
+			}
+		}
+
+		// A free range at the end of the array is extended rather than left behind
+		unsigned first = (unsigned)eventVoices_.size();
+		if (!freeEventVoices_.empty() && freeEventVoices_.back().first_ + freeEventVoices_.back().count_ == first)
+		{
+			first = freeEventVoices_.back().first_;
+			freeEventVoices_.pop_back();
+		}
+		eventVoices_.resize(first + count);
+		return first;
+	}
+
+	void AudioSystem::FreeEventVoices(unsigned first, unsigned count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		// Keep the ranges sorted and merge the neighbours, so freed pools can be reused whole
+		auto it = std::lower_bound(freeEventVoices_.begin(), freeEventVoices_.end(), first,
+			[](const EventVoiceRange& range, unsigned key) { return range.first_ < key; });
+		it = freeEventVoices_.insert(it, EventVoiceRange{ first, count });
+		if (it + 1 != freeEventVoices_.end() && it->first_ + it->count_ == (it + 1)->first_)
+		{
+			it->count_ += (it + 1)->count_;
+			freeEventVoices_.erase(it + 1);
+		}
+		if (it != freeEventVoices_.begin() && (it - 1)->first_ + (it - 1)->count_ == it->first_)
+		{
+			(it - 1)->count_ += it->count_;
+			freeEventVoices_.erase(it);
+		}
+	}
+
+	void AudioSystem::ReleaseIdleEventInstances()
+	{
+		size_t i = 0;
+		while (i < residentEvents_.size())
+		{
+			EventRecord& record = events_[residentEvents_[i]];
+			for (unsigned voice = 0; voice < record.voiceCount_; ++voice)
+			{
+				EventVoice& eventVoice = eventVoices_[record.firstVoice_ + voice];
+				if (eventVoice.instance_ == nullptr)
+				{
+					continue;
+				}
+
+				FMOD_STUDIO_PLAYBACK_STATE state = FMOD_STUDIO_PLAYBACK_STOPPED;
+				CheckFMODResult(
+					backend_->GetInstancePlaybackState(eventVoice.instance_, &state), __func__, record.id_);
+				if (state != FMOD_STUDIO_PLAYBACK_STOPPED)
+				{
+					eventVoice.lastActiveTime_ = audioTime_;
+				}
+				else if (audioTime_ - eventVoice.lastActiveTime_ >= idleInstanceTimeout_)
+				{
+					ReleaseVoiceInstance(record, voice);
+				}
+			}
+
+			// Releasing the last voice swaps another event into this slot
+			if (record.createdVoices_ > 0)
+			{
+				++i;
+			}
+		}
+	}
+
+	void AudioSystem::SetUpdateMode(AudioUpdateMode mode, float tickRate)
+	{
+		updateMode_ = mode;
+		tickRate_ = Clamp(tickRate, MIN_AUDIO_TICK_RATE, MAX_AUDIO_TICK_RATE);
+	}
+
+	AudioThreadStats AudioSystem::GetAudioThreadStats() const
+	{
+		std::lock_guard<std::mutex> lock(threadStatsMutex_);
+		return threadStats_;
+	}
+
+	void AudioSystem::SetEventInstanceMode(EventInstanceMode mode, float idleTimeout)
+	{
+		eventInstanceMode_ = mode;
+		idleInstanceTimeout_ = idleTimeout;
+	}
+
+	void AudioSystem::SetPrefetchList(const std::vector<AudioId>& events)
+	{
+		// The list does not fit a command, and is only set between levels, so it waits for the tick instead
+		std::unique_lock<std::mutex> lock = LockStudio();
+
+		// Flag everything still wanted, then unload whatever the previous list had that is no longer wanted
+		for (unsigned index : prefetchedEvents_)
+		{
+			events_[index].prefetched_ = false;
+		}
+		std::vector<unsigned> previous;
+		previous.swap(prefetchedEvents_);
+
+		for (AudioId event : events)
+		{
+			EventRecord* record = FindEvent(event);
+			if (record == nullptr || record->description_ == nullptr || record->prefetched_)
+			{
+				continue;
+			}
+
+			unsigned index = (unsigned)(record - events_.data());
+			bool wasPrefetched = std::find(previous.begin(), previous.end(), index) != previous.end();
+			if (!wasPrefetched)
+			{
+				CheckFMODResult(
+					backend_->LoadSampleData(record->description_), __func__, event);
+			}
+			record->prefetched_ = true;
+			prefetchedEvents_.push_back(index);
+		}
+
+		for (unsigned index : previous)
+		{
+			if (!events_[index].prefetched_)
+			{
+				CheckFMODResult(
+					backend_->UnloadSampleData(events_[index].description_), __func__, events_[index].id_);
+			}
+		}
+	}
+
+	EventResidencyStats AudioSystem::GetEventResidencyStats() const
+	{
+		std::unique_lock<std::mutex> lock = LockStudio();
+		EventResidencyStats stats;
+		stats.residentInstances_ = residentInstanceCount_;
+		stats.prefetchedEvents_ = (unsigned)prefetchedEvents_.size();
+		stats.sampleDataBytes_ = 0;
+
+		FMOD_STUDIO_MEMORY_USAGE memoryUsage;
+		if (backend_ != nullptr && backend_->GetStudioMemoryUsage(&memoryUsage) == FMOD_OK)
+		{
+			stats.sampleDataBytes_ = memoryUsage.sampledata;
+		}
+		return stats;
+	}
+
+	void AudioSystem::CacheEventParameters(EventRecord& record)
+	{
+		record.firstParameter_ = (unsigned)eventParameters_.size();
+		record.parameterCount_ = 0;
+		if (record.description_ == nullptr)
+		{
+			return;
+		}
+
+		int count = 0;
+		CheckFMODResult(
+			backend_->GetParameterCount(record.description_, &count), __func__, record.id_);
+		for (int i = 0; i < count; ++i)
+		{
+			FMOD_STUDIO_PARAMETER_DESCRIPTION description;
+			if (!CheckFMODResult(backend_->GetParameterDescription(record.description_, i, &description), __func__, record.id_))
+			{
+				continue;
+			}
+
+			// Read-only and automatic parameters cannot be set, so there is no point caching them
+			if (description.flags & (FMOD_STUDIO_PARAMETER_READONLY | FMOD_STUDIO_PARAMETER_AUTOMATIC))
+			{
+				continue;
+			}
+
+			EventParameter parameter;
+			parameter.name_ = GetParameterId(description.name);
+			parameter.id_ = description.id;
+			eventParameters_.push_back(parameter);
+		}
+		record.parameterCount_ = (unsigned)eventParameters_.size() - record.firstParameter_;
+	}
+
+	const AudioSystem::EventParameter* AudioSystem::FindEventParameter(const EventRecord& record, const char* parameter) const
+	{
+		return FindEventParameter(record, GetParameterId(parameter));
+	}
+
+	const AudioSystem::EventParameter* AudioSystem::FindEventParameter(const EventRecord& record, AudioId name) const
+	{
+		// Events rarely have more than a handful of parameters, so a linear scan beats a table
+		for (unsigned i = 0; i < record.parameterCount_; ++i)
+		{
+			const EventParameter& cached = eventParameters_[record.firstParameter_ + i];
+			if (cached.name_ == name)
+			{
+				return &cached;
+			}
+		}
+		return nullptr;
+	}
+
+	FMOD::Studio::Bus* AudioSystem::FindBus(AudioId bus) const
+	{
+		FMOD::Studio::Bus* const* studioBus = buses_.Find(bus);
+		return (studioBus != nullptr) ? *studioBus : nullptr;
+	}
+
+	void AudioSystem::Tick(float dt)
+	{
+		audioTime_ += dt;
+		audioFrame_.fetch_add(1, std::memory_order_relaxed);
+
+		// Commands and game parameters from other threads go out with this tick's studio update
+		ExecuteCommands();
+		if (studioReady_)
+		{
+			FlushGameParameters();
+			UpdateMixFade(dt);
+		}
+		CheckFMODResult(
+			backend_->Update(), __func__);
+
+		if (eventInstanceMode_ == EventInstanceMode::Lazy && audioTime_ >= nextIdleSweepTime_)
+		{
+			ReleaseIdleEventInstances();
+			nextIdleSweepTime_ = audioTime_ + IDLE_SWEEP_INTERVAL;
+		}
+
+		// Keep polling the async bank loads until the studio content is resolved
+		if (!studioReady_)
+		{
+			PollBankLoading();
+		}
+	}
+
+	void AudioSystem::RunUpdateThread()
+	{
+		// Initialize publishes the thread before it can tick, so no direct studio call overlaps the first tick
+		while (audioThreadId_.load(std::memory_order_acquire) != std::this_thread::get_id())
+		{
+			std::this_thread::yield();
+		}
+
+		typedef std::chrono::steady_clock Clock;
+		const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / tickRate_));
+		double totalJitter = 0.0;
+		double totalUpdateTime = 0.0;
+		Clock::time_point lastStart = Clock::now();
+		Clock::time_point scheduled = lastStart + period;
+
+		while (!stopUpdateThread_)
+		{
+			std::this_thread::sleep_until(scheduled);
+			Clock::time_point start = Clock::now();
+			{
+				std::lock_guard<std::mutex> lock(studioMutex_);
+				Tick(std::chrono::duration<float>(start - lastStart).count());
+			}
+			Clock::time_point end = Clock::now();
+
+			float jitter = std::chrono::duration<float>(start - scheduled).count();
+			float updateTime = std::chrono::duration<float>(end - start).count();
+			totalJitter += jitter;
+			totalUpdateTime += updateTime;
+			{
+				std::lock_guard<std::mutex> lock(threadStatsMutex_);
+				++threadStats_.ticks_;
+				threadStats_.averageJitter_ = (float)(totalJitter / (double)threadStats_.ticks_);
+				threadStats_.maxJitter_ = std::max(threadStats_.maxJitter_, jitter);
+				threadStats_.averageUpdateTime_ = (float)(totalUpdateTime / (double)threadStats_.ticks_);
+				threadStats_.maxUpdateTime_ = std::max(threadStats_.maxUpdateTime_, updateTime);
+			}
+
+			// A tick that overran its period skips the missed ticks instead of bursting to catch up
+			lastStart = start;
+			scheduled += period;
+			if (scheduled < end)
+			{
+				scheduled = end + period;
+			}
+		}
+	}
+
+	bool AudioSystem::RouteThroughCommands() const
+	{
+		std::thread::id audioThread = audioThreadId_.load(std::memory_order_acquire);
+		return audioThread != std::thread::id() && audioThread != std::this_thread::get_id();
+	}
+
+	std::unique_lock<std::mutex> AudioSystem::LockStudio() const
+	{
+		// The update thread already holds the lock for the whole tick
+		if (RouteThroughCommands())
+		{
+			return std::unique_lock<std::mutex>(studioMutex_);
+		}
+		return std::unique_lock<std::mutex>(studioMutex_, std::defer_lock);
+	}
+
+	void AudioSystem::ExecuteCommands()
+	{
+		// Only drain what fits in the queue, so producers that keep pushing cannot stall the frame
+		AudioCommand command;
+		for (size_t i = 0; i < AUDIO_COMMAND_CAPACITY && commands_.Dequeue(command); ++i)
+		{
+			ExecuteCommand(command);
+		}
+
+		// Producers may run on threads that must not log, so overflows are reported here
+		uint64_t overflows = commands_.GetStats().overflows_;
+		if (overflows != reportedCommandOverflows_)
+		{
+			LogWarning("Audio commands were dropped because the command queue was full: ", overflows - reportedCommandOverflows_);
+			reportedCommandOverflows_ = overflows;
+		}
+	}
+
+	void AudioSystem::ExecuteCommand(const AudioCommand& command)
+	{
+		// Producers cannot see the lookup tables, so unknown targets are skipped rather than reported as errors
+		switch (command.type_)
+		{
+		case AudioCommandType::PlayEvent:
+			if (command.generation_ != 0)
+			{
+				// A play made through PlayEvent, whose handle was already returned
+				if (command.index_ < events_.size() && events_[command.index_].id_ == command.target_ &&
+					events_[command.index_].description_ != nullptr)
+				{
+					EventInstanceHandle reserved;
+					reserved.event_ = command.index_;
+					reserved.voice_ = command.voice_;
+					reserved.generation_ = command.generation_;
+					StartEventVoice(events_[command.index_], command.priority_, reserved);
+				}
+			}
+			else if (FindEvent(command.target_) != nullptr)
+			{
+				PlayEvent(command.target_, command.priority_);
+			}
+			break;
+		case AudioCommandType::StopEvent:
+			if (FindEvent(command.target_) != nullptr)
+			{
+				StopEvent(command.target_);
+			}
+			break;
+		case AudioCommandType::SetEventParameter:
+		{
+			EventHandle event = GetEventHandle(command.target_);
+			if (event.IsValid())
+			{
+				const EventParameter* cached = FindEventParameter(events_[event.index_], command.parameter_);
+				if (cached != nullptr)
+				{
+					ParamHandle parameter;
+					parameter.id_ = cached->id_;
+					parameter.valid_ = true;
+					SetEventParameter(event, parameter, command.value_);
+				}
+			}
+			break;
+		}
+		case AudioCommandType::SetBusVolume:
+			if (FindBus(command.target_) != nullptr)
+			{
+				SetBusVolume(command.target_, command.value_);
+			}
+			break;
+		case AudioCommandType::SetBusPaused:
+			if (FindBus(command.target_) != nullptr)
+			{
+				SetBusPaused(command.target_, command.value_ != 0.0f);
+			}
+			break;
+		case AudioCommandType::StopAllEvents:
+			StopAllEvents();
+			break;
+		case AudioCommandType::MuteAllBuses:
+			MuteAllBuses();
+			break;
+		case AudioCommandType::UnmuteAllBuses:
+			UnmuteAllBuses();
+			break;
+		case AudioCommandType::CaptureMixSnapshot:
+			CaptureMixSnapshot(command.target_);
+			break;
+		case AudioCommandType::ApplyMixSnapshot:
+			ApplyMixSnapshot(command.target_, command.value_);
+			break;
+		case AudioCommandType::SetMixSnapshotBus:
+			SetMixSnapshotBus(command.target_, command.parameter_, command.value_, command.priority_ != 0);
+			break;
+		case AudioCommandType::BusStopAllEvents:
+			if (FindBus(command.target_) != nullptr)
+			{
+				BusStopAllEvents(command.target_);
+			}
+			break;
+		case AudioCommandType::SetEventPoolSize:
+			if (FindEvent(command.target_) != nullptr)
+			{
+				SetEventPoolSize(command.target_, command.index_, (EventStealMode)command.priority_);
+			}
+			break;
+		case AudioCommandType::StopInstance:
+		case AudioCommandType::SetInstanceParameter:
+		{
+			// Stale handles are ignored, as they are by the direct calls
+			EventInstanceHandle instance;
+			instance.event_ = command.index_;
+			instance.voice_ = command.voice_;
+			instance.generation_ = command.generation_;
+			if (command.type_ == AudioCommandType::StopInstance)
+			{
+				StopEvent(instance);
+				break;
+			}
+			ParamHandle parameter;
+			parameter.id_.data1 = command.parameterId_[0];
+			parameter.id_.data2 = command.parameterId_[1];
+			parameter.valid_ = true;
+			SetEventParameter(instance, parameter, command.value_);
+			break;
+		}
+		case AudioCommandType::SetHandleParameter:
+			if (command.index_ < events_.size())
+			{
+				EventHandle event;
+				event.index_ = command.index_;
+				ParamHandle parameter;
+				parameter.id_.data1 = command.parameterId_[0];
+				parameter.id_.data2 = command.parameterId_[1];
+				parameter.valid_ = true;
+				SetEventParameter(event, parameter, command.value_);
+			}
+			break;
+		}
 	}
 }
\ No newline at end of file
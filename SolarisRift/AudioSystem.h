@@ -20,10 +20,24 @@ COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
 
 #include <FMOD/fmod_studio.hpp>
 #include <array>
-#include <stack>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <Event.h>
 #include <DeckedOutObject.h>
+#include <AudioBackend.h>
 #include <AudioChannel.h>
+#include <AudioCommandQueue.h>
+#include <AudioErrorLog.h>
+#include <AudioId.h>
+#include <AudioManifest.h>
+#include <AudioMixSnapshots.h>
+#include <AudioPack.h>
+#include <AudioSoundContainer.h>
+#include <AudioSoundManifest.h>
+#include <AudioStats.h>
 
 namespace DeckedOut
 {
@@ -47,6 +61,251 @@ namespace DeckedOut
 		Stream  //!< Stream audio channel group.
 	};
 
+	/**
+	 * \brief Enumeration representing how InitializeStudio loads banks.
+	 */
+	enum class StudioLoadMode
+	{
+		Blocking, //!< Load every bank on the calling thread before returning.
+		Async     //!< Issue every bank load up front and resolve events from Update once they finish.
+	};
+
+	/**
+	 * \brief Enumeration representing when event instances are created.
+	 */
+	enum class EventInstanceMode
+	{
+		Eager, //!< Create an instance of every event when the studio is resolved.
+		Lazy   //!< Create an instance the first time it is needed and release it once idle.
+	};
+
+	/**
+	 * \brief Enumeration representing which thread ticks the FMOD Studio system.
+	 */
+	enum class AudioUpdateMode
+	{
+		GameFrame, //!< Update ticks the studio once per game frame.
+		Thread     //!< A thread owned by the audio system ticks the studio at a fixed rate.
+	};
+
+	/**
+	 * \brief Struct reporting the timing of the audio update thread. Times are in seconds.
+	 */
+	struct AudioThreadStats
+	{
+		float tickRate_; //!< Ticks per second the thread aims for.
+		unsigned long long ticks_; //!< Ticks since the thread started.
+		float averageJitter_; //!< Mean delay between the scheduled and the actual start of a tick.
+		float maxJitter_; //!< Longest delay between the scheduled and the actual start of a tick.
+		float averageUpdateTime_; //!< Mean duration of a tick.
+		float maxUpdateTime_; //!< Longest duration of a tick.
+	};
+
+	/**
+	 * \brief Enumeration representing the game-state parameters, backed by global parameters of the studio project.
+	 */
+	enum class GameParameter
+	{
+		Pausing, //!< Whether the pause screen is open, 0 or 1.
+		Combat,  //!< Intensity of the current fight.
+		Health,  //!< Health of the player.
+		Count    //!< Number of game parameters.
+	};
+
+	/**
+	 * \brief Struct reporting how much studio content is resident.
+	 */
+	struct EventResidencyStats
+	{
+		unsigned residentInstances_; //!< Number of event instances currently created.
+		unsigned prefetchedEvents_; //!< Number of events whose sample data was prefetched.
+		int sampleDataBytes_; //!< Bytes of sample data loaded by FMOD studio.
+	};
+
+	/**
+	 * \brief Struct reporting the state of the sound cache.
+	 */
+	struct SoundCacheStats
+	{
+		size_t budgetBytes_; //!< Byte budget of the cache.
+		size_t residentBytes_; //!< Bytes used by the loaded sounds.
+		unsigned residentSounds_; //!< Number of loaded sounds.
+		unsigned hits_; //!< Plays that found their sound loaded.
+		unsigned misses_; //!< Plays that had to load their sound.
+		unsigned evictions_; //!< Sounds unloaded to stay under the budget.
+	};
+
+	/**
+	 * \brief Enumeration representing the progress of an asynchronous sound load.
+	 */
+	enum class SoundLoadState
+	{
+		Loading, //!< The sound is still being opened.
+		Ready,   //!< The sound can be played.
+		Failed   //!< The sound could not be opened, or was unloaded while loading.
+	};
+
+	/**
+	 * \brief Enumeration representing what PlaySound does with a sound that is still loading.
+	 */
+	enum class PendingPlayPolicy
+	{
+		Queue, //!< Play the sound from Update once its load completes.
+		Drop   //!< Ignore the play.
+	};
+
+	/**
+	 * \brief Struct holding the shared progress of an asynchronous sound load.
+	 */
+	struct SoundLoadStatus
+	{
+		SoundLoadState state_ = SoundLoadState::Loading; //!< Progress of the load.
+	};
+
+	/**
+	 * \brief Struct describing a play requested from AudioSystem::PlaySound.
+	 */
+	struct SoundPlayParams
+	{
+		float volume_ = 1.0f; //!< The volume of the sound.
+		float pitch_ = 0.0f; //!< The pitch of the sound, in semitones.
+		AudioId tag_; //!< A tag used to change the volume of related sounds together.
+		int priority_ = 0; //!< Plays of higher priority take the voices of lower ones when a group is at its cap.
+		float distance_ = 0.0f; //!< Distance from the listener, only used to estimate audibility.
+	};
+
+	/**
+	 * \brief Struct describing one play of AudioSystem::PlaySoundBatch.
+	 */
+	struct SoundPlayRequest
+	{
+		std::string filename_; //!< The name of the sound file to play.
+		SoundPlayParams params_; //!< The volume, pitch, tag, priority and distance of the play.
+	};
+
+	/**
+	 * \brief Struct holding the rules PlaySound uses to cull the plays of a channel group.
+	 */
+	struct SoundCullSettings
+	{
+		unsigned maxVoices_ = 0; //!< Most sounds the group plays at once, 0 for no cap. The master cap counts every sound.
+		float minAudibility_ = 0.001f; //!< Plays estimated quieter than this volume are rejected.
+		float minDistance_ = 1.0f; //!< Distance up to which sounds are not attenuated.
+		float maxDistance_ = 0.0f; //!< Distance from which sounds are inaudible, 0 to ignore distance.
+	};
+
+	/**
+	 * \brief Struct reporting what the culling stage of PlaySound did during a frame.
+	 */
+	struct SoundCullStats
+	{
+		unsigned played_; //!< Plays given a voice.
+		unsigned culledInaudible_; //!< Plays rejected as too quiet.
+		unsigned culledByCap_; //!< Plays rejected because their group was full of sounds as important and as loud.
+		unsigned stolen_; //!< Sounds stopped to make room for a more important or louder play.
+		unsigned merged_; //!< Plays merged into a voice of the same sound started within the dedup window.
+	};
+
+	/**
+	 * \brief Handle returned by AudioSystem::LoadSoundAsync, to poll or wait on a sound load.
+	 */
+	struct SoundLoadHandle
+	{
+		std::shared_ptr<SoundLoadStatus> status_; //!< Progress shared with the audio system.
+
+		/**
+		 * \brief Checks if the handle was returned by LoadSoundAsync.
+		 * \return True if the handle tracks a load, false otherwise.
+		 */
+		bool IsValid() const { return status_ != nullptr; }
+	};
+
+	/**
+	 * \brief Handle to a sound played by AudioSystem::PlaySound. Once the sound ends or is stopped the
+	 * voice is recycled with a new generation, so calls made with the old handle do nothing.
+	 */
+	struct SoundHandle
+	{
+		uint32_t value_ = 0; //!< Voice index in the low 16 bits and voice generation in the high 16 bits, 0 if invalid.
+
+		/**
+		 * \brief Checks if the handle was returned by a successful play.
+		 * \return True if the handle refers to a voice, false otherwise.
+		 */
+		bool IsValid() const { return value_ != 0; }
+	};
+
+	/**
+	 * \brief Struct describing how long a bank took to load.
+	 */
+	struct BankLoadReport
+	{
+		std::string path_; //!< Path of the bank file.
+		float seconds_; //!< Seconds from issuing the load until the bank finished loading.
+		FMOD_STUDIO_LOADING_STATE state_; //!< Loading state of the bank.
+	};
+
+	/**
+	 * \brief Handle to an FMOD studio event, resolved once by AudioSystem::GetEventHandle.
+	 */
+	struct EventHandle
+	{
+		static constexpr unsigned INVALID_INDEX = ~0u; //!< Index of an unresolved handle.
+		unsigned index_ = INVALID_INDEX; //!< Index of the event inside the audio system.
+
+		/**
+		 * \brief Checks if the handle refers to an event.
+		 * \return True if the handle was resolved, false otherwise.
+		 */
+		bool IsValid() const { return index_ != INVALID_INDEX; }
+	};
+
+	/**
+	 * \brief Handle to an event parameter, resolved once by AudioSystem::GetParameterHandle.
+	 */
+	struct ParamHandle
+	{
+		FMOD_STUDIO_PARAMETER_ID id_ = {}; //!< FMOD identifier of the parameter.
+		bool valid_ = false; //!< Whether the parameter was found.
+
+		/**
+		 * \brief Checks if the handle refers to a parameter.
+		 * \return True if the handle was resolved, false otherwise.
+		 */
+		bool IsValid() const { return valid_; }
+	};
+
+	/**
+	 * \brief Enumeration representing which voice of a full event pool is stolen by a new play.
+	 *
+	 * Voices with a higher priority than the new play are never stolen.
+	 */
+	enum class EventStealMode
+	{
+		Oldest,        //!< Steal the voice that was started first.
+		Quietest,      //!< Steal the voice with the lowest final volume.
+		LowestPriority //!< Steal the voice with the lowest priority, the oldest one on ties.
+	};
+
+	/**
+	 * \brief Handle to one playing voice of an event, returned by AudioSystem::PlayEvent.
+	 *
+	 * The handle is checked against the generation of its voice, so it safely refers to nothing
+	 * once the voice has been stolen or restarted.
+	 */
+	struct EventInstanceHandle
+	{
+		unsigned event_ = EventHandle::INVALID_INDEX; //!< Index of the event inside the audio system.
+		unsigned short voice_ = 0; //!< Index of the voice inside the event's pool.
+		unsigned short generation_ = 0; //!< Generation of the voice when it was started.
+
+		/**
+		 * \brief Checks if the handle was returned by a successful play.
+		 * \return True if the play started a voice, false otherwise.
+		 */
+		bool IsValid() const { return event_ != EventHandle::INVALID_INDEX; }
+	};
+
 	/**
 	 * \brief Struct representing a volume change event.
 	 *
@@ -91,13 +350,108 @@ namespace DeckedOut
 		void Shutdown() override;
 
 		/**
-		 * \brief Loads a sound from a file.
+		 * \brief Sets the backend created by the next Initialize. The null backend runs the audio
+		 * system without an audio device, to measure its bookkeeping or run it on headless machines.
+		 * \param kind The backend.
+		 */
+		void SetAudioBackend(AudioBackendKind kind);
+
+		/**
+		 * \brief Gets the backend the audio system runs on. A NullAudioBackend reports the calls it received.
+		 * \return The backend, nullptr before Initialize.
+		 */
+		AudioBackend* GetAudioBackend() const;
+
+		/**
+		 * \brief Sets where the backend created by the next Initialize sends its mix. In the non-realtime
+		 * modes the mixer only advances when Update is called, one block per call, so a scripted session
+		 * renders as fast as the machine allows. The threaded update mode is not used in those modes.
+		 * \param mode The output mode.
+		 * \param wavPath In WavFile mode, the path of the WAV file, complete once the audio system is shut down.
+		 */
+		void SetOutputMode(AudioOutputMode mode, const std::string& wavPath = std::string());
+
+		/**
+		 * \brief Gets the duration of a block of the mixer, the audio rendered by every Update in the
+		 * non-realtime output modes.
+		 * \return The duration in seconds, 0 before Initialize.
+		 */
+		float GetMixBlockLength() const;
+
+		/**
+		 * \brief Sets the size of the arena FMOD allocates from, created by the next Initialize. FMOD
+		 * then never allocates from the game heap, and its allocations fail once the arena is full.
+		 * FMOD keeps its memory callbacks for the rest of the run, so the arena is only created once and
+		 * later sizes are ignored.
+		 * \param bytes The size of the arena, 0 to leave FMOD on the default heap.
+		 */
+		void SetAudioMemoryArena(size_t bytes);
+
+		/**
+		 * \brief Gets the use of the arena FMOD allocates from. Comparing the live allocations before a
+		 * level is loaded and after it is unloaded finds the allocations it leaked.
+		 * \return The use of the arena, all zeros when FMOD is on the default heap.
+		 */
+		AudioMemoryStats GetAudioMemoryStats() const;
+
+		/**
+		 * \brief Restarts the high-water marks of the arena FMOD allocates from, to measure a level on its own.
+		 */
+		void ResetAudioMemoryPeaks();
+
+		/**
+		 * \brief Sets the I/O threads FMOD reads files through, started by the next Initialize. Reads
+		 * of streams are served before reads of banks and of sounds loaded into memory, and every read
+		 * pulls the read-ahead size so sequential reads of a stream are served from memory.
+		 * \param settings The threads and read-ahead, 0 threads to leave FMOD on its blocking file I/O.
+		 */
+		void SetAudioFileIO(const AudioFileIOSettings& settings);
+
+		/**
+		 * \brief Gets the reads served by the I/O threads, with their latency histograms.
+		 * \return The stats of the reads, all zeros when FMOD uses its own file I/O.
+		 */
+		AudioFileIOStats GetAudioFileIOStats() const;
+
+		/**
+		 * \brief Loads a sound from a file. A sound listed in the sound manifest loads in the format
+		 * the manifest gives it, whatever the stream flag.
 		 * \param filename The name of the sound file to load.
 		 * \param loop Specifies whether the sound should loop.
 		 * \param stream Specifies whether the sound should be streamed.
 		 */
 		void LoadSound(const std::string& filename, bool loop = false, bool stream = false);
 
+		/**
+		 * \brief Starts loading a sound without blocking the calling thread.
+		 * \param filename The name of the sound file to load.
+		 * \param loop Specifies whether the sound should loop.
+		 * \param stream Specifies whether the sound should be streamed.
+		 * \return A handle to poll with GetSoundLoadState or wait on with WaitForSoundLoad.
+		 */
+		SoundLoadHandle LoadSoundAsync(const std::string& filename, bool loop = false, bool stream = false);
+
+		/**
+		 * \brief Gets the progress of an asynchronous sound load. Progress is picked up by Update.
+		 * \param handle The handle returned by LoadSoundAsync.
+		 * \return The state of the load, Failed for an invalid handle.
+		 */
+		SoundLoadState GetSoundLoadState(const SoundLoadHandle& handle) const;
+
+		/**
+		 * \brief Blocks until an asynchronous sound load completes.
+		 * \param handle The handle returned by LoadSoundAsync.
+		 * \param timeout The longest time to wait, in seconds.
+		 * \return True if the sound is ready, false if it failed or the wait timed out.
+		 */
+		bool WaitForSoundLoad(const SoundLoadHandle& handle, float timeout);
+
+		/**
+		 * \brief Sets what PlaySound does with a sound that is still loading asynchronously.
+		 * \param policy The policy.
+		 */
+		void SetPendingPlayPolicy(PendingPlayPolicy policy);
+
 		/**
 		 * \brief Unloads a previously loaded sound.
 		 * \param filename The name of the sound file to unload.
@@ -105,13 +459,176 @@ namespace DeckedOut
 		void UnloadSound(const std::string& filename);
 
 		/**
-		 * \brief Plays a sound.
+		 * \brief Maps a pack built by AudioPack::Build. Sounds loaded afterwards are opened from the
+		 * pack when it holds them, and from their loose file otherwise. Mounting a pack unmounts the
+		 * previous one.
+		 * \param path The path of the pack.
+		 * \return True if the pack was mapped, false if it is missing or invalid.
+		 */
+		bool MountSoundPack(const std::string& path);
+
+		/**
+		 * \brief Unloads every sound opened from the mounted pack, then unmaps it.
+		 */
+		void UnmountSoundPack();
+
+		/**
+		 * \brief Maps a manifest cooked by AudioSoundCooker::Cook. Sounds loaded afterwards open the
+		 * file and use the format the manifest lists for them, and the sounds it does not list keep
+		 * the flags they are loaded with. Sounds loaded before keep their format until reloaded.
+		 * \param path The path of the manifest.
+		 * \return True if the manifest was mapped, false if it is missing or invalid.
+		 */
+		bool LoadSoundManifest(const std::string& path);
+
+		/**
+		 * \brief Writes how often every sound known to the cache was played, the profile the
+		 * AudioSoundCooker weighs decode cost with. The first line is "seconds" and the seconds
+		 * played, and every other line the plays of a sound and its name.
+		 * \param path The path of the profile to write.
+		 * \return True if the profile was written, false otherwise.
+		 */
+		bool WriteSoundPlayProfile(const std::string& path) const;
+
+		/**
+		 * \brief Sets the number of bytes loaded sounds may use. Sounds that are not playing are
+		 * unloaded, least recently used first, whenever the cache goes over budget.
+		 * \param bytes The byte budget.
+		 */
+		void SetSoundCacheBudget(size_t bytes);
+
+		/**
+		 * \brief Gets the budget, residency and hit/miss/eviction counters of the sound cache.
+		 * \return The cache statistics.
+		 */
+		SoundCacheStats GetSoundCacheStats() const;
+
+		/**
+		 * \brief Plays a sound on a voice of the voice table, loading it again if it was evicted or
+		 * never loaded. A sound whose last load failed is not retried until LoadSound or
+		 * LoadSoundAsync is called for it. A sound still loading asynchronously holds its voice until
+		 * it starts.
 		 * \param filename The name of the sound file to play.
 		 * \param volume The volume of the sound.
 		 * \param pitch The pitch of the sound.
-		 * \return A pointer to the FMOD::Channel object representing the playing sound.
+		 * \param tag A tag used to change the volume of related sounds together.
+		 * \return A handle to the voice, invalid if the sound could not be loaded, the play was dropped
+		 * by the pending play policy or every voice is in use.
+		 */
+		SoundHandle PlaySound(const std::string& filename, float volume, float pitch, AudioId tag = AudioId());
+
+		/**
+		 * \brief Plays a sound, unless the culling stage rejects it first. The audibility of the play
+		 * is estimated from its volume, the channel group volumes and its distance. Quiet plays are
+		 * rejected, and a play into a full group takes the voice of the least important and quietest
+		 * sound if that one ranks lower, or is rejected otherwise.
+		 *
+		 * The channel is started by the next Update, together with every other play of the frame. A
+		 * play of a sound already played with the same tag within the dedup window reuses that voice,
+		 * which gets louder instead of a second channel being started.
+		 * \param filename The name of the sound file to play.
+		 * \param params The volume, pitch, tag, priority and distance of the play.
+		 * \return A handle to the voice, invalid if the play was culled. The handle goes stale if the
+		 * channel fails to start.
+		 */
+		SoundHandle PlaySound(const std::string& filename, const SoundPlayParams& params);
+
+		/**
+		 * \brief Plays several sounds, as if PlaySound was called for each of them in order.
+		 * \param requests The plays.
+		 * \param count The number of plays.
+		 * \param handles Receives the handle of each play, may be nullptr.
+		 */
+		void PlaySoundBatch(const SoundPlayRequest* requests, size_t count, SoundHandle* handles = nullptr);
+
+		/**
+		 * \brief Sets the variants of a sound container, replacing the container if it exists. The
+		 * variants are loaded like any other sound, on their first play or by LoadSound. Meant to be
+		 * called while loading, as every new container resorts the containers.
+		 * \param container The identifier of the container.
+		 * \param desc The variants, selection mode and ranges of the container.
+		 */
+		void SetSoundContainer(AudioId container, const SoundContainerDesc& desc);
+
+		/**
+		 * \brief Plays the next variant of a sound container. The volume of the play is scaled by a
+		 * factor drawn from the volume range of the container and its pitch is offset by a number
+		 * of cents drawn from the pitch range, on top of the volume and pitch of params.
+		 * \param container The identifier of the container.
+		 * \param params The volume, pitch, tag, priority and distance of the play.
+		 * \return A handle to the voice, invalid if the container is unknown or empty or the play was culled.
+		 */
+		SoundHandle PlaySoundContainer(AudioId container, const SoundPlayParams& params = SoundPlayParams());
+
+		/**
+		 * \brief Sets how long after a play the same sound is merged into it rather than played again.
+		 * \param seconds The length of the window, 0 to never merge plays.
+		 */
+		void SetSoundDedupWindow(float seconds);
+
+		/**
+		 * \brief Sets the culling rules of a channel group.
+		 * \param channelGroup The audio channel group. The master group only uses the voice cap.
+		 * \param settings The culling rules.
+		 */
+		void SetSoundCullSettings(AudioChannelGroup channelGroup, const SoundCullSettings& settings);
+
+		/**
+		 * \brief Gets the culling rules of a channel group.
+		 * \param channelGroup The audio channel group.
+		 * \return The culling rules.
+		 */
+		const SoundCullSettings& GetSoundCullSettings(AudioChannelGroup channelGroup) const;
+
+		/**
+		 * \brief Gets what the culling stage did during the last complete frame.
+		 * \param channelGroup The audio channel group, or the master group for every sound.
+		 * \return The counts of played, culled and stolen sounds.
+		 */
+		SoundCullStats GetSoundCullStats(AudioChannelGroup channelGroup) const;
+
+		/**
+		 * \brief Stops a sound. Does nothing if the sound already ended.
+		 * \param sound The handle returned by PlaySound.
+		 */
+		void StopSound(SoundHandle sound);
+
+		/**
+		 * \brief Sets the volume of a sound. Does nothing if the sound already ended.
+		 * \param sound The handle returned by PlaySound.
+		 * \param volume The volume value.
+		 */
+		void SetSoundVolume(SoundHandle sound, float volume);
+
+		/**
+		 * \brief Checks if a sound is still playing or waiting for its sound to load.
+		 * \param sound The handle returned by PlaySound.
+		 * \return True if the voice is still in use by that play, false otherwise.
+		 */
+		bool GetSoundPlaying(SoundHandle sound);
+
+		/**
+		 * \brief Stops every sound playing on a channel group, or every sound for the master group.
+		 * \param channelGroup The audio channel group.
+		 */
+		void StopSounds(AudioChannelGroup channelGroup);
+
+		/**
+		 * \brief Fades every sound playing on a channel group, or every sound for the master group.
+		 * Sounds still loading are only affected by fades that stop them.
+		 * \param channelGroup The audio channel group.
+		 * \param volume The volume reached at the end of the fade.
+		 * \param seconds The duration of the fade.
+		 * \param stopWhenDone Specifies whether the sounds stop at the end of the fade.
 		 */
-		FMOD::Channel* PlaySound(const std::string& filename, float volume, float pitch);
+		void FadeSounds(AudioChannelGroup channelGroup, float volume, float seconds, bool stopWhenDone = false);
+
+		/**
+		 * \brief Sets the volume of every sound played with a tag.
+		 * \param tag The tag given to PlaySound.
+		 * \param volume The volume value.
+		 */
+		void SetSoundVolumeByTag(AudioId tag, float volume);
 
 		/**
 		 * \brief Checks if a sound is loaded.
@@ -127,6 +644,22 @@ namespace DeckedOut
 		 */
 		void SetChannelGroupVolume(AudioChannelGroup channelGroup, float volume);
 
+		/**
+		 * \brief Runs an effect on an audio channel group, after its fader and after the effects
+		 * already attached. The effect is prepared for the mixer and owned by the AudioSystem until
+		 * DetachEffects or Shutdown.
+		 * \param channelGroup The audio channel group.
+		 * \param effect The effect.
+		 * \return The effect, to read its levels from, nullptr if the DSP could not be created.
+		 */
+		AudioEffect* AttachEffect(AudioChannelGroup channelGroup, std::unique_ptr<AudioEffect> effect);
+
+		/**
+		 * \brief Removes and destroys the effects of an audio channel group.
+		 * \param channelGroup The audio channel group.
+		 */
+		void DetachEffects(AudioChannelGroup channelGroup);
+
 		/**
 		 * \brief Sets the volume of an audio bus.
 		 * \param bus The name of the audio bus.
@@ -134,6 +667,13 @@ namespace DeckedOut
 		 */
 		void SetBusVolume(const std::string& bus, float volume);
 
+		/**
+		 * \brief Sets the volume of an audio bus.
+		 * \param bus The identifier of the audio bus.
+		 * \param volume The volume value.
+		 */
+		void SetBusVolume(AudioId bus, float volume) noexcept;
+
 		/**
 		 * \brief Gets the volume of an audio bus.
 		 * \param bus The name of the audio bus.
@@ -141,6 +681,13 @@ namespace DeckedOut
 		 */
 		float GetBusVolume(const std::string& bus);
 
+		/**
+		 * \brief Gets the volume of an audio bus.
+		 * \param bus The identifier of the audio bus.
+		 * \return The volume value.
+		 */
+		float GetBusVolume(AudioId bus) noexcept;
+
 		/**
 		 * \brief Sets the paused state of an audio bus.
 		 * \param bus The name of the audio bus.
@@ -148,6 +695,13 @@ namespace DeckedOut
 		 */
 		void SetBusPaused(const std::string& bus, bool pause);
 
+		/**
+		 * \brief Sets the paused state of an audio bus.
+		 * \param bus The identifier of the audio bus.
+		 * \param pause The paused state.
+		 */
+		void SetBusPaused(AudioId bus, bool pause) noexcept;
+
 		/**
 		 * \brief Gets the paused state of an audio bus.
 		 * \param bus The name of the audio bus.
@@ -155,6 +709,13 @@ namespace DeckedOut
 		 */
 		bool GetBusPaused(const std::string& bus);
 
+		/**
+		 * \brief Gets the paused state of an audio bus.
+		 * \param bus The identifier of the audio bus.
+		 * \return The paused state.
+		 */
+		bool GetBusPaused(AudioId bus) noexcept;
+
 		/**
 		 * \brief Stops all events on an audio bus.
 		 * \param bus The name of the audio bus.
@@ -162,10 +723,35 @@ namespace DeckedOut
 		void BusStopAllEvents(const std::string& bus);
 
 		/**
-		 * \brief Plays an event in FMOD Studio.
+		 * \brief Stops all events on an audio bus.
+		 * \param bus The identifier of the audio bus.
+		 */
+		void BusStopAllEvents(AudioId bus) noexcept;
+
+		/**
+		 * \brief Plays an event in FMOD Studio on a free voice of its pool.
 		 * \param event The name of the event to play.
+		 * \param priority The priority used when the pool is full.
+		 * \return A handle to the voice, invalid if every voice had a higher priority.
+		 */
+		EventInstanceHandle PlayEvent(const std::string& event, int priority = 0);
+
+		/**
+		 * \brief Plays an event in FMOD Studio on a free voice of its pool.
+		 * \param event The identifier of the event to play.
+		 * \param priority The priority used when the pool is full.
+		 * \return A handle to the voice, invalid if every voice had a higher priority.
 		 */
-		void PlayEvent(const std::string& event);
+		EventInstanceHandle PlayEvent(AudioId event, int priority = 0) noexcept;
+
+		/**
+		 * \brief Sets how many voices of an event can play at once and which one a new play steals.
+		 * Pools hold one voice unless configured. In eager mode every voice is created right away.
+		 * \param event The identifier of the event.
+		 * \param size The number of voices, at least one.
+		 * \param stealMode The voice stolen when every voice is playing.
+		 */
+		void SetEventPoolSize(AudioId event, unsigned size, EventStealMode stealMode = EventStealMode::Oldest);
 
 		/**
 		 * \brief Stops a playing event in FMOD Studio.
@@ -173,10 +759,22 @@ namespace DeckedOut
 		 */
 		void StopEvent(const std::string& event);
 
+		/**
+		 * \brief Stops a playing event in FMOD Studio.
+		 * \param event The identifier of the event to stop.
+		 */
+		void StopEvent(AudioId event) noexcept;
+
+		/**
+		 * \brief Stops one voice of an event. Does nothing if the voice was stolen or restarted.
+		 * \param instance The handle returned by PlayEvent.
+		 */
+		void StopEvent(EventInstanceHandle instance) noexcept;
+
 		/**
 		 * \brief Stops all playing events in FMOD Studio.
 		 */
-		void StopAllEvents();
+		void StopAllEvents() noexcept;
 
 		/**
 		 * \brief Sets a parameter value for an event in FMOD Studio.
@@ -186,6 +784,79 @@ namespace DeckedOut
 		 */
 		void SetEventParameter(const std::string& event, const std::string& parameter, float value);
 
+		/**
+		 * \brief Sets a parameter value for an event in FMOD Studio.
+		 * \param event The identifier of the event.
+		 * \param parameter The name of the parameter.
+		 * \param value The value to set for the parameter.
+		 */
+		void SetEventParameter(AudioId event, const std::string& parameter, float value) noexcept;
+
+		/**
+		 * \brief Sets a parameter value for an event in FMOD Studio without any name lookup.
+		 * \param event The handle of the event.
+		 * \param parameter The handle of the parameter.
+		 * \param value The value to set for the parameter.
+		 */
+		void SetEventParameter(EventHandle event, ParamHandle parameter, float value) noexcept;
+
+		/**
+		 * \brief Sets several parameter values for an event in FMOD Studio in a single call.
+		 * \param event The handle of the event.
+		 * \param parameters Array of count parameter handles.
+		 * \param values Array of count values, one per parameter.
+		 * \param count The number of parameters to set.
+		 */
+		void SetEventParameters(EventHandle event, const ParamHandle* parameters, const float* values, int count) noexcept;
+
+		/**
+		 * \brief Sets a parameter value for one voice of an event. Does nothing if the voice was
+		 * stolen or restarted.
+		 * \param instance The handle returned by PlayEvent.
+		 * \param parameter The handle of the parameter.
+		 * \param value The value to set for the parameter.
+		 */
+		void SetEventParameter(EventInstanceHandle instance, ParamHandle parameter, float value) noexcept;
+
+		/**
+		 * \brief Sets a game-state parameter, which reaches every event through its global parameter.
+		 * Writes made during a frame are collapsed into a single FMOD call by the next update. Safe
+		 * to call from any thread.
+		 * \param parameter The game parameter.
+		 * \param value The value to set for the parameter.
+		 */
+		void SetGameParameter(GameParameter parameter, float value);
+
+		/**
+		 * \brief Gets the last value written to a game-state parameter.
+		 * \param parameter The game parameter.
+		 * \return The value of the parameter.
+		 */
+		float GetGameParameter(GameParameter parameter) const;
+
+		/**
+		 * \brief Resolves an event the studio manifest does not list, such as one added to a
+		 * NullAudioBackend, as if it had been listed. Does nothing for an event already known.
+		 * \param path The path of the event.
+		 * \return The identifier of the event, unknown to the other calls if the studio is not ready.
+		 */
+		AudioId AddEvent(const std::string& path);
+
+		/**
+		 * \brief Resolves an event so it can be addressed without a lookup.
+		 * \param event The identifier of the event.
+		 * \return The handle of the event, invalid if the event is unknown.
+		 */
+		EventHandle GetEventHandle(AudioId event) const;
+
+		/**
+		 * \brief Resolves a parameter of an event from the cache built by InitializeStudio.
+		 * \param event The handle of the event.
+		 * \param parameter The name of the parameter, with or without the "parameter:/" prefix.
+		 * \return The handle of the parameter, invalid if the event has no such parameter.
+		 */
+		ParamHandle GetParameterHandle(EventHandle event, const std::string& parameter) const;
+
 		/**
 		 * \brief Checks if an event is currently playing in FMOD Studio.
 		 * \param event The name of the event to check.
@@ -193,18 +864,171 @@ namespace DeckedOut
 		 */
 		bool GetEventPlaying(const std::string& event);
 
+		/**
+		 * \brief Checks if an event is currently playing in FMOD Studio.
+		 * \param event The identifier of the event to check.
+		 * \return True if the event is playing, false otherwise.
+		 */
+		bool GetEventPlaying(AudioId event) noexcept;
+
+		/**
+		 * \brief Checks if one voice of an event is still playing the play that returned its handle.
+		 * \param instance The handle returned by PlayEvent.
+		 * \return True if the voice is playing, false otherwise.
+		 */
+		bool GetEventPlaying(EventInstanceHandle instance) noexcept;
+
+		/**
+		 * \brief Queues a command for the next Update. Safe to call from any thread.
+		 * \param command The command to queue.
+		 * \return True if the command was queued, false if the command queue was full.
+		 */
+		bool EnqueueCommand(const AudioCommand& command);
+
+		/**
+		 * \brief Queues the play of an event for the next Update. Safe to call from any thread.
+		 * \param event The identifier of the event to play.
+		 * \param priority The priority used when the pool is full.
+		 * \return True if the command was queued, false if the command queue was full.
+		 */
+		bool QueuePlayEvent(AudioId event, int priority = 0);
+
+		/**
+		 * \brief Queues the stop of an event for the next Update. Safe to call from any thread.
+		 * \param event The identifier of the event to stop.
+		 * \return True if the command was queued, false if the command queue was full.
+		 */
+		bool QueueStopEvent(AudioId event);
+
+		/**
+		 * \brief Queues a parameter change for the next Update. Safe to call from any thread.
+		 * \param event The identifier of the event.
+		 * \param parameter The identifier of the parameter name, without the "parameter:/" prefix.
+		 * \param value The value to set for the parameter.
+		 * \return True if the command was queued, false if the command queue was full.
+		 */
+		bool QueueSetEventParameter(AudioId event, AudioId parameter, float value);
+
+		/**
+		 * \brief Queues a bus volume change for the next Update. Safe to call from any thread.
+		 * \param bus The identifier of the audio bus.
+		 * \param volume The volume value.
+		 * \return True if the command was queued, false if the command queue was full.
+		 */
+		bool QueueSetBusVolume(AudioId bus, float volume);
+
+		/**
+		 * \brief Gets the capacity, depth and overflow counters of the command queue.
+		 * \return The command queue statistics.
+		 */
+		AudioCommandQueueStats GetCommandQueueStats() const;
+
 		/**
 		 * \brief Initializes the FMOD Studio system.
+		 * \param mode How the banks are loaded. In async mode events and buses become available
+		 * once IsStudioReady returns true.
+		 */
+		void InitializeStudio(StudioLoadMode mode = StudioLoadMode::Blocking);
+
+		/**
+		 * \brief Sets how Initialize loads the studio banks. Must be called before Initialize.
+		 * \param mode The load mode.
+		 */
+		void SetStudioLoadMode(StudioLoadMode mode);
+
+		/**
+		 * \brief Sets which thread ticks the studio system. Must be called before Initialize.
+		 *
+		 * In threaded mode, the calls that change events or buses are queued as commands when made
+		 * from another thread and take effect on the next tick. PlayEvent reserves the voice slot
+		 * and generation of its handle when it queues the play, so the handle is valid right away
+		 * and goes stale if the play fails. Calls that read studio state, and SetPrefetchList, wait
+		 * for the running tick to finish instead. Sounds are still maintained by Update on the game thread.
+		 * \param mode The update mode.
+		 * \param tickRate In threaded mode, the number of ticks per second.
+		 */
+		void SetUpdateMode(AudioUpdateMode mode, float tickRate = 60.0f);
+
+		/**
+		 * \brief Gets the tick jitter and update duration measured by the audio update thread.
+		 * \return The thread statistics, all zero unless the update mode is threaded.
+		 */
+		AudioThreadStats GetAudioThreadStats() const;
+
+		/**
+		 * \brief Sets when event instances are created. Must be called before Initialize.
+		 * \param mode The instance mode.
+		 * \param idleTimeout In lazy mode, seconds an instance may stay stopped before it is released.
 		 */
-		void InitializeStudio();
+		void SetEventInstanceMode(EventInstanceMode mode, float idleTimeout = 30.0f);
 
 		/**
-		 * \brief Reports an FMOD error.
+		 * \brief Loads the sample data of the given events ahead of time, typically once per level.
+		 * Events prefetched by a previous call and missing from this list have their sample data unloaded.
+		 * \param events The identifiers of the events to prefetch.
+		 */
+		void SetPrefetchList(const std::vector<AudioId>& events);
+
+		/**
+		 * \brief Gets how many instances and how much sample data are resident.
+		 * \return The residency counters.
+		 */
+		EventResidencyStats GetEventResidencyStats() const;
+
+		/**
+		 * \brief Checks if every bank has loaded and every event and bus has been resolved.
+		 * \return True if the studio content can be used, false otherwise.
+		 */
+		bool IsStudioReady() const;
+
+		/**
+		 * \brief Gets the fraction of banks that have finished loading, for loading screens.
+		 * \return A value between 0 and 1.
+		 */
+		float GetStudioLoadProgress() const;
+
+		/**
+		 * \brief Gets the load time of every bank. In async mode the times are measured when
+		 * Update polls the banks, so they have the resolution of a frame.
+		 * \return The load reports, in the order the banks were issued.
+		 */
+		const std::vector<BankLoadReport>& GetBankLoadReports() const;
+
+		/**
+		 * \brief Reports an FMOD error met while initializing. Errors met at runtime are recorded
+		 * in the error log instead.
 		 * \param err The FMOD_RESULT error code.
 		 * \throw An exception with the error message.
 		 */
 		static void ReportFMODError(FMOD_RESULT err) noexcept(false);
 
+		/**
+		 * \brief Gets the failures recorded at runtime and their count per result code. Update logs
+		 * a few of them every second.
+		 * \return The error log.
+		 */
+		const AudioErrorLog& GetErrorLog() const;
+
+		/**
+		 * \brief Gets the cost of the audio system during the last frame, collected at the end of Update.
+		 * \return The stats of the last frame.
+		 */
+		const AudioStats& GetAudioStats() const;
+
+		/**
+		 * \brief Sets how many frames of stats are kept for WriteAudioStatsHistory.
+		 * \param frames The number of frames, 0 to keep none.
+		 */
+		void SetAudioStatsHistory(size_t frames);
+
+		/**
+		 * \brief Writes the stats of the frames kept, oldest first.
+		 * \param path The path of the file to write.
+		 * \param format The file format.
+		 * \return True if the file was written, false otherwise.
+		 */
+		bool WriteAudioStatsHistory(const std::string& path, AudioStatsFormat format) const;
+
 		/**
 		 * \brief Creates a bank path from a GUID.
 		 * \param guid The GUID string to create the bank path from.
@@ -242,12 +1066,48 @@ namespace DeckedOut
 		void OnPauseScreenClosed(const NamedEvent* event);
 
 		/**
-		 * \brief Mutes all audio buses in the system.
+		 * \brief Saves the volume and pause state of every bus into a snapshot, naming the snapshot
+		 * if it is new. At most MixSnapshotTable::CAPACITY snapshots can be named, one of them by
+		 * MuteAllBuses.
+		 * \param snapshot The name of the snapshot.
+		 */
+		void CaptureMixSnapshot(AudioId snapshot) noexcept;
+
+		/**
+		 * \brief Sets the state of one bus in a snapshot, naming the snapshot if it is new. The other
+		 * buses of a new snapshot are at full volume and playing.
+		 * \param snapshot The name of the snapshot.
+		 * \param bus The identifier of the audio bus.
+		 * \param volume The volume of the bus.
+		 * \param paused The paused state of the bus.
+		 */
+		void SetMixSnapshotBus(AudioId snapshot, AudioId bus, float volume, bool paused = false) noexcept;
+
+		/**
+		 * \brief Crossfades every bus from its current volume to a snapshot, replacing any crossfade
+		 * in progress. The crossfade is advanced by Update. Buses playing in the snapshot resume at
+		 * the start, buses paused in the snapshot pause at the end. Until the end, the crossfade
+		 * overrides the volumes set on the buses.
+		 * \param snapshot The name of the snapshot.
+		 * \param seconds The duration of the crossfade, 0 to apply the snapshot right away.
+		 */
+		void ApplyMixSnapshot(AudioId snapshot, float seconds = 0.0f) noexcept;
+
+		/**
+		 * \brief Checks if a crossfade started by ApplyMixSnapshot is in progress.
+		 * \return True while the crossfade is in progress, false otherwise.
+		 */
+		bool IsMixSnapshotFading() const;
+
+		/**
+		 * \brief Mutes all audio buses in the system, saving their state first. Does nothing if the
+		 * buses are already muted.
 		 */
 		void MuteAllBuses();
 
 		/**
-		 * \brief Unmutes all audio buses in the system.
+		 * \brief Restores the state of the buses saved by MuteAllBuses. Does nothing if the buses
+		 * are not muted.
 		 */
 		void UnmuteAllBuses();
 
@@ -257,25 +1117,257 @@ namespace DeckedOut
 		 */
 		static AudioSystem& Instance();
 	private:
-		typedef std::unordered_map<std::string, FMOD::Sound*> SoundMap; //!< Map storing sound objects.
+		/**
+		 * \brief A sound known to the sound cache. The entry outlives an eviction so it can be reloaded.
+		 */
+		struct SoundCacheEntry
+		{
+			FMOD::Sound* sound_ = nullptr; //!< The sound, nullptr while evicted.
+			size_t bytes_ = 0; //!< Bytes charged to the cache budget.
+			unsigned long long lastUsed_ = 0; //!< Cache tick of the last load or play.
+			unsigned playing_ = 0; //!< Number of voices using the sound, which pins it.
+			bool loop_ = false; //!< Whether the sound loops.
+			bool stream_ = false; //!< Whether the sound is streamed.
+			bool loading_ = false; //!< Whether the sound is still opening asynchronously.
+			bool packed_ = false; //!< Whether the sound reads from the mapping of the sound pack.
+			bool failed_ = false; //!< Whether the last load failed, plays skip the sound until it is loaded explicitly.
+			SoundHandle lastPlay_; //!< The voice of the last play, which later plays may merge into.
+			double lastPlayTime_ = 0.0; //!< Sound clock time of the last play.
+			unsigned plays_ = 0; //!< Number of plays, written to the play profile.
+		};
+
+		/**
+		 * \brief An asynchronous load polled by Update.
+		 */
+		struct PendingSoundLoad
+		{
+			std::shared_ptr<SoundLoadStatus> status_; //!< Progress shared with the handle.
+			SoundCacheEntry* entry_; //!< The loading sound.
+			AudioId id_; //!< Identifier of the name of the sound, recorded with a failure.
+		};
+
+		/**
+		 * \brief A slot of the sound voice table.
+		 */
+		struct SoundVoice
+		{
+			FMOD::Channel* channel_; //!< The playing channel, nullptr while the sound is loading.
+			SoundCacheEntry* entry_; //!< The sound it plays, which it pins in the cache, nullptr while the voice is free.
+			AudioId tag_; //!< Tag given to PlaySound.
+			float volume_; //!< Volume of the voice.
+			float pitch_; //!< Playback rate ratio of the voice.
+			AudioChannelGroup group_; //!< Channel group the voice plays on.
+			int priority_; //!< Priority of the play.
+			float attenuation_; //!< Distance attenuation estimated when the play was culled.
+			bool pending_; //!< Whether the voice waits in pendingSoundVoices_.
+			uint16_t generation_; //!< Incremented every time the voice is freed, never 0.
+			uint16_t slot_; //!< Position in activeSoundVoices_ while in use, next free voice while free.
+		};
+
+		/**
+		 * \brief An effect running on a channel group.
+		 */
+		struct GroupEffect
+		{
+			std::unique_ptr<AudioEffect> effect_; //!< The effect, which outlives its DSP.
+			FMOD::DSP* dsp_; //!< The DSP running the effect.
+			AudioChannelGroup group_; //!< Channel group the DSP is added to.
+		};
+
+		typedef std::unordered_map<std::string, SoundCacheEntry> SoundMap; //!< Map storing sound objects.
 		typedef std::unordered_map<std::string, FMOD::Studio::Bank*> BankMap; //!< Map storing bank objects.
-		typedef std::unordered_map<std::string, FMOD::Studio::EventDescription*> EventDescriptionMap; //!< Map storing event description objects.
-		typedef std::unordered_map<std::string, FMOD::Studio::EventInstance*> EventInstanceMap; //!< Map storing event instance objects.
-		typedef std::unordered_map<std::string, FMOD::Studio::Bus*> BusMap; //!< Map storing bus objects.
+		typedef AudioIdTable<unsigned> EventIndexTable; //!< Table storing indices into the event records.
+		typedef AudioIdTable<FMOD::Studio::Bus*> BusTable; //!< Table storing bus objects.
+
+		/**
+		 * \brief Cached FMOD identifier of a settable event parameter.
+		 */
+		struct EventParameter
+		{
+			AudioId name_; //!< Hash of the parameter name, without the "parameter:/" prefix.
+			FMOD_STUDIO_PARAMETER_ID id_; //!< FMOD identifier of the parameter.
+		};
+
+		/**
+		 * \brief One pooled instance of an event.
+		 */
+		struct EventVoice
+		{
+			FMOD::Studio::EventInstance* instance_; //!< Instance of the voice, nullptr until it is first needed.
+			float startTime_; //!< Audio time at which the voice was last started.
+			float lastActiveTime_; //!< Audio time at which the voice was last used or playing.
+			int priority_; //!< Priority of the play that last started the voice.
+			unsigned short generation_; //!< Generation of the play that last started the voice.
+		};
+
+		/**
+		 * \brief A range of eventVoices_ no pool uses, left by a pool that moved or shrank.
+		 */
+		struct EventVoiceRange
+		{
+			unsigned first_; //!< Index of the first slot.
+			unsigned count_; //!< Number of slots.
+		};
+
+		/**
+		 * \brief Everything the audio system keeps about a single studio event.
+		 */
+		struct EventRecord
+		{
+			AudioId id_; //!< Identifier of the event's path.
+			FMOD::Studio::EventDescription* description_; //!< Description of the event.
+			unsigned firstVoice_; //!< Index of the first voice of the pool in eventVoices_.
+			unsigned voiceCount_; //!< Number of voices in the pool.
+			unsigned createdVoices_; //!< Number of voices of the pool that own an instance.
+			EventStealMode stealMode_; //!< Voice stolen when the pool is full.
+			bool prefetched_; //!< Whether the sample data is loaded through the prefetch list.
+			unsigned firstParameter_; //!< Index of the first cached parameter in eventParameters_.
+			unsigned parameterCount_; //!< Number of cached parameters.
+			unsigned short generation_; //!< Generation of the last play of any voice, so resized pools never repeat one a stale handle holds.
+			unsigned short nextReservedVoice_; //!< Slot the next play queued from another thread reserves.
+		};
+
 		SoundMap sounds_; //!< Map containing the loaded sound objects.
+		std::vector<SoundVoice> soundVoices_; //!< Voice table of PlaySound, sized once.
+		std::vector<uint16_t> activeSoundVoices_; //!< Indices of the voices in use.
+		uint16_t freeSoundVoice_; //!< First free voice, the capacity of the table when every voice is in use.
+		int outputRate_; //!< Sample rate of the mixer, converts fade durations to DSP clocks.
+		unsigned mixBlockSamples_; //!< Samples mixed per block.
+		std::vector<PendingSoundLoad> pendingSoundLoads_; //!< Asynchronous loads still in flight.
+		std::vector<SoundHandle> queuedSoundPlays_; //!< Voices waiting for an asynchronous load.
+		std::vector<SoundHandle> pendingSoundVoices_; //!< Voices to start, or whose volume to apply, in the next Update.
+		AudioIdTable<SoundContainer> soundContainers_; //!< Variants of the sounds played through PlaySoundContainer.
+		AudioPack soundPack_; //!< The mounted sound pack, which must outlive the sounds opened from it.
+		AudioSoundManifest soundManifest_; //!< The format every cooked sound loads in.
+		float soundDedupWindow_; //!< Seconds during which plays of a sound merge into its last play.
+		double soundClock_; //!< Seconds accumulated by Update, times the dedup window.
+		size_t soundCacheBudget_; //!< Byte budget of the sound cache.
+		size_t soundCacheBytes_; //!< Bytes used by the loaded sounds.
+		unsigned long long soundCacheTick_; //!< Incremented on every load or play, orders the cache by recency.
+		unsigned soundCacheHits_; //!< Plays that found their sound loaded.
+		unsigned soundCacheMisses_; //!< Plays that had to load their sound.
+		unsigned soundCacheEvictions_; //!< Sounds unloaded to stay under the budget.
+		PendingPlayPolicy pendingPlayPolicy_; //!< What PlaySound does with a loading sound.
+		SoundCullSettings soundCullSettings_[3]; //!< Culling rules of each channel group.
+		float channelGroupVolumes_[3]; //!< Volumes set on each channel group, read when estimating audibility.
+		unsigned soundGroupVoices_[3]; //!< Voices in use on each channel group, all of them for the master group.
+		std::array<SoundCullStats, 3> soundCullStats_; //!< Culling counts of the current frame, the master entry is unused.
+		std::array<SoundCullStats, 3> lastSoundCullStats_; //!< Culling counts of the last complete frame.
 		BankMap banks_; //!< Map containing the loaded bank objects.
-		EventDescriptionMap eventDescriptions_; //!< Map containing the event description objects.
-		EventInstanceMap eventInstances_; //!< Map containing the event instance objects.
-		BusMap buses_; //!< Map containing the bus objects.
-		std::stack<std::pair<std::string, float>> busVolumes_; //!< Stack storing bus volume settings.
-		FMOD::Studio::System* sys_; //!< Pointer to the FMOD Studio level system.
-		FMOD::System* sysLow_; //!< Pointer to the low-level FMOD system.
+		std::vector<EventRecord> events_; //!< Records of every event, indexed by EventHandle.
+		std::vector<EventParameter> eventParameters_; //!< Cached parameters of every event.
+		std::vector<EventVoice> eventVoices_; //!< Voice pools of every event, in contiguous ranges.
+		std::vector<EventVoiceRange> freeEventVoices_; //!< Unused ranges of eventVoices_, sorted and merged, reused by growing pools.
+		std::vector<unsigned> residentEvents_; //!< Indices of the events that own at least one instance.
+		unsigned residentInstanceCount_; //!< Number of voices that own an instance.
+		std::vector<unsigned> prefetchedEvents_; //!< Indices of the events whose sample data was prefetched.
+		EventIndexTable eventIndices_; //!< Table mapping event identifiers to event records.
+		BusTable buses_; //!< Table containing the bus objects.
+		std::vector<FMOD::Studio::Bank*> loadingBanks_; //!< Banks in the order they were issued, parallel to bankLoadReports_.
+		std::vector<BankLoadReport> bankLoadReports_; //!< Load time of every bank.
+		AudioManifest manifest_; //!< Banks, events and buses of the project, held until the studio is resolved.
+		std::chrono::steady_clock::time_point studioLoadStart_; //!< Time at which the bank loads were issued.
+		std::atomic<unsigned> banksLoading_; //!< Number of banks that have not finished loading.
+		StudioLoadMode studioLoadMode_; //!< How Initialize loads the studio banks.
+		EventInstanceMode eventInstanceMode_; //!< When event instances are created.
+		float idleInstanceTimeout_; //!< Seconds a stopped instance is kept in lazy mode.
+		float audioTime_; //!< Seconds accumulated by Update.
+		float nextIdleSweepTime_; //!< Audio time of the next search for idle instances.
+		std::atomic<bool> studioReady_; //!< Whether every event and bus has been resolved.
+		FMOD_STUDIO_PARAMETER_ID gameParameterIds_[(int)GameParameter::Count]; //!< FMOD identifiers of the global parameters.
+		uint32_t resolvedGameParameters_; //!< Bit set of the game parameters found in the studio project.
+		std::atomic<float> gameParameterValues_[(int)GameParameter::Count]; //!< Last value written to each game parameter.
+		std::atomic<uint32_t> dirtyGameParameters_; //!< Bit set of the game parameters written since the last flush.
+		MixSnapshotTable mixSnapshots_; //!< Named states of every bus, indexed like buses_.
+		bool busesMuted_; //!< Whether the state of the buses was saved by MuteAllBuses.
+		AudioCommandQueue commands_; //!< Commands queued by any thread, executed by Update.
+		uint64_t reportedCommandOverflows_; //!< Overflow count of the command queue when it was last reported.
+		AudioUpdateMode updateMode_; //!< Which thread ticks the studio system.
+		float tickRate_; //!< Ticks per second of the audio update thread.
+		std::thread updateThread_; //!< Thread ticking the studio system in threaded mode.
+		std::atomic<std::thread::id> audioThreadId_; //!< Identifier of the running update thread, default when none runs.
+		std::atomic<bool> stopUpdateThread_; //!< Asks the update thread to exit.
+		mutable std::mutex threadStatsMutex_; //!< Guards threadStats_.
+		mutable std::mutex studioMutex_; //!< Held by the update thread while it ticks, guards the studio state from the other threads.
+		std::mutex eventReservationMutex_; //!< Guards the event table, pool sizes and generations that PlayEvent reserves from other threads.
+		AudioThreadStats threadStats_; //!< Timing published by the update thread after every tick.
+		mutable AudioErrorLog errorLog_; //!< Failures met at runtime.
+		std::atomic<uint64_t> audioFrame_; //!< Number of ticks, stamped on recorded failures.
+		uint64_t loggedErrorCount_; //!< Number of records of the error log already logged or suppressed.
+		std::chrono::steady_clock::time_point errorLogWindowStart_; //!< Start of the current second of error logging.
+		unsigned errorLogsInWindow_; //!< Errors logged during the current second.
+		uint64_t suppressedErrorLogs_; //!< Errors left out of the log during the current second.
+		AudioStats stats_; //!< Cost of the last frame.
+		AudioStatsHistory statsHistory_; //!< Stats of the most recent frames.
+		AudioBackendKind backendKind_; //!< Backend created by Initialize.
+		AudioOutputMode outputMode_; //!< Where the backend created by Initialize sends its mix.
+		std::string outputPath_; //!< WAV file written in WavFile mode.
+		size_t memoryArenaBytes_; //!< Size of the arena created by Initialize, 0 for the default heap.
+		std::unique_ptr<AudioMemoryArena> memoryArena_; //!< The arena FMOD allocates from, which outlives the backend.
+		AudioFileIOSettings fileIOSettings_; //!< I/O threads started by Initialize.
+		AudioFileIO fileIO_; //!< The I/O threads FMOD reads files through, running between Initialize and Shutdown.
+		std::unique_ptr<AudioBackend> backend_; //!< The system every FMOD call goes through.
 		FMOD::ChannelGroup* channelGroups_[3]; //!< Array of channel groups.
-		std::vector<AudioChannel*> channels_; //!< Vector storing audio channel objects.
+		std::vector<GroupEffect> groupEffects_; //!< Effects running on the channel groups, in the order attached.
 
 		AudioSystem(); //!< Default constructor of the AudioSystem class.
 		~AudioSystem(); //!< Destructor of the AudioSystem class.
 		void HandleVolumeEvent(const ChangeVolumeEvent* event); //!< Handles the volume change event by setting bus volume.
+		SoundCacheEntry* AcquireSound(const std::string& filename); //!< Gets a loaded sound for a play, reloading it on a miss.
+		size_t MeasureSound(FMOD::Sound* sound) const; //!< Gets the bytes a sound is charged in the cache.
+		FMOD_MODE GetSoundDecodeMode(const std::string& filename, bool stream) const; //!< Gets the flags of the format a sound loads in, from the manifest or the stream flag.
+		FMOD_RESULT OpenSound(const std::string& filename, FMOD_MODE mode, SoundCacheEntry& entry, FMOD::Sound** sound); //!< Opens a sound from the pack, or from its loose file.
+		void EnforceSoundCacheBudget(const SoundCacheEntry* keep); //!< Evicts unpinned sounds until the cache is under budget.
+		void UpdateSoundChannels(); //!< Frees the voices whose channels have ended.
+		void UpdateSoundLoads(); //!< Completes the asynchronous loads that finished and starts their queued voices.
+		void ForgetSound(const SoundCacheEntry& entry); //!< Frees the voices and drops the loads referring to a sound entry.
+		SoundVoice* FindSoundVoice(SoundHandle sound); //!< Gets the voice of a handle, or nullptr if it is stale.
+		unsigned AllocateSoundVoice(AudioChannelGroup group); //!< Takes a free voice on a group, returns the capacity of the table if none is free.
+		AudioChannelGroup GetSoundGroup(const std::string& filename) const; //!< Gets the channel group a sound plays on, without loading it.
+		float GetDistanceAttenuation(AudioChannelGroup group, float distance) const; //!< Estimates how much distance attenuates a play.
+		float EstimateAudibility(AudioChannelGroup group, float volume) const; //!< Estimates the volume heard of a play on a group.
+		bool SelectSoundVictims(AudioChannelGroup group, int priority, float audibility, unsigned (&victims)[2]); //!< Picks the voices a play must steal under the group and global caps, false if the play ranks too low.
+		void StealSoundVoice(unsigned index); //!< Stops and frees a voice taken by a higher ranked play.
+		void FreeSoundVoice(unsigned index); //!< Unpins the voice's sound and recycles the voice.
+		bool StartSoundVoice(SoundVoice& voice); //!< Starts the channel of a voice whose sound is ready.
+		void StartSoundVoices(); //!< Starts or updates the voices touched since the last Update.
+		SoundHandle MergeSoundPlay(const std::string& filename, const SoundPlayParams& params); //!< Merges a play into a recent play of the same sound, invalid handle if it cannot.
+		SoundHandle GetSoundHandle(unsigned index) const; //!< Builds the handle of a voice in use.
+		EventRecord* FindEvent(AudioId event); //!< Gets the record of an event, or nullptr if unknown.
+		EventVoice* FindEventVoice(EventInstanceHandle instance); //!< Gets the voice of a handle, or nullptr if it is stale.
+		EventInstanceHandle ReserveEventVoice(AudioId event); //!< Reserves the handle of a play queued from another thread, invalid if the event is unknown.
+		EventInstanceHandle StartEventVoice(EventRecord& record, int priority, EventInstanceHandle reserved); //!< Starts a voice, bound to the reserved handle if valid.
+		unsigned short NextEventGeneration(EventRecord& record); //!< Takes the next generation of a pool, with the reservations locked.
+		std::unique_lock<std::mutex> LockEventReservations(); //!< Locks the reservations while the update thread runs, defers otherwise.
+		FMOD::Studio::EventInstance* CreateVoiceInstance(EventRecord& record, unsigned voice); //!< Gets the instance of a voice, creating it if needed.
+		void ReleaseVoiceInstance(EventRecord& record, unsigned voice); //!< Releases the instance of a voice.
+		void EnsureEventInstance(EventRecord& record); //!< Creates the first voice of an event if no voice has an instance.
+		unsigned AllocateEventVoices(unsigned count); //!< Takes a free range of voices, or appends one, returns its first slot.
+		void FreeEventVoices(unsigned first, unsigned count); //!< Returns a range of voices for growing pools to reuse.
+		unsigned AcquireEventVoice(EventRecord& record, int priority); //!< Finds a free voice or steals one, returns the voice count on failure.
+		void ReleaseIdleEventInstances(); //!< Releases the instances that stayed stopped for longer than the idle timeout.
+		void CacheEventParameters(EventRecord& record); //!< Caches the settable parameters of an event's description.
+		void LoadBank(const std::string& path, FMOD_STUDIO_LOAD_BANK_FLAGS flags); //!< Issues the load of a bank and records its timing.
+		void PollBankLoading(); //!< Records banks that finished loading and resolves the studio once all have.
+		void ResolveStudioObjects(); //!< Resolves the manifest's events and buses into the lookup tables.
+		void ResolveEvent(AudioId id, const char* path); //!< Appends the record of an event to the unsorted lookup table.
+		void ResolveGameParameters(); //!< Resolves the global parameters backing the game parameters.
+		void FlushGameParameters(); //!< Sends the game parameters written since the last flush in one call.
+		const EventParameter* FindEventParameter(const EventRecord& record, const char* parameter) const; //!< Gets a cached parameter by name, or nullptr.
+		const EventParameter* FindEventParameter(const EventRecord& record, AudioId parameter) const; //!< Gets a cached parameter by identifier, or nullptr.
+		void Tick(float dt); //!< Executes queued commands and ticks the studio system.
+		void RunUpdateThread(); //!< Ticks the studio system at a fixed rate until asked to stop.
+		bool RouteThroughCommands() const; //!< Checks if the calling thread must queue studio calls instead of making them.
+		std::unique_lock<std::mutex> LockStudio() const; //!< Waits for the running tick when the calling thread is not the update thread.
+		bool CheckFMODResult(FMOD_RESULT result, const char* site, AudioId id = AudioId()) const noexcept; //!< Records a failed runtime call, returns true if it succeeded.
+		void LogRecordedErrors(); //!< Logs the failures recorded since the last update, within the rate limit.
+		void CollectAudioStats(float updateTime); //!< Fills the stats of the frame and records them in the history.
+		void ExecuteCommands(); //!< Executes the commands queued since the last update.
+		void ExecuteCommand(const AudioCommand& command); //!< Executes one queued command.
+		FMOD::Studio::Bus* FindBus(AudioId bus) const; //!< Gets a bus, or nullptr if unknown.
+		void CaptureMixSnapshot(unsigned snapshot); //!< Saves the state of every bus into a snapshot of the table.
+		void RestoreMixSnapshot(unsigned snapshot); //!< Sets every bus to the state saved in a snapshot of the table.
+		void UpdateMixFade(float dt); //!< Advances the crossfade between snapshots.
 	};
 }
 
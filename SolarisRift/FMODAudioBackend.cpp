@@ -0,0 +1,529 @@
+/* ======================================================================== /
+/!
+\file FMODAudioBackend.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the FMODAudioBackend class.
+This file contains the implementation of the AudioBackend forwarding every
+call to FMOD.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <cstring>
+#include <stdafx.h>
+#include <FMODAudioBackend.h>
+
+namespace DeckedOut
+{
+	static AudioMemoryArena* memoryArena = nullptr; //! Arena the FMOD memory callbacks forward to
+	static AudioFileIO* fileIO = nullptr; //! I/O layer the FMOD file callbacks forward to
+	static constexpr int FILE_BLOCK_ALIGN = 2048; //! Smallest read FMOD issues, its default
+
+	/**
+	 * \brief Allocation callback given to FMOD.
+	 * \param size The size of the block.
+	 * \param type The kind of memory.
+	 * \param source The FMOD source file making the allocation.
+	 * \return The block, nullptr if the arena is full.
+	 */
+	static void* F_CALLBACK AllocateFMODMemory(unsigned int size, FMOD_MEMORY_TYPE type, const char* source)
+	{
+		UNREFERENCED_PARAMETER(type);
+		UNREFERENCED_PARAMETER(source);
+		return memoryArena->Allocate(size);
+	}
+
+	/**
+	 * \brief Reallocation callback given to FMOD.
+	 * \param pointer The block.
+	 * \param size The new size of the block.
+	 * \param type The kind of memory.
+	 * \param source The FMOD source file making the allocation.
+	 * \return The resized block, nullptr if the arena is full.
+	 */
+	static void* F_CALLBACK ReallocateFMODMemory(void* pointer, unsigned int size, FMOD_MEMORY_TYPE type, const char* source)
+	{
+		UNREFERENCED_PARAMETER(type);
+		UNREFERENCED_PARAMETER(source);
+		return memoryArena->Reallocate(pointer, size);
+	}
+
+	/**
+	 * \brief Free callback given to FMOD.
+	 * \param pointer The block.
+	 * \param type The kind of memory.
+	 * \param source The FMOD source file freeing the block.
+	 */
+	static void F_CALLBACK FreeFMODMemory(void* pointer, FMOD_MEMORY_TYPE type, const char* source)
+	{
+		UNREFERENCED_PARAMETER(type);
+		UNREFERENCED_PARAMETER(source);
+		memoryArena->Free(pointer);
+	}
+
+	/**
+	 * \brief File open callback given to FMOD.
+	 * \param name The path of the file.
+	 * \param size Receives the size of the file.
+	 * \param handle Receives the handle of the file.
+	 * \param userdata The file user data of the sound, its priority class.
+	 * \return FMOD_OK, or the reason the file could not be opened.
+	 */
+	static FMOD_RESULT F_CALLBACK OpenFMODFile(const char* name, unsigned int* size, void** handle, void* userdata)
+	{
+		return fileIO->Open(name, size, handle, userdata);
+	}
+
+	/**
+	 * \brief File close callback given to FMOD.
+	 * \param handle The handle of the file.
+	 * \param userdata The file user data of the sound.
+	 * \return FMOD_OK.
+	 */
+	static FMOD_RESULT F_CALLBACK CloseFMODFile(void* handle, void* userdata)
+	{
+		UNREFERENCED_PARAMETER(userdata);
+		return fileIO->Close(handle);
+	}
+
+	/**
+	 * \brief Asynchronous read callback given to FMOD.
+	 * \param info The read, completed through its done function.
+	 * \param userdata The file user data of the sound.
+	 * \return FMOD_OK once the read is queued.
+	 */
+	static FMOD_RESULT F_CALLBACK ReadFMODFile(FMOD_ASYNCREADINFO* info, void* userdata)
+	{
+		UNREFERENCED_PARAMETER(userdata);
+		return fileIO->Read(info);
+	}
+
+	/**
+	 * \brief Read cancel callback given to FMOD.
+	 * \param info The read.
+	 * \param userdata The file user data of the sound.
+	 * \return FMOD_OK once the read is dropped or done.
+	 */
+	static FMOD_RESULT F_CALLBACK CancelFMODFileRead(FMOD_ASYNCREADINFO* info, void* userdata)
+	{
+		UNREFERENCED_PARAMETER(userdata);
+		return fileIO->Cancel(info);
+	}
+
+	/**
+	 * \brief Read callback of the effect DSPs, runs the effect set as the user data of the DSP.
+	 * \param state The DSP.
+	 * \param inBuffer The interleaved input samples.
+	 * \param outBuffer The interleaved output samples.
+	 * \param length The number of frames.
+	 * \param inChannels The number of channels of the input.
+	 * \param outChannels The number of channels of the output, set to those of the input.
+	 * \return FMOD_OK.
+	 */
+	static FMOD_RESULT F_CALLBACK ReadEffectDSP(FMOD_DSP_STATE* state, float* inBuffer, float* outBuffer,
+		unsigned int length, int inChannels, int* outChannels)
+	{
+		*outChannels = inChannels;
+		void* effect = nullptr;
+		static_cast<FMOD::DSP*>(state->instance)->getUserData(&effect);
+		if (effect == nullptr)
+		{
+			memcpy(outBuffer, inBuffer, (size_t)length * inChannels * sizeof(float));
+			return FMOD_OK;
+		}
+		static_cast<AudioEffect*>(effect)->Process(inBuffer, outBuffer, length, inChannels);
+		return FMOD_OK;
+	}
+
+	FMODAudioBackend::FMODAudioBackend() :
+		system_(nullptr),
+		core_(nullptr),
+		outputMode_(AudioOutputMode::Device),
+		outputPath_()
+	{
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetOutput(AudioOutputMode mode, const char* wavPath)
+	{
+		outputMode_ = mode;
+		outputPath_ = (wavPath != nullptr) ? wavPath : "";
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetMemoryArena(AudioMemoryArena* arena)
+	{
+		// FMOD keeps one set of callbacks for the whole process, they can only be set while no system exists
+		if (system_ != nullptr)
+		{
+			return FMOD_ERR_INITIALIZED;
+		}
+		memoryArena = arena;
+		return FMOD::Memory_Initialize(nullptr, 0, AllocateFMODMemory, ReallocateFMODMemory, FreeFMODMemory);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetFileIO(AudioFileIO* io)
+	{
+		if (system_ != nullptr)
+		{
+			return FMOD_ERR_INITIALIZED;
+		}
+		fileIO = io;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT FMODAudioBackend::Initialize(int maxChannels, FMOD_STUDIO_INITFLAGS studioFlags)
+	{
+		FMOD_RESULT result = FMOD::Studio::System::create(&system_);
+		if (result != FMOD_OK)
+		{
+			return result;
+		}
+		result = system_->getCoreSystem(&core_);
+		if (result != FMOD_OK)
+		{
+			return result;
+		}
+		if (fileIO != nullptr)
+		{
+			// Blocking read and seek callbacks are left out, so every read goes through the I/O threads
+			result = core_->setFileSystem(OpenFMODFile, CloseFMODFile, nullptr, nullptr,
+				ReadFMODFile, CancelFMODFileRead, FILE_BLOCK_ALIGN);
+			if (result != FMOD_OK)
+			{
+				return result;
+			}
+		}
+
+		FMOD_INITFLAGS coreFlags = FMOD_INIT_NORMAL;
+		void* driverData = nullptr;
+		if (outputMode_ != AudioOutputMode::Device)
+		{
+			// The output type must be chosen before the core system is initialized
+			result = core_->setOutput(outputMode_ == AudioOutputMode::WavFile ?
+				FMOD_OUTPUTTYPE_WAVWRITER_NRT : FMOD_OUTPUTTYPE_NOSOUND_NRT);
+			if (result != FMOD_OK)
+			{
+				return result;
+			}
+
+			// Mix and decode streams on the updating thread, so every update renders exactly one block
+			studioFlags |= FMOD_STUDIO_INIT_SYNCHRONOUS_UPDATE;
+			coreFlags |= FMOD_INIT_STREAM_FROM_UPDATE | FMOD_INIT_MIX_FROM_UPDATE;
+			if (outputMode_ == AudioOutputMode::WavFile)
+			{
+				driverData = const_cast<char*>(outputPath_.c_str());
+			}
+		}
+		return system_->initialize(maxChannels, studioFlags, coreFlags, driverData);
+	}
+
+	FMOD_RESULT FMODAudioBackend::Release()
+	{
+		if (system_ == nullptr)
+		{
+			return FMOD_OK;
+		}
+
+		// Releasing the studio system releases the core system it owns
+		FMOD_RESULT result = system_->release();
+		system_ = nullptr;
+		core_ = nullptr;
+		return result;
+	}
+
+	FMOD_RESULT FMODAudioBackend::Update()
+	{
+		return system_->update();
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetDSPBufferSize(unsigned* length, int* count)
+	{
+		return core_->getDSPBufferSize(length, count);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetVersion(unsigned* version)
+	{
+		return core_->getVersion(version);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetOutputRate(int* rate)
+	{
+		return core_->getSoftwareFormat(rate, nullptr, nullptr);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetCPUUsage(FMOD_STUDIO_CPU_USAGE* studio, FMOD_CPU_USAGE* core)
+	{
+		return system_->getCPUUsage(studio, core);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetStudioMemoryUsage(FMOD_STUDIO_MEMORY_USAGE* usage)
+	{
+		return system_->getMemoryUsage(usage);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetMemoryStats(int* current, int* peak)
+	{
+		return FMOD::Memory_GetStats(current, peak, false);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetChannelsPlaying(int* channels, int* realChannels)
+	{
+		return core_->getChannelsPlaying(channels, realChannels);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetStreamBufferSize(unsigned* size, FMOD_TIMEUNIT* unit)
+	{
+		return core_->getStreamBufferSize(size, unit);
+	}
+
+	FMOD_RESULT FMODAudioBackend::LoadBankFile(const char* path, FMOD_STUDIO_LOAD_BANK_FLAGS flags, FMOD::Studio::Bank** bank)
+	{
+		return system_->loadBankFile(path, flags, bank);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetBankLoadingState(FMOD::Studio::Bank* bank, FMOD_STUDIO_LOADING_STATE* state)
+	{
+		return bank->getLoadingState(state);
+	}
+
+	FMOD_RESULT FMODAudioBackend::UnloadBank(FMOD::Studio::Bank* bank)
+	{
+		return bank->unload();
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetEvent(const char* path, FMOD::Studio::EventDescription** description)
+	{
+		return system_->getEvent(path, description);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetBus(const char* path, FMOD::Studio::Bus** bus)
+	{
+		return system_->getBus(path, bus);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetGlobalParameterDescription(const char* name, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter)
+	{
+		return system_->getParameterDescriptionByName(name, parameter);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetGlobalParameters(const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count)
+	{
+		return system_->setParametersByIDs(ids, values, count);
+	}
+
+	FMOD_RESULT FMODAudioBackend::CreateInstance(FMOD::Studio::EventDescription* description, FMOD::Studio::EventInstance** instance)
+	{
+		return description->createInstance(instance);
+	}
+
+	FMOD_RESULT FMODAudioBackend::ReleaseAllInstances(FMOD::Studio::EventDescription* description)
+	{
+		return description->releaseAllInstances();
+	}
+
+	FMOD_RESULT FMODAudioBackend::LoadSampleData(FMOD::Studio::EventDescription* description)
+	{
+		return description->loadSampleData();
+	}
+
+	FMOD_RESULT FMODAudioBackend::UnloadSampleData(FMOD::Studio::EventDescription* description)
+	{
+		return description->unloadSampleData();
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetParameterCount(FMOD::Studio::EventDescription* description, int* count)
+	{
+		return description->getParameterDescriptionCount(count);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetParameterDescription(FMOD::Studio::EventDescription* description, int index, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter)
+	{
+		return description->getParameterDescriptionByIndex(index, parameter);
+	}
+
+	FMOD_RESULT FMODAudioBackend::StartInstance(FMOD::Studio::EventInstance* instance)
+	{
+		return instance->start();
+	}
+
+	FMOD_RESULT FMODAudioBackend::StopInstance(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_STOP_MODE mode)
+	{
+		return instance->stop(mode);
+	}
+
+	FMOD_RESULT FMODAudioBackend::ReleaseInstance(FMOD::Studio::EventInstance* instance)
+	{
+		return instance->release();
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetInstanceParameter(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PARAMETER_ID id, float value)
+	{
+		return instance->setParameterByID(id, value);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetInstanceParameterByName(FMOD::Studio::EventInstance* instance, const char* name, float value)
+	{
+		return instance->setParameterByName(name, value);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetInstanceParameters(FMOD::Studio::EventInstance* instance, const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count)
+	{
+		return instance->setParametersByIDs(ids, values, count);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetInstancePlaybackState(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PLAYBACK_STATE* state)
+	{
+		return instance->getPlaybackState(state);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetInstanceFinalVolume(FMOD::Studio::EventInstance* instance, float* volume)
+	{
+		return instance->getVolume(nullptr, volume);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetBusVolume(FMOD::Studio::Bus* bus, float volume)
+	{
+		return bus->setVolume(volume);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetBusVolume(FMOD::Studio::Bus* bus, float* volume)
+	{
+		return bus->getVolume(volume);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetBusPaused(FMOD::Studio::Bus* bus, bool paused)
+	{
+		return bus->setPaused(paused);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetBusPaused(FMOD::Studio::Bus* bus, bool* paused)
+	{
+		return bus->getPaused(paused);
+	}
+
+	FMOD_RESULT FMODAudioBackend::StopBusEvents(FMOD::Studio::Bus* bus, FMOD_STUDIO_STOP_MODE mode)
+	{
+		return bus->stopAllEvents(mode);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetMasterChannelGroup(FMOD::ChannelGroup** group)
+	{
+		return core_->getMasterChannelGroup(group);
+	}
+
+	FMOD_RESULT FMODAudioBackend::CreateChannelGroup(const char* name, FMOD::ChannelGroup** group)
+	{
+		return core_->createChannelGroup(name, group);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetChannelGroupVolume(FMOD::ChannelGroup* group, float volume)
+	{
+		return group->setVolume(volume);
+	}
+
+	FMOD_RESULT FMODAudioBackend::AddChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp)
+	{
+		return group->addDSP(FMOD_CHANNELCONTROL_DSP_HEAD, dsp);
+	}
+
+	FMOD_RESULT FMODAudioBackend::RemoveChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp)
+	{
+		return group->removeDSP(dsp);
+	}
+
+	FMOD_RESULT FMODAudioBackend::CreateEffectDSP(AudioEffect* effect, FMOD::DSP** dsp)
+	{
+		FMOD_DSP_DESCRIPTION description = {};
+		description.pluginsdkversion = FMOD_PLUGIN_SDK_VERSION;
+		strncpy(description.name, effect->GetName(), sizeof(description.name) - 1);
+		description.version = 1;
+		description.numinputbuffers = 1;
+		description.numoutputbuffers = 1;
+		description.read = ReadEffectDSP;
+		FMOD_RESULT result = core_->createDSP(&description, dsp);
+		if (result != FMOD_OK)
+		{
+			return result;
+		}
+		return (*dsp)->setUserData(effect);
+	}
+
+	FMOD_RESULT FMODAudioBackend::ReleaseDSP(FMOD::DSP* dsp)
+	{
+		return dsp->release();
+	}
+
+	FMOD_RESULT FMODAudioBackend::CreateSound(const char* name, FMOD_MODE mode, FMOD_CREATESOUNDEXINFO* info, FMOD::Sound** sound)
+	{
+		return core_->createSound(name, mode, info, sound);
+	}
+
+	FMOD_RESULT FMODAudioBackend::ReleaseSound(FMOD::Sound* sound)
+	{
+		return sound->release();
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetSoundMode(FMOD::Sound* sound, FMOD_MODE* mode)
+	{
+		return sound->getMode(mode);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetSoundLength(FMOD::Sound* sound, unsigned* length, FMOD_TIMEUNIT unit)
+	{
+		return sound->getLength(length, unit);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetSoundOpenState(FMOD::Sound* sound, FMOD_OPENSTATE* state)
+	{
+		return sound->getOpenState(state, nullptr, nullptr, nullptr);
+	}
+
+	FMOD_RESULT FMODAudioBackend::PlaySound(FMOD::Sound* sound, FMOD::ChannelGroup* group, bool paused, FMOD::Channel** channel)
+	{
+		return core_->playSound(sound, group, paused, channel);
+	}
+
+	FMOD_RESULT FMODAudioBackend::StopChannel(FMOD::Channel* channel)
+	{
+		return channel->stop();
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetChannelVolume(FMOD::Channel* channel, float volume)
+	{
+		return channel->setVolume(volume);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetChannelPaused(FMOD::Channel* channel, bool paused)
+	{
+		return channel->setPaused(paused);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetChannelPitch(FMOD::Channel* channel, float pitch)
+	{
+		return channel->setPitch(pitch);
+	}
+
+	FMOD_RESULT FMODAudioBackend::IsChannelPlaying(FMOD::Channel* channel, bool* playing)
+	{
+		return channel->isPlaying(playing);
+	}
+
+	FMOD_RESULT FMODAudioBackend::GetChannelDSPClock(FMOD::Channel* channel, unsigned long long* clock)
+	{
+		return channel->getDSPClock(nullptr, clock);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetChannelFadeRamp(FMOD::Channel* channel, unsigned long long clock, float volume)
+	{
+		return channel->setFadePointRamp(clock, volume);
+	}
+
+	FMOD_RESULT FMODAudioBackend::SetChannelDelay(FMOD::Channel* channel, unsigned long long startClock, unsigned long long endClock, bool stopChannel)
+	{
+		return channel->setDelay(startClock, endClock, stopChannel);
+	}
+}
@@ -0,0 +1,131 @@
+/* ======================================================================== /
+/!
+\file FMODAudioBackend.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the FMODAudioBackend class.
+This file contains the declaration of FMODAudioBackend, the AudioBackend
+forwarding every call to FMOD Studio and its core system.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef FMOD_AUDIO_BACKEND_H
+#define FMOD_AUDIO_BACKEND_H
+
+#include <string>
+#include <AudioBackend.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Class representing the FMOD implementation of AudioBackend.
+	 */
+	class FMODAudioBackend : public AudioBackend
+	{
+	public:
+		/**
+		 * \brief Default constructor for FMODAudioBackend. The systems are created by Initialize.
+		 */
+		FMODAudioBackend();
+
+		// System
+
+		FMOD_RESULT SetOutput(AudioOutputMode mode, const char* wavPath) override;
+		FMOD_RESULT SetMemoryArena(AudioMemoryArena* arena) override;
+		FMOD_RESULT SetFileIO(AudioFileIO* io) override;
+		FMOD_RESULT Initialize(int maxChannels, FMOD_STUDIO_INITFLAGS studioFlags) override;
+		FMOD_RESULT Release() override;
+		FMOD_RESULT Update() override;
+		FMOD_RESULT GetVersion(unsigned* version) override;
+		FMOD_RESULT GetOutputRate(int* rate) override;
+		FMOD_RESULT GetCPUUsage(FMOD_STUDIO_CPU_USAGE* studio, FMOD_CPU_USAGE* core) override;
+		FMOD_RESULT GetStudioMemoryUsage(FMOD_STUDIO_MEMORY_USAGE* usage) override;
+		FMOD_RESULT GetMemoryStats(int* current, int* peak) override;
+		FMOD_RESULT GetChannelsPlaying(int* channels, int* realChannels) override;
+		FMOD_RESULT GetStreamBufferSize(unsigned* size, FMOD_TIMEUNIT* unit) override;
+		FMOD_RESULT GetDSPBufferSize(unsigned* length, int* count) override;
+
+		// Studio objects
+
+		FMOD_RESULT LoadBankFile(const char* path, FMOD_STUDIO_LOAD_BANK_FLAGS flags, FMOD::Studio::Bank** bank) override;
+		FMOD_RESULT GetBankLoadingState(FMOD::Studio::Bank* bank, FMOD_STUDIO_LOADING_STATE* state) override;
+		FMOD_RESULT UnloadBank(FMOD::Studio::Bank* bank) override;
+		FMOD_RESULT GetEvent(const char* path, FMOD::Studio::EventDescription** description) override;
+		FMOD_RESULT GetBus(const char* path, FMOD::Studio::Bus** bus) override;
+		FMOD_RESULT GetGlobalParameterDescription(const char* name, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter) override;
+		FMOD_RESULT SetGlobalParameters(const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count) override;
+
+		// Event descriptions
+
+		FMOD_RESULT CreateInstance(FMOD::Studio::EventDescription* description, FMOD::Studio::EventInstance** instance) override;
+		FMOD_RESULT ReleaseAllInstances(FMOD::Studio::EventDescription* description) override;
+		FMOD_RESULT LoadSampleData(FMOD::Studio::EventDescription* description) override;
+		FMOD_RESULT UnloadSampleData(FMOD::Studio::EventDescription* description) override;
+		FMOD_RESULT GetParameterCount(FMOD::Studio::EventDescription* description, int* count) override;
+		FMOD_RESULT GetParameterDescription(FMOD::Studio::EventDescription* description, int index, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter) override;
+
+		// Event instances
+
+		FMOD_RESULT StartInstance(FMOD::Studio::EventInstance* instance) override;
+		FMOD_RESULT StopInstance(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_STOP_MODE mode) override;
+		FMOD_RESULT ReleaseInstance(FMOD::Studio::EventInstance* instance) override;
+		FMOD_RESULT SetInstanceParameter(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PARAMETER_ID id, float value) override;
+		FMOD_RESULT SetInstanceParameterByName(FMOD::Studio::EventInstance* instance, const char* name, float value) override;
+		FMOD_RESULT SetInstanceParameters(FMOD::Studio::EventInstance* instance, const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count) override;
+		FMOD_RESULT GetInstancePlaybackState(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PLAYBACK_STATE* state) override;
+		FMOD_RESULT GetInstanceFinalVolume(FMOD::Studio::EventInstance* instance, float* volume) override;
+
+		// Buses
+
+		FMOD_RESULT SetBusVolume(FMOD::Studio::Bus* bus, float volume) override;
+		FMOD_RESULT GetBusVolume(FMOD::Studio::Bus* bus, float* volume) override;
+		FMOD_RESULT SetBusPaused(FMOD::Studio::Bus* bus, bool paused) override;
+		FMOD_RESULT GetBusPaused(FMOD::Studio::Bus* bus, bool* paused) override;
+		FMOD_RESULT StopBusEvents(FMOD::Studio::Bus* bus, FMOD_STUDIO_STOP_MODE mode) override;
+
+		// Channel groups
+
+		FMOD_RESULT GetMasterChannelGroup(FMOD::ChannelGroup** group) override;
+		FMOD_RESULT CreateChannelGroup(const char* name, FMOD::ChannelGroup** group) override;
+		FMOD_RESULT SetChannelGroupVolume(FMOD::ChannelGroup* group, float volume) override;
+		FMOD_RESULT AddChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp) override;
+		FMOD_RESULT RemoveChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp) override;
+
+		// Effects
+
+		FMOD_RESULT CreateEffectDSP(AudioEffect* effect, FMOD::DSP** dsp) override;
+		FMOD_RESULT ReleaseDSP(FMOD::DSP* dsp) override;
+
+		// Sounds
+
+		FMOD_RESULT CreateSound(const char* name, FMOD_MODE mode, FMOD_CREATESOUNDEXINFO* info, FMOD::Sound** sound) override;
+		FMOD_RESULT ReleaseSound(FMOD::Sound* sound) override;
+		FMOD_RESULT GetSoundMode(FMOD::Sound* sound, FMOD_MODE* mode) override;
+		FMOD_RESULT GetSoundLength(FMOD::Sound* sound, unsigned* length, FMOD_TIMEUNIT unit) override;
+		FMOD_RESULT GetSoundOpenState(FMOD::Sound* sound, FMOD_OPENSTATE* state) override;
+
+		// Channels
+
+		FMOD_RESULT PlaySound(FMOD::Sound* sound, FMOD::ChannelGroup* group, bool paused, FMOD::Channel** channel) override;
+		FMOD_RESULT StopChannel(FMOD::Channel* channel) override;
+		FMOD_RESULT SetChannelVolume(FMOD::Channel* channel, float volume) override;
+		FMOD_RESULT SetChannelPaused(FMOD::Channel* channel, bool paused) override;
+		FMOD_RESULT SetChannelPitch(FMOD::Channel* channel, float pitch) override;
+		FMOD_RESULT IsChannelPlaying(FMOD::Channel* channel, bool* playing) override;
+		FMOD_RESULT GetChannelDSPClock(FMOD::Channel* channel, unsigned long long* clock) override;
+		FMOD_RESULT SetChannelFadeRamp(FMOD::Channel* channel, unsigned long long clock, float volume) override;
+		FMOD_RESULT SetChannelDelay(FMOD::Channel* channel, unsigned long long startClock, unsigned long long endClock, bool stopChannel) override;
+
+	private:
+		FMOD::Studio::System* system_; //!< The studio system.
+		FMOD::System* core_; //!< The core system owned by the studio system.
+		AudioOutputMode outputMode_; //!< Where Initialize sends the mix.
+		std::string outputPath_; //!< File written in WavFile mode.
+	};
+}
+
+#endif // FMOD_AUDIO_BACKEND_H
@@ -0,0 +1,145 @@
+/* ======================================================================== /
+/!
+\file MappedFile.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the MappedFile class.
+This file contains the implementation of the MappedFile class, using
+CreateFileMapping on Windows and mmap everywhere else.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <stdafx.h>
+#include <MappedFile.h>
+
+namespace DeckedOut
+{
+	MappedFile::MappedFile() :
+		data_(nullptr),
+		size_(0),
+		file_(nullptr),
+		mapping_(nullptr)
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const char* path)
+	{
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		file_ = file;
+		mapping_ = mapping;
+		data_ = static_cast<const uint8_t*>(data);
+		size_ = (size_t)size.QuadPart;
+#else
+		int descriptor = open(path, O_RDONLY);
+		if (descriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat status;
+		if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+		{
+			close(descriptor);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		// The mapping keeps its own reference to the file
+		close(descriptor);
+		if (data == MAP_FAILED)
+		{
+			return false;
+		}
+
+		data_ = static_cast<const uint8_t*>(data);
+		size_ = (size_t)status.st_size;
+#endif
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (data_ == nullptr)
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		UnmapViewOfFile(data_);
+		CloseHandle(mapping_);
+		CloseHandle(file_);
+#else
+		munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+		data_ = nullptr;
+		size_ = 0;
+		file_ = nullptr;
+		mapping_ = nullptr;
+	}
+
+	bool MappedFile::IsOpen() const
+	{
+		return data_ != nullptr;
+	}
+
+	const uint8_t* MappedFile::Data() const
+	{
+		return data_;
+	}
+
+	size_t MappedFile::Size() const
+	{
+		return size_;
+	}
+}
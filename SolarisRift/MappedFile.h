@@ -0,0 +1,82 @@
+/* ======================================================================== /
+/!
+\file MappedFile.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the MappedFile class.
+This file contains the declaration of the MappedFile class, a read-only
+memory mapping of a file on disk. It lets cooked data be used in place
+without being read into an intermediate buffer.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Class representing a read-only memory mapped file.
+	 */
+	class MappedFile
+	{
+	public:
+		/**
+		 * \brief Default constructor for MappedFile.
+		 */
+		MappedFile();
+
+		/**
+		 * \brief Destructor for MappedFile. Unmaps the file if it is open.
+		 */
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * \brief Maps a file into memory, closing any previously mapped file.
+		 * \param path The path of the file to map.
+		 * \return True if the file was mapped, false otherwise.
+		 */
+		bool Open(const char* path);
+
+		/**
+		 * \brief Unmaps the file.
+		 */
+		void Close();
+
+		/**
+		 * \brief Checks if a file is mapped.
+		 * \return True if a file is mapped, false otherwise.
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * \brief Gets the mapped bytes.
+		 * \return A pointer to the first byte of the file, or nullptr if no file is mapped.
+		 */
+		const uint8_t* Data() const;
+
+		/**
+		 * \brief Gets the size of the mapped file.
+		 * \return The size of the file in bytes.
+		 */
+		size_t Size() const;
+
+	private:
+		const uint8_t* data_; //!< First byte of the mapping.
+		size_t size_; //!< Size of the mapping in bytes.
+		void* file_; //!< Platform file handle, only used on Windows.
+		void* mapping_; //!< Platform mapping handle, only used on Windows.
+	};
+}
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,1042 @@
+/* ======================================================================== /
+/!
+\file NullAudioBackend.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Implementation of the NullAudioBackend class.
+This file contains the implementation of the AudioBackend that simulates
+FMOD without mixing.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <stdafx.h>
+#include <NullAudioBackend.h>
+
+namespace DeckedOut
+{
+	static constexpr int NULL_OUTPUT_RATE = 48000; //! Sample rate of the simulated mixer
+	static constexpr unsigned long long NULL_BLOCK_CLOCKS = 1024; //! DSP clocks the simulated mixer advances per Update
+	static constexpr unsigned NULL_SOUND_BYTES = 192000; //! Size reported for every sound, one second of 16-bit stereo
+	static constexpr unsigned NULL_STREAM_BUFFER_BYTES = 16384; //! Stream buffer size reported, the FMOD default
+	static constexpr int NULL_DSP_BUFFER_COUNT = 4; //! Mix blocks buffered reported, the FMOD default
+	static constexpr unsigned INDEX_BITS = 20; //! Bits of a handle holding the pool index, plus one so no handle is null
+	static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static constexpr uint32_t GENERATION_MASK = 0xFFF; //! Generations kept in a handle, what fits in 32 bits beside the index
+	static constexpr uint32_t NO_GROUP = UINT32_MAX; //! Channel group index of a DSP added to no group
+
+	/**
+	 * \brief Builds a handle from a pool index and a generation.
+	 * \param index The pool index.
+	 * \param generation The generation of the slot.
+	 * \return The handle, never nullptr.
+	 */
+	template <typename T>
+	static T* ToHandle(uint32_t index, uint32_t generation)
+	{
+		uintptr_t value = ((uintptr_t)(generation & GENERATION_MASK) << INDEX_BITS) | (uintptr_t)(index + 1);
+		return reinterpret_cast<T*>(value);
+	}
+
+	/**
+	 * \brief Splits a handle into its pool index and generation.
+	 * \param handle The handle.
+	 * \param index Receives the pool index.
+	 * \param generation Receives the generation, masked like the handle.
+	 * \return False for nullptr, true otherwise.
+	 */
+	static bool FromHandle(const void* handle, uint32_t& index, uint32_t& generation)
+	{
+		uintptr_t value = reinterpret_cast<uintptr_t>(handle);
+		if (value == 0)
+		{
+			return false;
+		}
+		index = (uint32_t)(value & INDEX_MASK) - 1;
+		generation = (uint32_t)(value >> INDEX_BITS) & GENERATION_MASK;
+		return true;
+	}
+
+	/**
+	 * \brief Takes a slot from a pool, growing the pool when no slot is free.
+	 * \param pool The pool.
+	 * \param freeList The first free slot, the pool size if none.
+	 * \return The index of the slot, or the index limit if the pool cannot grow.
+	 */
+	template <typename T>
+	static uint32_t AllocateSlot(std::vector<T>& pool, uint32_t& freeList)
+	{
+		if (freeList == pool.size())
+		{
+			if (pool.size() >= INDEX_MASK)
+			{
+				return INDEX_MASK;
+			}
+			pool.push_back(T());
+			pool.back().generation_ = 1;
+			freeList = (uint32_t)pool.size();
+			return (uint32_t)pool.size() - 1;
+		}
+
+		uint32_t index = freeList;
+		freeList = pool[index].nextFree_;
+		return index;
+	}
+
+	/**
+	 * \brief Returns a slot to a pool, making every handle to it stale.
+	 * \param pool The pool.
+	 * \param freeList The first free slot.
+	 * \param index The index of the slot.
+	 */
+	template <typename T>
+	static void FreeSlot(std::vector<T>& pool, uint32_t& freeList, uint32_t index)
+	{
+		T& slot = pool[index];
+		slot.used_ = false;
+		slot.generation_ = ((slot.generation_ + 1) & GENERATION_MASK) ? slot.generation_ + 1 : 1;
+		slot.nextFree_ = freeList;
+		freeList = index;
+	}
+
+	NullAudioBackend::NullAudioBackend() :
+		mutex_(),
+		instances_(),
+		freeInstance_(0),
+		channels_(),
+		freeChannel_(0),
+		sounds_(),
+		freeSound_(0),
+		dsps_(),
+		freeDSP_(0),
+		events_(),
+		parameters_(),
+		eventParameters_(),
+		busIndices_(),
+		buses_(),
+		channelGroupVolumes_(),
+		banks_(0),
+		maxChannels_(0),
+		clock_(0),
+		simulatedLength_(0),
+		peakBytes_(0),
+		stats_()
+	{
+	}
+
+	void NullAudioBackend::SetSimulatedLength(unsigned updates)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		simulatedLength_ = updates * NULL_BLOCK_CLOCKS;
+	}
+
+	void NullAudioBackend::SetEventParameters(const char* path, const std::vector<FMOD_STUDIO_PARAMETER_DESCRIPTION>& parameters)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		uint32_t index = ResolvePath(events_, path);
+		if (index >= eventParameters_.size())
+		{
+			eventParameters_.resize(index + 1);
+		}
+
+		// The event index and parameter index make the id, global parameters leave data2 at zero
+		std::vector<NullParameter>& eventParameters = eventParameters_[index];
+		eventParameters.clear();
+		for (size_t i = 0; i < parameters.size(); ++i)
+		{
+			NullParameter parameter;
+			parameter.description_ = parameters[i];
+			parameter.description_.name = nullptr;
+			parameter.description_.id.data1 = index + 1;
+			parameter.description_.id.data2 = (uint32_t)i + 1;
+			parameter.name_ = (parameters[i].name != nullptr) ? parameters[i].name : "";
+			eventParameters.push_back(parameter);
+		}
+	}
+
+	NullAudioBackendStats NullAudioBackend::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return stats_;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetOutput(AudioOutputMode mode, const char* wavPath)
+	{
+		// Nothing is mixed, so every mode advances one block per Update and no file is written
+		UNREFERENCED_PARAMETER(mode);
+		UNREFERENCED_PARAMETER(wavPath);
+		auto lock = Enter();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetMemoryArena(AudioMemoryArena* arena)
+	{
+		// The stand-in allocates its tables from the game heap, which the arena is meant to stay out of
+		UNREFERENCED_PARAMETER(arena);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetFileIO(AudioFileIO* io)
+	{
+		// Sounds are never read, so there is nothing to route
+		UNREFERENCED_PARAMETER(io);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::Initialize(int maxChannels, FMOD_STUDIO_INITFLAGS studioFlags)
+	{
+		UNREFERENCED_PARAMETER(studioFlags);
+		auto lock = Enter();
+		maxChannels_ = maxChannels;
+		clock_ = 0;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::Release()
+	{
+		auto lock = Enter();
+		instances_.clear();
+		freeInstance_ = 0;
+		channels_.clear();
+		freeChannel_ = 0;
+		sounds_.clear();
+		freeSound_ = 0;
+		dsps_.clear();
+		freeDSP_ = 0;
+		events_.clear();
+		parameters_.clear();
+		eventParameters_.clear();
+		busIndices_.clear();
+		buses_.clear();
+		channelGroupVolumes_.clear();
+		banks_ = 0;
+		stats_.liveInstances_ = 0;
+		stats_.liveChannels_ = 0;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::Update()
+	{
+		auto lock = Enter();
+		clock_ += NULL_BLOCK_CLOCKS;
+
+		// Channels that ended are recycled, as FMOD does during its update
+		for (uint32_t i = 0; i < channels_.size(); ++i)
+		{
+			if (channels_[i].used_ && ChannelEnded(channels_[i]))
+			{
+				FreeChannel(i);
+			}
+		}
+
+		int bytes = (int)(instances_.capacity() * sizeof(NullInstance) + channels_.capacity() * sizeof(NullChannel) +
+			sounds_.capacity() * sizeof(NullSound) + buses_.capacity() * sizeof(NullBus));
+		peakBytes_ = std::max(peakBytes_, bytes);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetVersion(unsigned* version)
+	{
+		auto lock = Enter();
+		*version = 0;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetOutputRate(int* rate)
+	{
+		auto lock = Enter();
+		*rate = NULL_OUTPUT_RATE;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetCPUUsage(FMOD_STUDIO_CPU_USAGE* studio, FMOD_CPU_USAGE* core)
+	{
+		auto lock = Enter();
+		*studio = FMOD_STUDIO_CPU_USAGE();
+		*core = FMOD_CPU_USAGE();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetStudioMemoryUsage(FMOD_STUDIO_MEMORY_USAGE* usage)
+	{
+		auto lock = Enter();
+		*usage = FMOD_STUDIO_MEMORY_USAGE();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetMemoryStats(int* current, int* peak)
+	{
+		auto lock = Enter();
+		*current = (int)(instances_.capacity() * sizeof(NullInstance) + channels_.capacity() * sizeof(NullChannel) +
+			sounds_.capacity() * sizeof(NullSound) + buses_.capacity() * sizeof(NullBus));
+		*peak = std::max(peakBytes_, *current);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetChannelsPlaying(int* channels, int* realChannels)
+	{
+		auto lock = Enter();
+		*channels = (int)stats_.liveChannels_;
+		if (realChannels != nullptr)
+		{
+			*realChannels = std::min(*channels, maxChannels_);
+		}
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetStreamBufferSize(unsigned* size, FMOD_TIMEUNIT* unit)
+	{
+		auto lock = Enter();
+		*size = NULL_STREAM_BUFFER_BYTES;
+		*unit = FMOD_TIMEUNIT_RAWBYTES;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetDSPBufferSize(unsigned* length, int* count)
+	{
+		auto lock = Enter();
+		*length = (unsigned)NULL_BLOCK_CLOCKS;
+		*count = NULL_DSP_BUFFER_COUNT;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::LoadBankFile(const char* path, FMOD_STUDIO_LOAD_BANK_FLAGS flags, FMOD::Studio::Bank** bank)
+	{
+		UNREFERENCED_PARAMETER(path);
+		UNREFERENCED_PARAMETER(flags);
+		auto lock = Enter();
+		*bank = ToHandle<FMOD::Studio::Bank>(banks_++, 1);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetBankLoadingState(FMOD::Studio::Bank* bank, FMOD_STUDIO_LOADING_STATE* state)
+	{
+		UNREFERENCED_PARAMETER(bank);
+		auto lock = Enter();
+		*state = FMOD_STUDIO_LOADING_STATE_LOADED;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::UnloadBank(FMOD::Studio::Bank* bank)
+	{
+		UNREFERENCED_PARAMETER(bank);
+		auto lock = Enter();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetEvent(const char* path, FMOD::Studio::EventDescription** description)
+	{
+		auto lock = Enter();
+		*description = ToHandle<FMOD::Studio::EventDescription>(ResolvePath(events_, path), 1);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetBus(const char* path, FMOD::Studio::Bus** bus)
+	{
+		auto lock = Enter();
+		uint32_t index = ResolvePath(busIndices_, path);
+		if (index == buses_.size())
+		{
+			NullBus newBus = { 1.0f, false };
+			buses_.push_back(newBus);
+		}
+		*bus = ToHandle<FMOD::Studio::Bus>(index, 1);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetGlobalParameterDescription(const char* name, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter)
+	{
+		auto lock = Enter();
+		*parameter = FMOD_STUDIO_PARAMETER_DESCRIPTION();
+		parameter->name = name;
+		parameter->id.data1 = ResolvePath(parameters_, name) + 1;
+		parameter->flags = FMOD_STUDIO_PARAMETER_GLOBAL;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetGlobalParameters(const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count)
+	{
+		UNREFERENCED_PARAMETER(ids);
+		UNREFERENCED_PARAMETER(values);
+		auto lock = Enter();
+		stats_.parameterChanges_ += count;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::CreateInstance(FMOD::Studio::EventDescription* description, FMOD::Studio::EventInstance** instance)
+	{
+		auto lock = Enter();
+		uint32_t descriptionIndex;
+		uint32_t generation;
+		if (!FromHandle(description, descriptionIndex, generation))
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+
+		uint32_t index = AllocateSlot(instances_, freeInstance_);
+		if (index == INDEX_MASK)
+		{
+			return FMOD_ERR_MEMORY;
+		}
+		NullInstance& slot = instances_[index];
+		slot.description_ = descriptionIndex;
+		slot.startClock_ = 0;
+		slot.used_ = true;
+		slot.playing_ = false;
+		++stats_.liveInstances_;
+		*instance = ToHandle<FMOD::Studio::EventInstance>(index, slot.generation_);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::ReleaseAllInstances(FMOD::Studio::EventDescription* description)
+	{
+		auto lock = Enter();
+		uint32_t descriptionIndex;
+		uint32_t generation;
+		if (!FromHandle(description, descriptionIndex, generation))
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+
+		for (uint32_t i = 0; i < instances_.size(); ++i)
+		{
+			if (instances_[i].used_ && instances_[i].description_ == descriptionIndex)
+			{
+				FreeSlot(instances_, freeInstance_, i);
+				--stats_.liveInstances_;
+			}
+		}
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::LoadSampleData(FMOD::Studio::EventDescription* description)
+	{
+		UNREFERENCED_PARAMETER(description);
+		auto lock = Enter();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::UnloadSampleData(FMOD::Studio::EventDescription* description)
+	{
+		UNREFERENCED_PARAMETER(description);
+		auto lock = Enter();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetParameterCount(FMOD::Studio::EventDescription* description, int* count)
+	{
+		auto lock = Enter();
+		uint32_t descriptionIndex;
+		uint32_t generation;
+		if (!FromHandle(description, descriptionIndex, generation))
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*count = (descriptionIndex < eventParameters_.size()) ? (int)eventParameters_[descriptionIndex].size() : 0;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetParameterDescription(FMOD::Studio::EventDescription* description, int index, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter)
+	{
+		auto lock = Enter();
+		uint32_t descriptionIndex;
+		uint32_t generation;
+		if (!FromHandle(description, descriptionIndex, generation))
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		if (descriptionIndex >= eventParameters_.size() || index < 0 || (size_t)index >= eventParameters_[descriptionIndex].size())
+		{
+			return FMOD_ERR_INVALID_PARAM;
+		}
+
+		// The name stays valid until the parameters of the event are set again, like FMOD's until the bank unloads
+		const NullParameter& eventParameter = eventParameters_[descriptionIndex][index];
+		*parameter = eventParameter.description_;
+		parameter->name = eventParameter.name_.c_str();
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::StartInstance(FMOD::Studio::EventInstance* instance)
+	{
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		slot->playing_ = true;
+		slot->startClock_ = clock_;
+		++stats_.instancesStarted_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::StopInstance(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_STOP_MODE mode)
+	{
+		UNREFERENCED_PARAMETER(mode);
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		slot->playing_ = false;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::ReleaseInstance(FMOD::Studio::EventInstance* instance)
+	{
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		FreeSlot(instances_, freeInstance_, (uint32_t)(slot - instances_.data()));
+		--stats_.liveInstances_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetInstanceParameter(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PARAMETER_ID id, float value)
+	{
+		UNREFERENCED_PARAMETER(value);
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		if (!HasParameter(*slot, id))
+		{
+			return FMOD_ERR_INVALID_PARAM;
+		}
+		++stats_.parameterChanges_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetInstanceParameterByName(FMOD::Studio::EventInstance* instance, const char* name, float value)
+	{
+		UNREFERENCED_PARAMETER(name);
+		UNREFERENCED_PARAMETER(value);
+		auto lock = Enter();
+		if (FindInstance(instance) == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		++stats_.parameterChanges_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetInstanceParameters(FMOD::Studio::EventInstance* instance, const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count)
+	{
+		UNREFERENCED_PARAMETER(values);
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		for (int i = 0; i < count; ++i)
+		{
+			if (!HasParameter(*slot, ids[i]))
+			{
+				return FMOD_ERR_INVALID_PARAM;
+			}
+		}
+		stats_.parameterChanges_ += count;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetInstancePlaybackState(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PLAYBACK_STATE* state)
+	{
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+
+		bool ended = simulatedLength_ != 0 && clock_ - slot->startClock_ >= simulatedLength_;
+		*state = (slot->playing_ && !ended) ? FMOD_STUDIO_PLAYBACK_PLAYING : FMOD_STUDIO_PLAYBACK_STOPPED;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetInstanceFinalVolume(FMOD::Studio::EventInstance* instance, float* volume)
+	{
+		auto lock = Enter();
+		NullInstance* slot = FindInstance(instance);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*volume = slot->playing_ ? 1.0f : 0.0f;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetBusVolume(FMOD::Studio::Bus* bus, float volume)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(bus, index, generation) || index >= buses_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		buses_[index].volume_ = volume;
+		++stats_.busChanges_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetBusVolume(FMOD::Studio::Bus* bus, float* volume)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(bus, index, generation) || index >= buses_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*volume = buses_[index].volume_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetBusPaused(FMOD::Studio::Bus* bus, bool paused)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(bus, index, generation) || index >= buses_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		buses_[index].paused_ = paused;
+		++stats_.busChanges_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetBusPaused(FMOD::Studio::Bus* bus, bool* paused)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(bus, index, generation) || index >= buses_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*paused = buses_[index].paused_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::StopBusEvents(FMOD::Studio::Bus* bus, FMOD_STUDIO_STOP_MODE mode)
+	{
+		UNREFERENCED_PARAMETER(mode);
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(bus, index, generation) || index >= buses_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+
+		// Events are not routed in the simulation, so every bus reaches every instance
+		for (NullInstance& instance : instances_)
+		{
+			instance.playing_ = false;
+		}
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetMasterChannelGroup(FMOD::ChannelGroup** group)
+	{
+		auto lock = Enter();
+		if (channelGroupVolumes_.empty())
+		{
+			channelGroupVolumes_.push_back(1.0f);
+		}
+		*group = ToHandle<FMOD::ChannelGroup>(0, 1);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::CreateChannelGroup(const char* name, FMOD::ChannelGroup** group)
+	{
+		UNREFERENCED_PARAMETER(name);
+		auto lock = Enter();
+		if (channelGroupVolumes_.empty())
+		{
+			channelGroupVolumes_.push_back(1.0f);
+		}
+		channelGroupVolumes_.push_back(1.0f);
+		*group = ToHandle<FMOD::ChannelGroup>((uint32_t)channelGroupVolumes_.size() - 1, 1);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetChannelGroupVolume(FMOD::ChannelGroup* group, float volume)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(group, index, generation) || index >= channelGroupVolumes_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		channelGroupVolumes_[index] = volume;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::AddChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(group, index, generation) || index >= channelGroupVolumes_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		NullDSP* slot = FindDSP(dsp);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		if (slot->group_ != NO_GROUP)
+		{
+			return FMOD_ERR_DSP_INUSE;
+		}
+		slot->group_ = index;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::RemoveChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp)
+	{
+		auto lock = Enter();
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(group, index, generation) || index >= channelGroupVolumes_.size())
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		NullDSP* slot = FindDSP(dsp);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		if (slot->group_ != index)
+		{
+			return FMOD_ERR_DSP_NOTFOUND;
+		}
+		slot->group_ = NO_GROUP;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::CreateEffectDSP(AudioEffect* effect, FMOD::DSP** dsp)
+	{
+		auto lock = Enter();
+		uint32_t index = AllocateSlot(dsps_, freeDSP_);
+		if (index == INDEX_MASK)
+		{
+			return FMOD_ERR_MEMORY;
+		}
+		NullDSP& slot = dsps_[index];
+		slot.effect_ = effect;
+		slot.group_ = NO_GROUP;
+		slot.used_ = true;
+		*dsp = ToHandle<FMOD::DSP>(index, slot.generation_);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::ReleaseDSP(FMOD::DSP* dsp)
+	{
+		auto lock = Enter();
+		NullDSP* slot = FindDSP(dsp);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		if (slot->group_ != NO_GROUP)
+		{
+			return FMOD_ERR_DSP_INUSE;
+		}
+		FreeSlot(dsps_, freeDSP_, (uint32_t)(slot - dsps_.data()));
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::CreateSound(const char* name, FMOD_MODE mode, FMOD_CREATESOUNDEXINFO* info, FMOD::Sound** sound)
+	{
+		UNREFERENCED_PARAMETER(name);
+		UNREFERENCED_PARAMETER(info);
+		auto lock = Enter();
+		uint32_t index = AllocateSlot(sounds_, freeSound_);
+		if (index == INDEX_MASK)
+		{
+			return FMOD_ERR_MEMORY;
+		}
+		NullSound& slot = sounds_[index];
+		slot.mode_ = mode;
+		slot.used_ = true;
+		*sound = ToHandle<FMOD::Sound>(index, slot.generation_);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::ReleaseSound(FMOD::Sound* sound)
+	{
+		auto lock = Enter();
+		NullSound* slot = FindSound(sound);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		FreeSlot(sounds_, freeSound_, (uint32_t)(slot - sounds_.data()));
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetSoundMode(FMOD::Sound* sound, FMOD_MODE* mode)
+	{
+		auto lock = Enter();
+		NullSound* slot = FindSound(sound);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*mode = slot->mode_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetSoundLength(FMOD::Sound* sound, unsigned* length, FMOD_TIMEUNIT unit)
+	{
+		UNREFERENCED_PARAMETER(unit);
+		auto lock = Enter();
+		if (FindSound(sound) == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*length = NULL_SOUND_BYTES;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetSoundOpenState(FMOD::Sound* sound, FMOD_OPENSTATE* state)
+	{
+		auto lock = Enter();
+		if (FindSound(sound) == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*state = FMOD_OPENSTATE_READY;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::PlaySound(FMOD::Sound* sound, FMOD::ChannelGroup* group, bool paused, FMOD::Channel** channel)
+	{
+		UNREFERENCED_PARAMETER(group);
+		auto lock = Enter();
+		NullSound* soundSlot = FindSound(sound);
+		if (soundSlot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+
+		uint32_t index = AllocateSlot(channels_, freeChannel_);
+		if (index == INDEX_MASK)
+		{
+			return FMOD_ERR_CHANNEL_ALLOC;
+		}
+		NullChannel& slot = channels_[index];
+		slot.startClock_ = clock_;
+		slot.endClock_ = 0;
+		slot.volume_ = 1.0f;
+		slot.pitch_ = 1.0f;
+		slot.used_ = true;
+		slot.paused_ = paused;
+		slot.looping_ = (soundSlot->mode_ & FMOD_LOOP_NORMAL) != 0;
+		++stats_.liveChannels_;
+		++stats_.channelsPlayed_;
+		*channel = ToHandle<FMOD::Channel>(index, slot.generation_);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::StopChannel(FMOD::Channel* channel)
+	{
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		FreeChannel((uint32_t)(slot - channels_.data()));
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetChannelVolume(FMOD::Channel* channel, float volume)
+	{
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		slot->volume_ = volume;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetChannelPaused(FMOD::Channel* channel, bool paused)
+	{
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		slot->paused_ = paused;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetChannelPitch(FMOD::Channel* channel, float pitch)
+	{
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		slot->pitch_ = pitch;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::IsChannelPlaying(FMOD::Channel* channel, bool* playing)
+	{
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*playing = !ChannelEnded(*slot);
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::GetChannelDSPClock(FMOD::Channel* channel, unsigned long long* clock)
+	{
+		auto lock = Enter();
+		if (FindChannel(channel) == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		*clock = clock_;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetChannelFadeRamp(FMOD::Channel* channel, unsigned long long clock, float volume)
+	{
+		UNREFERENCED_PARAMETER(clock);
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+
+		// Nothing is mixed, so the ramp lands on its target at once
+		slot->volume_ = volume;
+		return FMOD_OK;
+	}
+
+	FMOD_RESULT NullAudioBackend::SetChannelDelay(FMOD::Channel* channel, unsigned long long startClock, unsigned long long endClock, bool stopChannel)
+	{
+		UNREFERENCED_PARAMETER(startClock);
+		auto lock = Enter();
+		NullChannel* slot = FindChannel(channel);
+		if (slot == nullptr)
+		{
+			return FMOD_ERR_INVALID_HANDLE;
+		}
+		if (stopChannel)
+		{
+			slot->endClock_ = endClock;
+		}
+		return FMOD_OK;
+	}
+
+	std::unique_lock<std::mutex> NullAudioBackend::Enter()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		++stats_.calls_;
+		return lock;
+	}
+
+	bool NullAudioBackend::ChannelEnded(const NullChannel& channel) const
+	{
+		if (channel.endClock_ != 0 && clock_ >= channel.endClock_)
+		{
+			return true;
+		}
+		return !channel.looping_ && simulatedLength_ != 0 && clock_ - channel.startClock_ >= simulatedLength_;
+	}
+
+	NullAudioBackend::NullInstance* NullAudioBackend::FindInstance(FMOD::Studio::EventInstance* instance)
+	{
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(instance, index, generation) || index >= instances_.size())
+		{
+			return nullptr;
+		}
+		NullInstance& slot = instances_[index];
+		return (slot.used_ && (slot.generation_ & GENERATION_MASK) == generation) ? &slot : nullptr;
+	}
+
+	NullAudioBackend::NullChannel* NullAudioBackend::FindChannel(FMOD::Channel* channel)
+	{
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(channel, index, generation) || index >= channels_.size())
+		{
+			return nullptr;
+		}
+		NullChannel& slot = channels_[index];
+		return (slot.used_ && (slot.generation_ & GENERATION_MASK) == generation) ? &slot : nullptr;
+	}
+
+	NullAudioBackend::NullSound* NullAudioBackend::FindSound(FMOD::Sound* sound)
+	{
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(sound, index, generation) || index >= sounds_.size())
+		{
+			return nullptr;
+		}
+		NullSound& slot = sounds_[index];
+		return (slot.used_ && (slot.generation_ & GENERATION_MASK) == generation) ? &slot : nullptr;
+	}
+
+	NullAudioBackend::NullDSP* NullAudioBackend::FindDSP(FMOD::DSP* dsp)
+	{
+		uint32_t index;
+		uint32_t generation;
+		if (!FromHandle(dsp, index, generation) || index >= dsps_.size())
+		{
+			return nullptr;
+		}
+		NullDSP& slot = dsps_[index];
+		return (slot.used_ && (slot.generation_ & GENERATION_MASK) == generation) ? &slot : nullptr;
+	}
+
+	bool NullAudioBackend::HasParameter(const NullInstance& instance, FMOD_STUDIO_PARAMETER_ID id) const
+	{
+		return id.data1 == instance.description_ + 1 && instance.description_ < eventParameters_.size() &&
+			id.data2 != 0 && id.data2 <= eventParameters_[instance.description_].size();
+	}
+
+	void NullAudioBackend::FreeChannel(uint32_t index)
+	{
+		FreeSlot(channels_, freeChannel_, index);
+		--stats_.liveChannels_;
+	}
+
+	uint32_t NullAudioBackend::ResolvePath(std::unordered_map<std::string, uint32_t>& indices, const char* path)
+	{
+		auto it = indices.emplace(path, (uint32_t)indices.size()).first;
+		return it->second;
+	}
+}
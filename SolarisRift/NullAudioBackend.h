@@ -0,0 +1,274 @@
+/* ======================================================================== /
+/!
+\file NullAudioBackend.h
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Header file for the NullAudioBackend class.
+This file contains the declaration of NullAudioBackend, an AudioBackend that
+mixes nothing. It counts the calls it receives and simulates instances,
+channels and buses, so the audio system can run on machines without an
+audio device and its bookkeeping can be measured on its own.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#ifndef NULL_AUDIO_BACKEND_H
+#define NULL_AUDIO_BACKEND_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <AudioBackend.h>
+
+namespace DeckedOut
+{
+	/**
+	 * \brief Struct reporting the calls a NullAudioBackend received.
+	 */
+	struct NullAudioBackendStats
+	{
+		uint64_t calls_; //!< Calls of every kind.
+		uint64_t instancesStarted_; //!< Event instances started.
+		uint64_t channelsPlayed_; //!< Sounds played on a channel.
+		uint64_t parameterChanges_; //!< Instance and global parameters set, counting each of a batch.
+		uint64_t busChanges_; //!< Bus volumes and pauses set.
+		unsigned liveInstances_; //!< Event instances created and not released.
+		unsigned liveChannels_; //!< Channels that have not ended.
+	};
+
+	/**
+	 * \brief Class representing an AudioBackend that simulates FMOD without mixing.
+	 *
+	 * Every event and bus path exists, events have the parameters given to SetEventParameters, none
+	 * by default, and sounds open instantly. The
+	 * simulated DSP clock advances by one mixer block per Update. Handles encode a pool index and a
+	 * generation, so stale handles are rejected with FMOD_ERR_INVALID_HANDLE like FMOD does.
+	 */
+	class NullAudioBackend : public AudioBackend
+	{
+	public:
+		/**
+		 * \brief Default constructor for NullAudioBackend.
+		 */
+		NullAudioBackend();
+
+		/**
+		 * \brief Sets how long started instances and non-looping channels play before ending by
+		 * themselves.
+		 * \param updates The length in calls to Update, 0 to play until stopped.
+		 */
+		void SetSimulatedLength(unsigned updates);
+
+		/**
+		 * \brief Sets the parameters an event describes, kept until Release. Each parameter is given
+		 * an id of its own, and setting an instance parameter by an id its event lacks fails.
+		 * \param path The path of the event.
+		 * \param parameters The descriptions of the parameters, their names are copied.
+		 */
+		void SetEventParameters(const char* path, const std::vector<FMOD_STUDIO_PARAMETER_DESCRIPTION>& parameters);
+
+		/**
+		 * \brief Gets the counts of the calls received so far.
+		 * \return The call counts.
+		 */
+		NullAudioBackendStats GetStats() const;
+
+		// System
+
+		FMOD_RESULT SetOutput(AudioOutputMode mode, const char* wavPath) override;
+		FMOD_RESULT SetMemoryArena(AudioMemoryArena* arena) override;
+		FMOD_RESULT SetFileIO(AudioFileIO* io) override;
+		FMOD_RESULT Initialize(int maxChannels, FMOD_STUDIO_INITFLAGS studioFlags) override;
+		FMOD_RESULT Release() override;
+		FMOD_RESULT Update() override;
+		FMOD_RESULT GetVersion(unsigned* version) override;
+		FMOD_RESULT GetOutputRate(int* rate) override;
+		FMOD_RESULT GetCPUUsage(FMOD_STUDIO_CPU_USAGE* studio, FMOD_CPU_USAGE* core) override;
+		FMOD_RESULT GetStudioMemoryUsage(FMOD_STUDIO_MEMORY_USAGE* usage) override;
+		FMOD_RESULT GetMemoryStats(int* current, int* peak) override;
+		FMOD_RESULT GetChannelsPlaying(int* channels, int* realChannels) override;
+		FMOD_RESULT GetStreamBufferSize(unsigned* size, FMOD_TIMEUNIT* unit) override;
+		FMOD_RESULT GetDSPBufferSize(unsigned* length, int* count) override;
+
+		// Studio objects
+
+		FMOD_RESULT LoadBankFile(const char* path, FMOD_STUDIO_LOAD_BANK_FLAGS flags, FMOD::Studio::Bank** bank) override;
+		FMOD_RESULT GetBankLoadingState(FMOD::Studio::Bank* bank, FMOD_STUDIO_LOADING_STATE* state) override;
+		FMOD_RESULT UnloadBank(FMOD::Studio::Bank* bank) override;
+		FMOD_RESULT GetEvent(const char* path, FMOD::Studio::EventDescription** description) override;
+		FMOD_RESULT GetBus(const char* path, FMOD::Studio::Bus** bus) override;
+		FMOD_RESULT GetGlobalParameterDescription(const char* name, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter) override;
+		FMOD_RESULT SetGlobalParameters(const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count) override;
+
+		// Event descriptions
+
+		FMOD_RESULT CreateInstance(FMOD::Studio::EventDescription* description, FMOD::Studio::EventInstance** instance) override;
+		FMOD_RESULT ReleaseAllInstances(FMOD::Studio::EventDescription* description) override;
+		FMOD_RESULT LoadSampleData(FMOD::Studio::EventDescription* description) override;
+		FMOD_RESULT UnloadSampleData(FMOD::Studio::EventDescription* description) override;
+		FMOD_RESULT GetParameterCount(FMOD::Studio::EventDescription* description, int* count) override;
+		FMOD_RESULT GetParameterDescription(FMOD::Studio::EventDescription* description, int index, FMOD_STUDIO_PARAMETER_DESCRIPTION* parameter) override;
+
+		// Event instances
+
+		FMOD_RESULT StartInstance(FMOD::Studio::EventInstance* instance) override;
+		FMOD_RESULT StopInstance(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_STOP_MODE mode) override;
+		FMOD_RESULT ReleaseInstance(FMOD::Studio::EventInstance* instance) override;
+		FMOD_RESULT SetInstanceParameter(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PARAMETER_ID id, float value) override;
+		FMOD_RESULT SetInstanceParameterByName(FMOD::Studio::EventInstance* instance, const char* name, float value) override;
+		FMOD_RESULT SetInstanceParameters(FMOD::Studio::EventInstance* instance, const FMOD_STUDIO_PARAMETER_ID* ids, float* values, int count) override;
+		FMOD_RESULT GetInstancePlaybackState(FMOD::Studio::EventInstance* instance, FMOD_STUDIO_PLAYBACK_STATE* state) override;
+		FMOD_RESULT GetInstanceFinalVolume(FMOD::Studio::EventInstance* instance, float* volume) override;
+
+		// Buses
+
+		FMOD_RESULT SetBusVolume(FMOD::Studio::Bus* bus, float volume) override;
+		FMOD_RESULT GetBusVolume(FMOD::Studio::Bus* bus, float* volume) override;
+		FMOD_RESULT SetBusPaused(FMOD::Studio::Bus* bus, bool paused) override;
+		FMOD_RESULT GetBusPaused(FMOD::Studio::Bus* bus, bool* paused) override;
+		FMOD_RESULT StopBusEvents(FMOD::Studio::Bus* bus, FMOD_STUDIO_STOP_MODE mode) override;
+
+		// Channel groups
+
+		FMOD_RESULT GetMasterChannelGroup(FMOD::ChannelGroup** group) override;
+		FMOD_RESULT CreateChannelGroup(const char* name, FMOD::ChannelGroup** group) override;
+		FMOD_RESULT SetChannelGroupVolume(FMOD::ChannelGroup* group, float volume) override;
+		FMOD_RESULT AddChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp) override;
+		FMOD_RESULT RemoveChannelGroupDSP(FMOD::ChannelGroup* group, FMOD::DSP* dsp) override;
+
+		// Effects
+
+		FMOD_RESULT CreateEffectDSP(AudioEffect* effect, FMOD::DSP** dsp) override;
+		FMOD_RESULT ReleaseDSP(FMOD::DSP* dsp) override;
+
+		// Sounds
+
+		FMOD_RESULT CreateSound(const char* name, FMOD_MODE mode, FMOD_CREATESOUNDEXINFO* info, FMOD::Sound** sound) override;
+		FMOD_RESULT ReleaseSound(FMOD::Sound* sound) override;
+		FMOD_RESULT GetSoundMode(FMOD::Sound* sound, FMOD_MODE* mode) override;
+		FMOD_RESULT GetSoundLength(FMOD::Sound* sound, unsigned* length, FMOD_TIMEUNIT unit) override;
+		FMOD_RESULT GetSoundOpenState(FMOD::Sound* sound, FMOD_OPENSTATE* state) override;
+
+		// Channels
+
+		FMOD_RESULT PlaySound(FMOD::Sound* sound, FMOD::ChannelGroup* group, bool paused, FMOD::Channel** channel) override;
+		FMOD_RESULT StopChannel(FMOD::Channel* channel) override;
+		FMOD_RESULT SetChannelVolume(FMOD::Channel* channel, float volume) override;
+		FMOD_RESULT SetChannelPaused(FMOD::Channel* channel, bool paused) override;
+		FMOD_RESULT SetChannelPitch(FMOD::Channel* channel, float pitch) override;
+		FMOD_RESULT IsChannelPlaying(FMOD::Channel* channel, bool* playing) override;
+		FMOD_RESULT GetChannelDSPClock(FMOD::Channel* channel, unsigned long long* clock) override;
+		FMOD_RESULT SetChannelFadeRamp(FMOD::Channel* channel, unsigned long long clock, float volume) override;
+		FMOD_RESULT SetChannelDelay(FMOD::Channel* channel, unsigned long long startClock, unsigned long long endClock, bool stopChannel) override;
+
+	private:
+		/**
+		 * \brief A simulated event instance.
+		 */
+		struct NullInstance
+		{
+			uint32_t description_; //!< Index of the event it was created from.
+			uint32_t generation_; //!< Incremented when the slot is freed.
+			uint32_t nextFree_; //!< Next free slot while free.
+			unsigned long long startClock_; //!< Clock at which it was last started.
+			bool used_; //!< Whether the slot holds an instance.
+			bool playing_; //!< Whether it was started and not stopped.
+		};
+
+		/**
+		 * \brief A simulated channel.
+		 */
+		struct NullChannel
+		{
+			uint32_t generation_; //!< Incremented when the slot is freed.
+			uint32_t nextFree_; //!< Next free slot while free.
+			unsigned long long startClock_; //!< Clock at which it started.
+			unsigned long long endClock_; //!< Clock at which a delayed stop ends it, 0 if none.
+			float volume_; //!< Volume of the channel.
+			float pitch_; //!< Playback rate ratio of the channel.
+			bool used_; //!< Whether the slot holds a channel.
+			bool paused_; //!< Whether the channel is paused.
+			bool looping_; //!< Whether the channel plays a looping sound.
+		};
+
+		/**
+		 * \brief A simulated sound.
+		 */
+		struct NullSound
+		{
+			uint32_t generation_; //!< Incremented when the slot is freed.
+			uint32_t nextFree_; //!< Next free slot while free.
+			FMOD_MODE mode_; //!< The mode it was opened with.
+			bool used_; //!< Whether the slot holds a sound.
+		};
+
+		/**
+		 * \brief A simulated DSP. Its effect never runs, since nothing is mixed.
+		 */
+		struct NullDSP
+		{
+			uint32_t generation_; //!< Incremented when the slot is freed.
+			uint32_t nextFree_; //!< Next free slot while free.
+			AudioEffect* effect_; //!< The effect it would run.
+			uint32_t group_; //!< Index of the channel group it is added to, NO_GROUP if none.
+			bool used_; //!< Whether the slot holds a DSP.
+		};
+
+		/**
+		 * \brief A parameter of a simulated event.
+		 */
+		struct NullParameter
+		{
+			FMOD_STUDIO_PARAMETER_DESCRIPTION description_; //!< The description, pointing to no name.
+			std::string name_; //!< Name of the parameter.
+		};
+
+		/**
+		 * \brief A simulated bus.
+		 */
+		struct NullBus
+		{
+			float volume_; //!< Volume of the bus.
+			bool paused_; //!< Whether the bus is paused.
+		};
+
+		std::unique_lock<std::mutex> Enter(); //!< Locks the backend and counts the call.
+		bool ChannelEnded(const NullChannel& channel) const; //!< Checks if a channel ended by itself.
+		NullInstance* FindInstance(FMOD::Studio::EventInstance* instance); //!< Gets an instance, or nullptr if the handle is stale.
+		NullChannel* FindChannel(FMOD::Channel* channel); //!< Gets a channel, or nullptr if the handle is stale.
+		NullSound* FindSound(FMOD::Sound* sound); //!< Gets a sound, or nullptr if the handle is stale.
+		NullDSP* FindDSP(FMOD::DSP* dsp); //!< Gets a DSP, or nullptr if the handle is stale.
+		bool HasParameter(const NullInstance& instance, FMOD_STUDIO_PARAMETER_ID id) const; //!< Checks if the event of an instance describes a parameter id.
+		void FreeChannel(uint32_t index); //!< Recycles the slot of a channel.
+		uint32_t ResolvePath(std::unordered_map<std::string, uint32_t>& indices, const char* path); //!< Gets the index of a path, adding it if new.
+
+		mutable std::mutex mutex_; //!< Guards the whole backend, FMOD is also safe to call from several threads.
+		std::vector<NullInstance> instances_; //!< Pool of instances.
+		uint32_t freeInstance_; //!< First free instance, the pool size if none.
+		std::vector<NullChannel> channels_; //!< Pool of channels.
+		uint32_t freeChannel_; //!< First free channel, the pool size if none.
+		std::vector<NullSound> sounds_; //!< Pool of sounds.
+		uint32_t freeSound_; //!< First free sound, the pool size if none.
+		std::vector<NullDSP> dsps_; //!< Pool of DSPs.
+		uint32_t freeDSP_; //!< First free DSP, the pool size if none.
+		std::unordered_map<std::string, uint32_t> events_; //!< Index of every event path asked for.
+		std::unordered_map<std::string, uint32_t> parameters_; //!< Index of every global parameter asked for.
+		std::vector<std::vector<NullParameter>> eventParameters_; //!< Parameters of each event, by index, none past the end.
+		std::unordered_map<std::string, uint32_t> busIndices_; //!< Index of every bus path asked for.
+		std::vector<NullBus> buses_; //!< The buses, by index.
+		std::vector<float> channelGroupVolumes_; //!< Volume of each channel group, the master group first.
+		unsigned banks_; //!< Number of banks loaded.
+		int maxChannels_; //!< Channels mixed at once, the others count as virtual.
+		unsigned long long clock_; //!< The simulated DSP clock.
+		unsigned long long simulatedLength_; //!< Clocks a started instance or non-looping channel plays for, 0 for ever.
+		int peakBytes_; //!< Most bytes the pools used at once.
+		NullAudioBackendStats stats_; //!< Counts of the calls received.
+	};
+}
+
+#endif // NULL_AUDIO_BACKEND_H
@@ -0,0 +1,101 @@
+/* ======================================================================== /
+/!
+\file BenchmarkAudioEffects.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline benchmark of the audio effects.
+This tool runs every audio effect on noise at every instruction set the CPU
+supports and prints the samples processed per second, so the SIMD kernels
+can be compared against the scalar ones:
+    BenchmarkAudioEffects [seconds] [channels] [block]
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+#include <stdafx.h>
+#include <AudioEffects.h>
+
+using namespace DeckedOut;
+
+static const float DEFAULT_SECONDS = 10.0f; //! Seconds of audio each effect processes
+static const int DEFAULT_CHANNELS = 2; //! Channels of the benchmarked audio
+static const unsigned DEFAULT_BLOCK = 1024; //! Frames per block, the FMOD default
+static const int SAMPLE_RATE = 48000; //! Sample rate of the benchmarked audio
+
+/**
+ * \brief Creates an effect by index.
+ * \param index The index of the effect.
+ * \param level The instruction set of its kernels.
+ * \return The effect, nullptr past the last one.
+ */
+static std::unique_ptr<AudioEffect> CreateEffect(int index, AudioSIMDLevel level)
+{
+	static const std::shared_ptr<std::atomic<float>> key = std::make_shared<std::atomic<float>>(1.0f);
+	switch (index)
+	{
+	case 0: return std::make_unique<LookaheadLimiter>(LimiterSettings(), level);
+	case 1: return std::make_unique<SidechainDucker>(key, DuckerSettings(), level);
+	case 2: return std::make_unique<MultibandMeter>(MeterSettings(), level);
+	default: return nullptr;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	float seconds = (argc > 1) ? (float)atof(argv[1]) : DEFAULT_SECONDS;
+	int channels = (argc > 2) ? atoi(argv[2]) : DEFAULT_CHANNELS;
+	unsigned block = (argc > 3) ? (unsigned)strtoul(argv[3], nullptr, 10) : DEFAULT_BLOCK;
+	if (seconds <= 0.0f || channels <= 0 || block == 0)
+	{
+		fprintf(stderr, "Usage: BenchmarkAudioEffects [seconds] [channels] [block]\n");
+		return 1;
+	}
+
+	// Loud noise keeps the limiter reducing and the ducker ducked, their most expensive paths
+	std::vector<float> source((size_t)block * channels);
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> noise(-2.0f, 2.0f);
+	for (float& sample : source)
+	{
+		sample = noise(random);
+	}
+	std::vector<float> buffer(source.size());
+	unsigned blocks = (unsigned)(seconds * SAMPLE_RATE / block) + 1;
+
+	printf("%u blocks of %u frames, %d channels, CPU supports %s\n", blocks, block, channels,
+		GetSIMDLevelName(GetSupportedSIMDLevel()));
+	for (int index = 0; CreateEffect(index, AudioSIMDLevel::Scalar) != nullptr; ++index)
+	{
+		double scalarRate = 0.0;
+		for (int level = 0; level <= (int)GetSupportedSIMDLevel(); ++level)
+		{
+			std::unique_ptr<AudioEffect> effect = CreateEffect(index, (AudioSIMDLevel)level);
+			effect->Prepare(SAMPLE_RATE, block, channels);
+
+			auto start = std::chrono::steady_clock::now();
+			for (unsigned i = 0; i < blocks; ++i)
+			{
+				effect->Process(source.data(), buffer.data(), block, channels);
+			}
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			double rate = (double)blocks * block * channels / elapsed;
+			if (level == 0)
+			{
+				scalarRate = rate;
+			}
+			printf("%-18s %-6s %10.1f Msamples/s  %5.2fx\n", effect->GetName(),
+				GetSIMDLevelName((AudioSIMDLevel)level), rate / 1e6, rate / scalarRate);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,134 @@
+/* ======================================================================== /
+/!
+\file BenchmarkAudioPack.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline benchmark of loading sounds from the pack.
+This tool loads every sound of a directory through the AudioSystem, once
+from the loose files and once from the pack built by BuildAudioPack, and
+prints how long the level load takes each way. The rounds alternate which
+way goes first so neither always finds the files in the disk cache. Run it
+from the game directory so the studio banks are found:
+    BenchmarkAudioPack [directory] [pack] [rounds]
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <stdafx.h>
+#include <AudioSystem.h>
+
+using namespace DeckedOut;
+
+static const char DEFAULT_SOUND_DIRECTORY[] = "Assets/Audio/Sounds";
+static const char DEFAULT_PACK_PATH[] = "Assets/Audio/Sounds.pack";
+static const int DEFAULT_ROUNDS = 5; //! Loads measured each way
+
+/**
+ * \brief Loads every sound and unloads them again.
+ * \param audio The audio system.
+ * \param sounds The names of the sounds.
+ * \return The seconds taken by the loads.
+ */
+static double LoadLevel(AudioSystem& audio, const std::vector<std::string>& sounds)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (const std::string& sound : sounds)
+	{
+		audio.LoadSound(sound);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (const std::string& sound : sounds)
+	{
+		audio.UnloadSound(sound);
+	}
+	return seconds;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* directory = (argc > 1) ? argv[1] : DEFAULT_SOUND_DIRECTORY;
+	const char* packPath = (argc > 2) ? argv[2] : DEFAULT_PACK_PATH;
+	int rounds = (argc > 3) ? atoi(argv[3]) : DEFAULT_ROUNDS;
+	if (rounds <= 0)
+	{
+		fprintf(stderr, "Usage: BenchmarkAudioPack [directory] [pack] [rounds]\n");
+		return 1;
+	}
+
+	// Name the sounds like AudioPack::Build does, so both ways load the same names
+	std::error_code error;
+	std::filesystem::path root(directory);
+	std::string prefix = root.generic_string();
+	if (!prefix.empty() && prefix.back() != '/')
+	{
+		prefix += '/';
+	}
+	std::vector<std::string> sounds;
+	for (std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+	{
+		std::string name = prefix + std::filesystem::relative(it->path(), root).generic_string();
+		if (it->is_regular_file() && AudioPack::GetCodec(name) != AudioPackCodec::Unknown)
+		{
+			sounds.push_back(name);
+		}
+	}
+	if (error || sounds.empty())
+	{
+		fprintf(stderr, "Found no sound files in '%s'\n", directory);
+		return 1;
+	}
+
+	// Nothing needs to be heard, so the mixer does not wait for an output device
+	AudioSystem& audio = AudioSystem::Instance();
+	audio.SetOutputMode(AudioOutputMode::NonRealtime);
+	audio.Initialize();
+
+	double looseTotal = 0.0;
+	double packTotal = 0.0;
+	double looseBest = 1e30;
+	double packBest = 1e30;
+	for (int round = 0; round < rounds; ++round)
+	{
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			bool packed = ((round + pass) % 2) == 1;
+			if (packed && !audio.MountSoundPack(packPath))
+			{
+				fprintf(stderr, "Failed to mount the pack '%s'\n", packPath);
+				audio.Shutdown();
+				return 1;
+			}
+
+			double seconds = LoadLevel(audio, sounds);
+			if (packed)
+			{
+				audio.UnmountSoundPack();
+				packTotal += seconds;
+				packBest = std::min(packBest, seconds);
+			}
+			else
+			{
+				looseTotal += seconds;
+				looseBest = std::min(looseBest, seconds);
+			}
+		}
+	}
+	audio.Shutdown();
+
+	printf("%zu sounds, %d rounds\n", sounds.size(), rounds);
+	printf("Loose files %9.2f ms average %9.2f ms best\n", looseTotal / rounds * 1e3, looseBest * 1e3);
+	printf("Pack        %9.2f ms average %9.2f ms best  %5.2fx\n", packTotal / rounds * 1e3, packBest * 1e3,
+		looseTotal / packTotal);
+	return 0;
+}
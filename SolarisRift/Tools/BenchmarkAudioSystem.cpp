@@ -0,0 +1,210 @@
+/* ======================================================================== /
+/!
+\file BenchmarkAudioSystem.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline benchmark of the audio system bookkeeping.
+This tool runs the AudioSystem on the null backend, so nothing is mixed and
+no audio device is needed, and measures how many PlayEvent,
+SetEventParameter, PlaySound and MuteAllBuses calls it takes per second at
+loads of 10k to 100k calls per frame. The events are synthetic, added to the
+null backend with their parameters, so no game assets are needed:
+    BenchmarkAudioSystem [frames] [min calls] [max calls]
+It fails if any call the benchmarks make is recorded as an error.
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdafx.h>
+#include <AudioSystem.h>
+#include <NullAudioBackend.h>
+
+using namespace DeckedOut;
+
+static const int DEFAULT_FRAMES = 20; //! Frames measured at each load
+static const unsigned DEFAULT_MIN_CALLS = 10000; //! Calls per frame of the lightest load
+static const unsigned DEFAULT_MAX_CALLS = 100000; //! Calls per frame of the heaviest load
+static const unsigned BENCHMARK_EVENTS = 16; //! Events the event benchmarks cycle through
+static const char* EVENT_PARAMETERS[] = { "Intensity", "Speed", "Distance" }; //! Parameters of every event, the benchmarks set the last
+static const unsigned EVENT_POOL_SIZE = 32; //! Voices of each benchmarked event
+static const unsigned BENCHMARK_SOUNDS = 16; //! Sounds PlaySound cycles through
+static const unsigned SOUND_VOICE_CAP = 256; //! Cap of the sound group, so plays keep culling and stealing
+static const unsigned SIMULATED_LENGTH = 2; //! Updates a simulated instance or channel plays for
+static const float FRAME_SECONDS = 1.0f / 60.0f;
+
+/**
+ * \brief A benchmarked call.
+ */
+struct Benchmark
+{
+	const char* name_; //!< Name printed in the report.
+	std::function<void(unsigned)> call_; //!< Makes the call numbered by its argument.
+};
+
+/**
+ * \brief Runs a benchmark at one load and prints the call rate and the cost of the updates.
+ * \param audio The audio system.
+ * \param benchmark The benchmark.
+ * \param calls The calls per frame.
+ * \param frames The frames measured, after one warm-up frame.
+ */
+static void Run(AudioSystem& audio, const Benchmark& benchmark, unsigned calls, int frames)
+{
+	typedef std::chrono::steady_clock Clock;
+	double callSeconds = 0.0;
+	double updateSeconds = 0.0;
+	for (int frame = -1; frame < frames; ++frame)
+	{
+		Clock::time_point start = Clock::now();
+		for (unsigned i = 0; i < calls; ++i)
+		{
+			benchmark.call_(i);
+		}
+		Clock::time_point called = Clock::now();
+		audio.Update(FRAME_SECONDS);
+		Clock::time_point updated = Clock::now();
+
+		// The first frame warms the pools and caches up
+		if (frame >= 0)
+		{
+			callSeconds += std::chrono::duration<double>(called - start).count();
+			updateSeconds += std::chrono::duration<double>(updated - called).count();
+		}
+	}
+
+	double totalCalls = (double)calls * frames;
+	printf("%-25s %7u calls/frame %8.1f ns/call %8.2f Mcalls/s %8.3f ms/update\n", benchmark.name_, calls,
+		callSeconds / totalCalls * 1e9, totalCalls / callSeconds / 1e6, updateSeconds / frames * 1e3);
+
+	// Start the next benchmark from silence
+	audio.StopAllEvents();
+	audio.StopSounds(AudioChannelGroup::Master);
+	audio.UnmuteAllBuses();
+	audio.Update(FRAME_SECONDS);
+}
+
+int main(int argc, char* argv[])
+{
+	int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+	unsigned minCalls = (argc > 2) ? (unsigned)strtoul(argv[2], nullptr, 10) : DEFAULT_MIN_CALLS;
+	unsigned maxCalls = (argc > 3) ? (unsigned)strtoul(argv[3], nullptr, 10) : DEFAULT_MAX_CALLS;
+	if (frames <= 0 || minCalls == 0 || maxCalls < minCalls)
+	{
+		fprintf(stderr, "Usage: BenchmarkAudioSystem [frames] [min calls] [max calls]\n");
+		return 1;
+	}
+
+	AudioSystem& audio = AudioSystem::Instance();
+	audio.SetAudioBackend(AudioBackendKind::Null);
+	audio.Initialize();
+	NullAudioBackend* backend = static_cast<NullAudioBackend*>(audio.GetAudioBackend());
+	backend->SetSimulatedLength(SIMULATED_LENGTH);
+
+	// The events are added to the backend with their parameters, then resolved like manifest events
+	std::vector<FMOD_STUDIO_PARAMETER_DESCRIPTION> parameters;
+	for (const char* name : EVENT_PARAMETERS)
+	{
+		FMOD_STUDIO_PARAMETER_DESCRIPTION description = {};
+		description.name = name;
+		description.maximum = 1.0f;
+		parameters.push_back(description);
+	}
+	std::vector<AudioId> events;
+	std::vector<EventHandle> eventHandles;
+	std::vector<ParamHandle> parameterHandles;
+	const std::string parameter = EVENT_PARAMETERS[sizeof(EVENT_PARAMETERS) / sizeof(EVENT_PARAMETERS[0]) - 1];
+	for (unsigned i = 0; i < BENCHMARK_EVENTS; ++i)
+	{
+		std::string path = "event:/Benchmark/Event" + std::to_string(i);
+		backend->SetEventParameters(path.c_str(), parameters);
+		events.push_back(audio.AddEvent(path));
+		audio.SetEventPoolSize(events.back(), EVENT_POOL_SIZE, EventStealMode::Oldest);
+		eventHandles.push_back(audio.GetEventHandle(events.back()));
+		parameterHandles.push_back(audio.GetParameterHandle(eventHandles.back(), parameter));
+		if (!eventHandles.back().IsValid() || !parameterHandles.back().IsValid())
+		{
+			fprintf(stderr, "Failed to resolve the synthetic event '%s' and its parameter '%s'\n", path.c_str(), parameter.c_str());
+			audio.Shutdown();
+			return 1;
+		}
+	}
+
+	// The null backend opens any name, so the sounds do not need to exist
+	std::vector<std::string> sounds;
+	for (unsigned i = 0; i < BENCHMARK_SOUNDS; ++i)
+	{
+		sounds.push_back("Benchmark/Sound" + std::to_string(i) + ".wav");
+		audio.LoadSound(sounds.back());
+	}
+	SoundCullSettings cull;
+	cull.maxVoices_ = SOUND_VOICE_CAP;
+	audio.SetSoundCullSettings(AudioChannelGroup::Sound, cull);
+
+	std::vector<Benchmark> benchmarks;
+	benchmarks.push_back({ "PlayEvent", [&](unsigned i)
+	{
+		audio.PlayEvent(events[i % events.size()], (int)(i & 3));
+	} });
+	benchmarks.push_back({ "SetEventParameter", [&](unsigned i)
+	{
+		// Resolved by name through the parameter cache of the event
+		audio.SetEventParameter(events[i % events.size()], parameter, (float)(i & 255) / 255.0f);
+	} });
+	benchmarks.push_back({ "SetEventParameter handle", [&](unsigned i)
+	{
+		unsigned event = i % events.size();
+		audio.SetEventParameter(eventHandles[event], parameterHandles[event], (float)(i & 255) / 255.0f);
+	} });
+	benchmarks.push_back({ "PlaySound", [&](unsigned i)
+	{
+		// Varied volumes and priorities make the cap both cull and steal
+		SoundPlayParams params;
+		params.volume_ = 0.25f + (float)(i % 7) / 8.0f;
+		params.priority_ = (int)(i % 3);
+		audio.PlaySound(sounds[i % sounds.size()], params);
+	} });
+	benchmarks.push_back({ "MuteAllBuses", [&](unsigned i)
+	{
+		// A second mute in a row returns early, so mutes alternate with unmutes
+		if (i & 1)
+		{
+			audio.UnmuteAllBuses();
+		}
+		else
+		{
+			audio.MuteAllBuses();
+		}
+	} });
+
+	for (const Benchmark& benchmark : benchmarks)
+	{
+		for (unsigned calls = minCalls; calls <= maxCalls; calls = (calls > maxCalls / 10 && calls < maxCalls) ? maxCalls : calls * 10)
+		{
+			Run(audio, benchmark, calls, frames);
+		}
+	}
+
+	NullAudioBackendStats stats = backend->GetStats();
+	printf("Null backend: %llu calls, %llu instances started, %llu channels played, %llu parameter and %llu bus changes\n",
+		(unsigned long long)stats.calls_, (unsigned long long)stats.instancesStarted_, (unsigned long long)stats.channelsPlayed_,
+		(unsigned long long)stats.parameterChanges_, (unsigned long long)stats.busChanges_);
+
+	// A failing call is cheaper than a working one, so errors would make the figures meaningless
+	uint64_t errors = audio.GetErrorLog().GetRecordCount();
+	audio.Shutdown();
+	if (errors != 0)
+	{
+		fprintf(stderr, "%llu calls failed\n", (unsigned long long)errors);
+		return 1;
+	}
+	return 0;
+}
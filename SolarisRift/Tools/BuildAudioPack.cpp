@@ -0,0 +1,43 @@
+/* ======================================================================== /
+/!
+\file BuildAudioPack.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline builder for the sound pack.
+This tool packs every loose sound file of a directory into the archive that
+the AudioSystem memory maps with MountSoundPack. Run it after changing any
+sound file:
+    BuildAudioPack [directory] [pack] [alignment]
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdafx.h>
+#include <AudioPack.h>
+
+static const char DEFAULT_SOUND_DIRECTORY[] = "Assets/Audio/Sounds";
+static const char DEFAULT_PACK_PATH[] = "Assets/Audio/Sounds.pack";
+
+int main(int argc, char* argv[])
+{
+	const char* directory = (argc > 1) ? argv[1] : DEFAULT_SOUND_DIRECTORY;
+	const char* packPath = (argc > 2) ? argv[2] : DEFAULT_PACK_PATH;
+	uint32_t alignment = (argc > 3) ? (uint32_t)strtoul(argv[3], nullptr, 10) : DeckedOut::AudioPack::DEFAULT_ALIGNMENT;
+	if (alignment > DeckedOut::AudioPack::MAX_ALIGNMENT)
+	{
+		fprintf(stderr, "The alignment must be at most %u\n", DeckedOut::AudioPack::MAX_ALIGNMENT);
+		return 1;
+	}
+
+	if (!DeckedOut::AudioPack::Build(directory, packPath, alignment))
+	{
+		fprintf(stderr, "Failed to pack '%s' into '%s'\n", directory, packPath);
+		return 1;
+	}
+	return 0;
+}
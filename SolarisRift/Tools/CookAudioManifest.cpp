@@ -0,0 +1,36 @@
+/* ======================================================================== /
+/!
+\file CookAudioManifest.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline cooker for the binary audio manifest.
+This tool turns the GUIDs.txt file exported by FMOD Studio into the binary
+manifest that the AudioSystem memory maps at startup. Run it after every
+FMOD Studio build:
+    CookAudioManifest [GUIDs.txt] [GUIDs.manifest]
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <cstdio>
+#include <stdafx.h>
+#include <AudioManifest.h>
+
+static const char DEFAULT_GUIDS_PATH[] = "Assets/Audio/Project/Build/GUIDs.txt";
+static const char DEFAULT_MANIFEST_PATH[] = "Assets/Audio/Project/Build/GUIDs.manifest";
+
+int main(int argc, char* argv[])
+{
+	const char* sourcePath = (argc > 1) ? argv[1] : DEFAULT_GUIDS_PATH;
+	const char* cookedPath = (argc > 2) ? argv[2] : DEFAULT_MANIFEST_PATH;
+
+	if (!DeckedOut::AudioManifest::Cook(sourcePath, cookedPath))
+	{
+		fprintf(stderr, "Failed to cook '%s' into '%s'\n", sourcePath, cookedPath);
+		return 1;
+	}
+	return 0;
+}
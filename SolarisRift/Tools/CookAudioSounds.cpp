@@ -0,0 +1,58 @@
+/* ======================================================================== /
+/!
+\file CookAudioSounds.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline cooker for the sound manifest.
+This tool picks the format every sound file of a directory is loaded in from
+its length and the play profile written by the game, re-encodes the sounds
+that should be ADPCM and writes the manifest the AudioSystem maps with
+LoadSoundManifest. Run it after changing any sound file or profile:
+    CookAudioSounds [directory] [profile] [cooked directory] [manifest]
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <cstdio>
+#include <vector>
+#include <stdafx.h>
+#include <AudioSoundCooker.h>
+
+using namespace DeckedOut;
+
+static const char DEFAULT_SOUND_DIRECTORY[] = "Assets/Audio/Sounds";
+static const char DEFAULT_PROFILE_PATH[] = "Assets/Audio/Sounds.profile";
+static const char DEFAULT_COOKED_DIRECTORY[] = "Assets/Audio/Cooked";
+static const char DEFAULT_MANIFEST_PATH[] = "Assets/Audio/Sounds.soundmanifest";
+static const char* FORMAT_NAMES[] = { "PCM", "ADPCM", "Compressed", "Stream" };
+
+int main(int argc, char* argv[])
+{
+	const char* directory = (argc > 1) ? argv[1] : DEFAULT_SOUND_DIRECTORY;
+	const char* profilePath = (argc > 2) ? argv[2] : DEFAULT_PROFILE_PATH;
+	const char* cookedDirectory = (argc > 3) ? argv[3] : DEFAULT_COOKED_DIRECTORY;
+	const char* manifestPath = (argc > 4) ? argv[4] : DEFAULT_MANIFEST_PATH;
+
+	std::vector<AudioSoundCookResult> results;
+	if (!AudioSoundCooker::Cook(directory, profilePath, cookedDirectory, manifestPath, AudioSoundCookSettings(), &results))
+	{
+		fprintf(stderr, "Failed to cook '%s' into '%s'\n", directory, manifestPath);
+		return 1;
+	}
+
+	uint64_t memoryBytes = 0;
+	float decodeCost = 0.0f;
+	for (const AudioSoundCookResult& result : results)
+	{
+		printf("%-10s %9.1f KiB %6.3f%% core %7.3f plays/s%s  %s\n", FORMAT_NAMES[(int)result.format_],
+			result.memoryBytes_ / 1024.0, result.decodeCost_ * 100.0f, result.playsPerSecond_,
+			result.info_.estimated_ ? " ~" : "  ", result.name_.c_str());
+		memoryBytes += result.memoryBytes_;
+		decodeCost += result.decodeCost_;
+	}
+	printf("%zu sounds, %.1f KiB loaded, %.3f%% of a core decoding\n", results.size(), memoryBytes / 1024.0, decodeCost * 100.0f);
+	return 0;
+}
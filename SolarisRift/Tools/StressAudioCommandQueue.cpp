@@ -0,0 +1,138 @@
+/* ======================================================================== /
+/!
+\file StressAudioCommandQueue.cpp
+\par Solaris Rift
+\author Coby Colson
+\par coby.colson@digipen.edu
+\brief Offline stress test of the audio command queue.
+This tool pushes numbered commands from several producer threads into a
+small queue while one consumer drains it, and checks that no command is lost
+or duplicated and that the commands of each producer arrive in order:
+    StressAudioCommandQueue [commands] [producers] [capacity]
+\par
+Course: GAM200-F20
+COPYRIGHT (C) 2020-2021 DigiPen, All rights reserved.
+/
+/ ======================================================================== */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <stdafx.h>
+#include <AudioCommandQueue.h>
+
+using namespace DeckedOut;
+
+static const unsigned DEFAULT_COMMANDS = 1000000; //! Commands pushed by each producer
+static const int DEFAULT_PRODUCERS = 8; //! Number of producer threads
+static const size_t DEFAULT_CAPACITY = 256; //! Capacity of the queue, small so producers keep finding it full
+
+int main(int argc, char* argv[])
+{
+	unsigned commands = (argc > 1) ? (unsigned)strtoul(argv[1], nullptr, 10) : DEFAULT_COMMANDS;
+	int producers = (argc > 2) ? atoi(argv[2]) : DEFAULT_PRODUCERS;
+	size_t capacity = (argc > 3) ? (size_t)strtoul(argv[3], nullptr, 10) : DEFAULT_CAPACITY;
+	if (commands == 0 || producers <= 0 || capacity == 0)
+	{
+		fprintf(stderr, "Usage: StressAudioCommandQueue [commands] [producers] [capacity]\n");
+		return 1;
+	}
+
+	AudioCommandQueue queue(capacity);
+	std::atomic<bool> start(false);
+	std::vector<std::thread> threads;
+	for (int producer = 0; producer < producers; ++producer)
+	{
+		threads.emplace_back([&queue, &start, commands, producer]()
+		{
+			while (!start.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+
+			// A full queue rejects the command, so the producer retries until it fits
+			AudioCommand command = {};
+			command.type_ = AudioCommandType::SetEventParameter;
+			command.priority_ = producer;
+			for (unsigned i = 0; i < commands; ++i)
+			{
+				command.index_ = i;
+				command.value_ = (float)i;
+				while (!queue.Enqueue(command))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	// The consumer checks every command against the next number it expects from its producer
+	std::vector<unsigned> expected(producers, 0);
+	uint64_t total = (uint64_t)commands * producers;
+	uint64_t received = 0;
+	uint64_t errors = 0;
+	auto begin = std::chrono::steady_clock::now();
+	start.store(true, std::memory_order_release);
+	while (received < total)
+	{
+		AudioCommand command;
+		if (!queue.Dequeue(command))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		++received;
+
+		if (command.type_ != AudioCommandType::SetEventParameter || command.priority_ < 0 || command.priority_ >= producers)
+		{
+			++errors;
+			continue;
+		}
+		unsigned& next = expected[command.priority_];
+		if (command.index_ != next || command.value_ != (float)next)
+		{
+			if (errors++ < 10)
+			{
+				fprintf(stderr, "Producer %d: expected command %u, got %u\n", command.priority_, next, command.index_);
+			}
+		}
+		next = command.index_ + 1;
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	// Nothing may be left behind, and every producer must have delivered all of its commands
+	AudioCommand extra;
+	if (queue.Dequeue(extra))
+	{
+		fprintf(stderr, "The queue still holds commands after every producer was drained\n");
+		++errors;
+	}
+	for (int producer = 0; producer < producers; ++producer)
+	{
+		if (expected[producer] != commands)
+		{
+			fprintf(stderr, "Producer %d: delivered %u of %u commands\n", producer, expected[producer], commands);
+			++errors;
+		}
+	}
+
+	AudioCommandQueueStats stats = queue.GetStats();
+	if (stats.enqueued_ != total)
+	{
+		fprintf(stderr, "The queue counted %llu enqueued commands, %llu were pushed\n",
+			(unsigned long long)stats.enqueued_, (unsigned long long)total);
+		++errors;
+	}
+	printf("%d producers, %llu commands through a queue of %zu in %.3f s (%.1f M/s), %llu full rejections\n",
+		producers, (unsigned long long)total, stats.capacity_, elapsed, total / elapsed / 1e6,
+		(unsigned long long)stats.overflows_);
+	printf("%s: %llu errors\n", errors ? "FAILED" : "PASSED", (unsigned long long)errors);
+	return errors ? 1 : 0;
+}